@@ -0,0 +1,585 @@
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "esp_event.h"
+#include "esp32_driver_nextion/nextion.h"
+#include "esp32_driver_nextion/async.h"
+#include "esp32_driver_nextion/batch.h"
+#include "esp32_driver_nextion/component.h"
+#include "esp32_driver_nextion/decimate.h"
+#include "esp32_driver_nextion/drawing.h"
+#include "esp32_driver_nextion/eeprom.h"
+#include "esp32_driver_nextion/page.h"
+#include "esp32_driver_nextion/property.h"
+#include "esp32_driver_nextion/reparse.h"
+#include "esp32_driver_nextion/scale.h"
+#include "esp32_driver_nextion/system.h"
+#include "esp32_driver_nextion/transport.h"
+#include "esp32_driver_nextion/waveform.h"
+#include "simulator.h"
+
+#define BENCHMARK_BAUD_RATE 115200
+#define BENCHMARK_GROUP_LENGTH 16
+#define BENCHMARK_STREAM_LENGTH 1000
+#define BENCHMARK_STREAM_CHANNELS 4
+#define BENCHMARK_CAPTURE_LENGTH (10 * BENCHMARK_STREAM_LENGTH)
+
+/**
+ * @typedef scenario_t
+ * @brief One public API operation to be measured.
+ */
+typedef struct
+{
+    const char *name;                                     /** @brief Name shown on the report. */
+    size_t iterations;                                    /** @brief Times the operation is run when not overridden. */
+    size_t instructions;                                  /** @brief Instructions sent on each run. */
+    nex_err_t (*run)(nextion_t *handle, size_t iteration); /** @brief Operation. */
+} scenario_t;
+
+/**
+ * @typedef counting_transport_t
+ * @brief Transport counting the bytes written through another one.
+ */
+typedef struct
+{
+    nextion_transport_t base;   /** @brief Transport functions; must be the first member. */
+    nextion_transport_t *inner; /** @brief Transport the calls are forwarded to. */
+    uint64_t bytes_written;     /** @brief Bytes written so far. */
+} counting_transport_t;
+
+static nex_err_t scenario_set_value(nextion_t *handle, size_t iteration);
+static nex_err_t scenario_get_value(nextion_t *handle, size_t iteration);
+static nex_err_t scenario_property_set_number(nextion_t *handle, size_t iteration);
+static nex_err_t scenario_set_text(nextion_t *handle, size_t iteration);
+static nex_err_t scenario_get_text(nextion_t *handle, size_t iteration);
+static nex_err_t scenario_page_get(nextion_t *handle, size_t iteration);
+static nex_err_t scenario_draw_fill_area(nextion_t *handle, size_t iteration);
+static nex_err_t scenario_eeprom_write_number(nextion_t *handle, size_t iteration);
+static nex_err_t scenario_eeprom_read_number(nextion_t *handle, size_t iteration);
+static nex_err_t scenario_waveform_add_value(nextion_t *handle, size_t iteration);
+static nex_err_t scenario_waveform_stream(nextion_t *handle, size_t iteration);
+static nex_err_t scenario_waveform_stream_buffer(nextion_t *handle, size_t iteration);
+static nex_err_t scenario_waveform_stream_channels(nextion_t *handle, size_t iteration);
+static nex_err_t scenario_waveform_stream_min_max(nextion_t *handle, size_t iteration);
+static nex_err_t scenario_async_set_value(nextion_t *handle, size_t iteration);
+static nex_err_t scenario_batch_set_value(nextion_t *handle, size_t iteration);
+static nex_err_t scenario_reparse_set_value(nextion_t *handle, size_t iteration);
+static nex_err_t scenario_scale_naive(nextion_t *handle, size_t iteration);
+static nex_err_t scenario_scale_float(nextion_t *handle, size_t iteration);
+static bool benchmark_run(nextion_t *handle, const scenario_t *scenario, size_t iterations);
+static uint64_t benchmark_now_us(void);
+static int benchmark_compare(const void *a, const void *b);
+static uint32_t benchmark_env(const char *name, uint32_t default_value);
+static nextion_transport_t *counting_transport_create(nextion_transport_t *inner);
+static int counting_write(nextion_transport_t *transport, const uint8_t *data, size_t length);
+static int counting_read(nextion_transport_t *transport, uint8_t *buffer, size_t length, TickType_t timeout);
+static size_t counting_buffered_length(nextion_transport_t *transport, bool complete_frames_only);
+static void counting_flush_input(nextion_transport_t *transport);
+static bool counting_wait_tx_done(nextion_transport_t *transport, TickType_t timeout);
+static bool counting_set_baud_rate(nextion_transport_t *transport, uint32_t baud_rate);
+static nextion_transport_event_t counting_wait_event(nextion_transport_t *transport, TickType_t timeout);
+static void counting_wake(nextion_transport_t *transport);
+static void counting_destroy(nextion_transport_t *transport);
+
+static counting_transport_t *counter = NULL;
+static float scale_values[BENCHMARK_CAPTURE_LENGTH];
+static uint8_t scale_samples[BENCHMARK_CAPTURE_LENGTH];
+
+static const scenario_t SCENARIOS[] = {
+    {"component_set_value", 500, 1, scenario_set_value},
+    {"component_get_value", 500, 1, scenario_get_value},
+    {"property_set_number", 500, 1, scenario_property_set_number},
+    {"component_set_text", 500, 1, scenario_set_text},
+    {"component_get_text", 500, 1, scenario_get_text},
+    {"page_get", 500, 1, scenario_page_get},
+    {"draw_fill_area", 500, 1, scenario_draw_fill_area},
+    {"eeprom_write_number", 500, 1, scenario_eeprom_write_number},
+    {"eeprom_read_number", 500, 1, scenario_eeprom_read_number},
+    // Success is silent: every call waits for the receive timeout.
+    {"waveform_add_value", 10, 1, scenario_waveform_add_value},
+    // Each sample counts as an instruction: "instr/s" are samples per second.
+    {"waveform_stream", 50, BENCHMARK_STREAM_LENGTH, scenario_waveform_stream},
+    {"waveform_stream_buffer", 50, BENCHMARK_STREAM_LENGTH, scenario_waveform_stream_buffer},
+    // Each frame counts as an instruction: "instr/s" are samples per second on every channel.
+    {"waveform_stream_channels", 50, BENCHMARK_STREAM_LENGTH, scenario_waveform_stream_channels},
+    // Each sample captured counts as an instruction, though only a tenth is streamed.
+    {"waveform_stream_min_max", 50, BENCHMARK_CAPTURE_LENGTH, scenario_waveform_stream_min_max},
+    {"async_set_value", 50, BENCHMARK_GROUP_LENGTH, scenario_async_set_value},
+    {"batch_set_value", 50, BENCHMARK_GROUP_LENGTH, scenario_batch_set_value},
+    // Entering and leaving the mode are part of each run.
+    {"reparse_set_value", 50, BENCHMARK_GROUP_LENGTH, scenario_reparse_set_value},
+    // Nothing is sent: each value converted counts as an instruction.
+    {"scale_naive", 500, BENCHMARK_CAPTURE_LENGTH, scenario_scale_naive},
+    {"scale_float", 500, BENCHMARK_CAPTURE_LENGTH, scenario_scale_float}};
+
+void app_main(void)
+{
+    simulator_config_t config = SIMULATOR_CONFIG_DEFAULT();
+    const uint32_t iterations = benchmark_env("NEX_BENCH_ITERATIONS", 0);
+    const nextion_response_mode_t response_mode = (nextion_response_mode_t)benchmark_env("NEX_BENCH_RESPONSE_MODE", NEXTION_RESPONSE_ALL);
+    int fd;
+
+    config.latency_us = benchmark_env("NEX_SIM_LATENCY_US", 0);
+    config.throttle = benchmark_env("NEX_SIM_THROTTLE", 0) != 0;
+    config.baud_rate = BENCHMARK_BAUD_RATE;
+
+    // A ramp overshooting the scale range on both ends.
+    for (size_t i = 0; i < BENCHMARK_CAPTURE_LENGTH; i++)
+    {
+        scale_values[i] = -1.5f + 3.0f * (float)i / BENCHMARK_CAPTURE_LENGTH;
+    }
+
+    esp_event_loop_create_default();
+
+    pid_t simulator = simulator_start(&config, &fd);
+
+    if (simulator == -1)
+    {
+        printf("failed starting the simulator\n");
+        exit(EXIT_FAILURE);
+    }
+
+    nextion_t *handle = nextion_driver_install_transport(counting_transport_create(nextion_transport_posix_create(fd)), BENCHMARK_BAUD_RATE);
+
+    if (handle == NULL || nextion_init(handle) != NEX_OK)
+    {
+        printf("failed initializing the driver\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (response_mode != NEXTION_RESPONSE_ALL)
+    {
+        nextion_system_set_response_mode(handle, response_mode, NULL, NULL);
+    }
+
+    printf("latency: %" PRIu32 " us, throttle: %d, response mode: %d\n",
+           config.latency_us,
+           config.throttle,
+           response_mode);
+    printf("%-26s %8s %12s %12s %10s %10s %12s\n", "scenario", "runs", "ops/s", "instr/s", "p50 (us)", "p99 (us)", "bytes/instr");
+
+    bool success = true;
+
+    for (size_t i = 0; i < sizeof(SCENARIOS) / sizeof(SCENARIOS[0]); i++)
+    {
+        success &= benchmark_run(handle, &SCENARIOS[i], iterations > 0 ? iterations : SCENARIOS[i].iterations);
+    }
+
+    nextion_driver_delete(handle);
+
+    success &= simulator_wait(simulator);
+
+    fflush(stdout);
+
+    // There is nothing to return to on Linux: the scheduler would keep running.
+    exit(success ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+static nex_err_t scenario_set_value(nextion_t *handle, size_t iteration)
+{
+    return nextion_component_set_value(handle, "n0", (int32_t)iteration);
+}
+
+static nex_err_t scenario_get_value(nextion_t *handle, size_t iteration)
+{
+    (void)iteration;
+
+    int32_t value;
+
+    return nextion_component_get_value(handle, "n0", &value);
+}
+
+static nex_err_t scenario_property_set_number(nextion_t *handle, size_t iteration)
+{
+    static nextion_property_t property;
+
+    // Prepared once, as an UI loop would.
+    if (iteration == 0 && nextion_property_prepare(handle, "n0", "val", &property) != NEX_OK)
+    {
+        return NEX_FAIL;
+    }
+
+    return nextion_property_set_number(&property, (int32_t)iteration);
+}
+
+static nex_err_t scenario_set_text(nextion_t *handle, size_t iteration)
+{
+    (void)iteration;
+
+    return nextion_component_set_text(handle, "t0", "benchmark");
+}
+
+static nex_err_t scenario_get_text(nextion_t *handle, size_t iteration)
+{
+    (void)iteration;
+
+    char text[16];
+
+    return nextion_component_get_text(handle, "t0", text, sizeof(text));
+}
+
+static nex_err_t scenario_page_get(nextion_t *handle, size_t iteration)
+{
+    (void)iteration;
+
+    uint8_t page_id;
+
+    return nextion_page_get(handle, &page_id);
+}
+
+static nex_err_t scenario_draw_fill_area(nextion_t *handle, size_t iteration)
+{
+    const area_t area = {.upper_left = {.x = 10, .y = 10}, .bottom_right = {.x = 110, .y = 60}};
+
+    return nextion_draw_fill_area(handle, area, (rgb565_t)iteration);
+}
+
+static nex_err_t scenario_eeprom_write_number(nextion_t *handle, size_t iteration)
+{
+    return nextion_eeprom_write_number(handle, 0, (int32_t)iteration);
+}
+
+static nex_err_t scenario_eeprom_read_number(nextion_t *handle, size_t iteration)
+{
+    (void)iteration;
+
+    int32_t value;
+
+    return nextion_eeprom_read_number(handle, 0, &value);
+}
+
+static nex_err_t scenario_waveform_add_value(nextion_t *handle, size_t iteration)
+{
+    return nextion_waveform_add_value(handle, 1, 0, (uint8_t)iteration);
+}
+
+static nex_err_t scenario_waveform_stream(nextion_t *handle, size_t iteration)
+{
+    nex_err_t code = nextion_waveform_stream_begin(handle, 1, 0, BENCHMARK_STREAM_LENGTH);
+
+    for (size_t i = 0; i < BENCHMARK_STREAM_LENGTH && code == NEX_OK; i++)
+    {
+        code = nextion_waveform_stream_write(handle, (uint8_t)(iteration + i));
+    }
+
+    return code;
+}
+
+static nex_err_t scenario_waveform_stream_buffer(nextion_t *handle, size_t iteration)
+{
+    uint8_t samples[BENCHMARK_STREAM_LENGTH];
+
+    for (size_t i = 0; i < BENCHMARK_STREAM_LENGTH; i++)
+    {
+        samples[i] = (uint8_t)(iteration + i);
+    }
+
+    nex_err_t code = nextion_waveform_stream_begin(handle, 1, 0, BENCHMARK_STREAM_LENGTH);
+
+    return code == NEX_OK ? nextion_waveform_stream_write_buffer(handle, samples, BENCHMARK_STREAM_LENGTH) : code;
+}
+
+static nex_err_t scenario_waveform_stream_channels(nextion_t *handle, size_t iteration)
+{
+    static uint8_t frames[BENCHMARK_STREAM_LENGTH * BENCHMARK_STREAM_CHANNELS];
+
+    for (size_t i = 0; i < sizeof(frames); i++)
+    {
+        frames[i] = (uint8_t)(iteration + i);
+    }
+
+    return nextion_waveform_stream_channels(handle, 1, BENCHMARK_STREAM_CHANNELS, frames, BENCHMARK_STREAM_LENGTH);
+}
+
+static nex_err_t scenario_waveform_stream_min_max(nextion_t *handle, size_t iteration)
+{
+    static uint8_t samples[BENCHMARK_CAPTURE_LENGTH];
+    static uint8_t output[BENCHMARK_STREAM_LENGTH + 4];
+    nextion_decimator_t decimator;
+
+    for (size_t i = 0; i < BENCHMARK_CAPTURE_LENGTH; i++)
+    {
+        samples[i] = (uint8_t)(iteration + i);
+    }
+
+    // The whole capture fits the width: a pair of samples every two pixels.
+    nextion_decimate_init(&decimator, NEXTION_DECIMATE_MIN_MAX, BENCHMARK_CAPTURE_LENGTH, BENCHMARK_STREAM_LENGTH, NULL, 0);
+
+    size_t length = nextion_decimate_push(&decimator, samples, BENCHMARK_CAPTURE_LENGTH, output);
+
+    length += nextion_decimate_flush(&decimator, output + length);
+
+    nex_err_t code = nextion_waveform_stream_begin(handle, 1, 0, length);
+
+    return code == NEX_OK ? nextion_waveform_stream_write_buffer(handle, output, length) : code;
+}
+
+static nex_err_t scenario_async_set_value(nextion_t *handle, size_t iteration)
+{
+    for (size_t i = 0; i < BENCHMARK_GROUP_LENGTH; i++)
+    {
+        nex_err_t code = nextion_async_set_property_number(handle, "n0", "val", (int32_t)(iteration + i), NULL, NULL);
+
+        if (code != NEX_OK)
+        {
+            return code;
+        }
+    }
+
+    return nextion_async_wait(handle);
+}
+
+static nex_err_t scenario_batch_set_value(nextion_t *handle, size_t iteration)
+{
+    nextion_batch_t *batch = nextion_batch_begin(handle);
+
+    if (batch == NULL)
+    {
+        return NEX_FAIL;
+    }
+
+    for (size_t i = 0; i < BENCHMARK_GROUP_LENGTH; i++)
+    {
+        if (nextion_batch_add_value(batch, "n0", (int32_t)(iteration + i)) != NEX_OK)
+        {
+            nextion_batch_discard(batch);
+
+            return NEX_FAIL;
+        }
+    }
+
+    size_t failure_count;
+
+    return nextion_batch_commit(batch, NULL, 0, &failure_count);
+}
+
+static nex_err_t scenario_reparse_set_value(nextion_t *handle, size_t iteration)
+{
+    nex_err_t code = nextion_reparse_begin(handle);
+
+    // Component ids instead of names, numbers in binary.
+    for (size_t i = 0; i < BENCHMARK_GROUP_LENGTH && code == NEX_OK; i++)
+    {
+        code = nextion_reparse_set_value(handle, 1, (int32_t)(iteration + i));
+    }
+
+    nex_err_t end_code = nextion_reparse_end(handle);
+
+    return code == NEX_OK ? end_code : code;
+}
+
+static nex_err_t scenario_scale_naive(nextion_t *, size_t iteration)
+{
+    const float min = -1.0f;
+    const float max = 1.0f;
+
+    // What every caller wrote before: a division and branches per value.
+    for (size_t i = 0; i < BENCHMARK_CAPTURE_LENGTH; i++)
+    {
+        const float value = scale_values[(i + iteration) % BENCHMARK_CAPTURE_LENGTH];
+
+        if (value <= min)
+        {
+            scale_samples[i] = 0;
+        }
+        else if (value >= max)
+        {
+            scale_samples[i] = 255;
+        }
+        else
+        {
+            scale_samples[i] = (uint8_t)((value - min) * 255.0f / (max - min) + 0.5f);
+        }
+    }
+
+    return NEX_OK;
+}
+
+static nex_err_t scenario_scale_float(nextion_t *, size_t iteration)
+{
+    const size_t start = iteration % BENCHMARK_CAPTURE_LENGTH;
+    nextion_scale_t scale;
+
+    nextion_scale_init(&scale, -1.0f, 1.0f);
+
+    // Same rotation as the naive loop, in two calls.
+    nextion_scale_float(&scale, scale_values + start, BENCHMARK_CAPTURE_LENGTH - start, scale_samples);
+
+    return nextion_scale_float(&scale, scale_values, start, scale_samples + BENCHMARK_CAPTURE_LENGTH - start);
+}
+
+static bool benchmark_run(nextion_t *handle, const scenario_t *scenario, size_t iterations)
+{
+    uint32_t *latencies = (uint32_t *)malloc(iterations * sizeof(uint32_t));
+    size_t failures = 0;
+
+    if (latencies == NULL)
+    {
+        return false;
+    }
+
+    const uint64_t start = benchmark_now_us();
+    const uint64_t bytes_start = counter->bytes_written;
+
+    for (size_t i = 0; i < iterations; i++)
+    {
+        const uint64_t operation_start = benchmark_now_us();
+
+        if (scenario->run(handle, i) != NEX_OK)
+        {
+            failures++;
+        }
+
+        latencies[i] = (uint32_t)(benchmark_now_us() - operation_start);
+    }
+
+    const double seconds = (double)(benchmark_now_us() - start) / 1000000.0;
+    const double operations_per_second = seconds > 0 ? (double)iterations / seconds : 0;
+    const double bytes_per_instruction = (double)(counter->bytes_written - bytes_start) / (double)(iterations * scenario->instructions);
+
+    qsort(latencies, iterations, sizeof(uint32_t), benchmark_compare);
+
+    printf("%-26s %8zu %12.1f %12.1f %10" PRIu32 " %10" PRIu32 " %12.1f\n",
+           scenario->name,
+           iterations,
+           operations_per_second,
+           operations_per_second * (double)scenario->instructions,
+           latencies[iterations / 2],
+           latencies[(iterations * 99) / 100],
+           bytes_per_instruction);
+
+    if (failures > 0)
+    {
+        printf("%-26s %zu failed\n", "", failures);
+    }
+
+    free(latencies);
+
+    return failures == 0;
+}
+
+static uint64_t benchmark_now_us(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint64_t)now.tv_sec * 1000000) + ((uint64_t)now.tv_nsec / 1000);
+}
+
+static int benchmark_compare(const void *a, const void *b)
+{
+    const uint32_t left = *(const uint32_t *)a;
+    const uint32_t right = *(const uint32_t *)b;
+
+    return (left > right) - (left < right);
+}
+
+static uint32_t benchmark_env(const char *name, uint32_t default_value)
+{
+    const char *value = getenv(name);
+
+    return value == NULL ? default_value : (uint32_t)strtoul(value, NULL, 10);
+}
+
+static nextion_transport_t *counting_transport_create(nextion_transport_t *inner)
+{
+    if (inner == NULL)
+    {
+        return NULL;
+    }
+
+    counter = (counting_transport_t *)calloc(1, sizeof(counting_transport_t));
+
+    if (counter == NULL)
+    {
+        inner->destroy(inner);
+
+        return NULL;
+    }
+
+    counter->base.write = counting_write;
+    counter->base.read = counting_read;
+    counter->base.buffered_length = counting_buffered_length;
+    counter->base.flush_input = counting_flush_input;
+    counter->base.wait_tx_done = counting_wait_tx_done;
+    counter->base.set_baud_rate = counting_set_baud_rate;
+    counter->base.wait_event = counting_wait_event;
+    counter->base.wake = counting_wake;
+    counter->base.destroy = counting_destroy;
+    counter->inner = inner;
+
+    return &counter->base;
+}
+
+static int counting_write(nextion_transport_t *transport, const uint8_t *data, size_t length)
+{
+    counting_transport_t *counting = (counting_transport_t *)transport;
+    int written = counting->inner->write(counting->inner, data, length);
+
+    if (written > 0)
+    {
+        counting->bytes_written += (uint64_t)written;
+    }
+
+    return written;
+}
+
+static int counting_read(nextion_transport_t *transport, uint8_t *buffer, size_t length, TickType_t timeout)
+{
+    nextion_transport_t *inner = ((counting_transport_t *)transport)->inner;
+
+    return inner->read(inner, buffer, length, timeout);
+}
+
+static size_t counting_buffered_length(nextion_transport_t *transport, bool complete_frames_only)
+{
+    nextion_transport_t *inner = ((counting_transport_t *)transport)->inner;
+
+    return inner->buffered_length(inner, complete_frames_only);
+}
+
+static void counting_flush_input(nextion_transport_t *transport)
+{
+    nextion_transport_t *inner = ((counting_transport_t *)transport)->inner;
+
+    inner->flush_input(inner);
+}
+
+static bool counting_wait_tx_done(nextion_transport_t *transport, TickType_t timeout)
+{
+    nextion_transport_t *inner = ((counting_transport_t *)transport)->inner;
+
+    return inner->wait_tx_done(inner, timeout);
+}
+
+static bool counting_set_baud_rate(nextion_transport_t *transport, uint32_t baud_rate)
+{
+    nextion_transport_t *inner = ((counting_transport_t *)transport)->inner;
+
+    return inner->set_baud_rate(inner, baud_rate);
+}
+
+static nextion_transport_event_t counting_wait_event(nextion_transport_t *transport, TickType_t timeout)
+{
+    nextion_transport_t *inner = ((counting_transport_t *)transport)->inner;
+
+    return inner->wait_event(inner, timeout);
+}
+
+static void counting_wake(nextion_transport_t *transport)
+{
+    nextion_transport_t *inner = ((counting_transport_t *)transport)->inner;
+
+    inner->wake(inner);
+}
+
+static void counting_destroy(nextion_transport_t *transport)
+{
+    counting_transport_t *counting = (counting_transport_t *)transport;
+
+    counting->inner->destroy(counting->inner);
+
+    free(counting);
+}
@@ -0,0 +1,975 @@
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include "esp32_driver_nextion/base/codes.h"
+#include "esp32_driver_nextion/base/constants.h"
+#include "esp32_driver_nextion/reparse.h"
+#include "simulator.h"
+
+#define RECEIVE_BUFFER_SIZE 2048
+#define TRANSMIT_BUFFER_SIZE (NEX_DVC_EEPROM_SIZE + 64)
+#define VARIABLE_COUNT 64
+#define VARIABLE_NAME_LENGTH 32
+#define VARIABLE_TEXT_LENGTH 256
+#define PARAMETER_COUNT 12
+#define PAGE_COUNT 8
+#define WAVEFORM_CHANNEL_COUNT 4
+#define WAVEFORM_ALL_CHANNELS 255
+#define NO_RESPONSE 0xFFU
+#define REPARSE_EXIT_SEQUENCE "DRAKJHSUYDGBNCJHGJKSHBDN\xFF\xFF\xFF"
+
+/**
+ * @typedef variable_t
+ * @brief A system variable or component property.
+ */
+typedef struct
+{
+    char name[VARIABLE_NAME_LENGTH]; /*!< Name, with the component if any: "dim", "t0.txt". */
+    bool is_text;                    /*!< If it holds a text or a number. */
+    int32_t number;                  /*!< Value when a number. */
+    char text[VARIABLE_TEXT_LENGTH]; /*!< Value when a text, null-terminated. */
+} variable_t;
+
+/**
+ * @typedef transparent_target_t
+ * @brief Where "Transparent Data" mode bytes go.
+ */
+typedef enum
+{
+    TRANSPARENT_TARGET_EEPROM = 0,  /*!< Written to the EEPROM ("wept"). */
+    TRANSPARENT_TARGET_WAVEFORM = 1 /*!< Added to a waveform channel ("addt"). */
+} transparent_target_t;
+
+/**
+ * @typedef simulator_t
+ * @brief Simulated display state.
+ */
+typedef struct
+{
+    simulator_config_t config;                     /*!< Display configuration. */
+    int fd;                                        /*!< File descriptor connected to the driver. */
+    uint32_t baud_rate;                            /*!< Current baud rate. */
+    uint32_t next_baud_rate;                       /*!< Baud rate to switch to after responding, or zero. */
+    uint8_t response_mode;                         /*!< Current "bkcmd" value. */
+    uint8_t page_id;                               /*!< Current page. */
+    variable_t variables[VARIABLE_COUNT];          /*!< Variables set so far. */
+    size_t variable_count;                         /*!< Number of variables set. */
+    uint8_t eeprom[NEX_DVC_EEPROM_SIZE];           /*!< EEPROM contents. */
+    transparent_target_t transparent_target;       /*!< Where "Transparent Data" mode bytes go. */
+    size_t transparent_remaining;                  /*!< Bytes left to leave the "Transparent Data" mode. */
+    size_t transparent_address;                    /*!< EEPROM address of the next "Transparent Data" mode byte. */
+    bool is_reparse;                               /*!< If on "Protocol Reparse" mode ("recmod=1"). */
+    uint8_t transmit_buffer[TRANSMIT_BUFFER_SIZE]; /*!< Response being assembled. */
+    size_t transmit_length;                        /*!< Response length. */
+    size_t received_length;                        /*!< Bytes received since the last response. */
+    uint32_t instruction_count;                    /*!< Instructions executed. */
+    uint32_t sample_count;                         /*!< Waveform samples received. */
+    uint32_t frame_count;                          /*!< "Protocol Reparse" mode frames decoded. */
+} simulator_t;
+
+/**
+ * @typedef command_handler_t
+ * @brief Execute a command.
+ * @return Result code to return or NO_RESPONSE.
+ */
+typedef uint8_t (*command_handler_t)(simulator_t *simulator, char **parameters, size_t parameter_count);
+
+/**
+ * @typedef command_t
+ * @brief A command the display understands.
+ */
+typedef struct
+{
+    const char *name;          /*!< Command name. */
+    size_t parameter_count;    /*!< Number of parameters required. */
+    command_handler_t handler; /*!< Function that executes the command. */
+} command_t;
+
+static size_t simulator_process(simulator_t *simulator, const uint8_t *data, size_t length);
+static size_t simulator_reparse(simulator_t *simulator, const uint8_t *data, size_t length);
+static void simulator_execute(simulator_t *simulator, char *instruction);
+static void simulator_reset(simulator_t *simulator);
+static void simulator_respond(simulator_t *simulator);
+static void simulator_result(simulator_t *simulator, uint8_t code);
+static void simulator_send(simulator_t *simulator, const void *data, size_t length);
+static void simulator_send_code(simulator_t *simulator, uint8_t code);
+static uint8_t simulator_assign(simulator_t *simulator, const char *name, char *value);
+static variable_t *simulator_find_variable(simulator_t *simulator, const char *name);
+static variable_t *simulator_add_variable(simulator_t *simulator, const char *name);
+static void simulator_set_number(simulator_t *simulator, const char *name, int32_t number);
+static size_t simulator_split(char *text, char **parameters);
+static bool simulator_parse_number(const char *text, int32_t *number);
+static bool simulator_parse_text(char *text);
+static uint8_t command_get(simulator_t *simulator, char **parameters, size_t parameter_count);
+static uint8_t command_sendme(simulator_t *simulator, char **parameters, size_t parameter_count);
+static uint8_t command_page(simulator_t *simulator, char **parameters, size_t parameter_count);
+static uint8_t command_draw(simulator_t *simulator, char **parameters, size_t parameter_count);
+static uint8_t command_accept(simulator_t *simulator, char **parameters, size_t parameter_count);
+static uint8_t command_add(simulator_t *simulator, char **parameters, size_t parameter_count);
+static uint8_t command_addt(simulator_t *simulator, char **parameters, size_t parameter_count);
+static uint8_t command_cle(simulator_t *simulator, char **parameters, size_t parameter_count);
+static uint8_t command_wepo(simulator_t *simulator, char **parameters, size_t parameter_count);
+static uint8_t command_rept(simulator_t *simulator, char **parameters, size_t parameter_count);
+static uint8_t command_wept(simulator_t *simulator, char **parameters, size_t parameter_count);
+static uint8_t command_rest(simulator_t *simulator, char **parameters, size_t parameter_count);
+
+static const uint32_t BAUD_RATES[] = {2400, 4800, 9600, 19200, 31250, 38400, 57600, 115200, 230400, 250000, 256000, 512000, 921600};
+
+static const command_t COMMANDS[] = {{"get", 1, command_get},
+                                     {"sendme", 0, command_sendme},
+                                     {"page", 1, command_page},
+                                     {"ref", 1, command_accept},
+                                     {"vis", 2, command_accept},
+                                     {"tsw", 2, command_accept},
+                                     {"ref_star", 0, command_accept},
+                                     {"ref_stop", 0, command_accept},
+                                     {"cls", 1, command_draw},
+                                     {"fill", 5, command_draw},
+                                     {"cirs", 4, command_draw},
+                                     {"line", 5, command_draw},
+                                     {"draw", 5, command_draw},
+                                     {"cir", 4, command_draw},
+                                     {"pic", 3, command_draw},
+                                     {"xpic", 7, command_draw},
+                                     {"xstr", 11, command_accept},
+                                     {"add", 3, command_add},
+                                     {"addt", 3, command_addt},
+                                     {"cle", 2, command_cle},
+                                     {"wepo", 2, command_wepo},
+                                     {"rept", 2, command_rept},
+                                     {"wept", 2, command_wept},
+                                     {"rest", 0, command_rest}};
+
+pid_t simulator_start(const simulator_config_t *config, int *fd)
+{
+    int fds[2];
+
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0)
+    {
+        return -1;
+    }
+
+    // Flush before forking, or buffered output is printed twice.
+    fflush(stdout);
+
+    pid_t pid = fork();
+
+    if (pid == 0)
+    {
+        // Otherwise the driver side is never closed for the child.
+        close(fds[0]);
+
+        simulator_run(fds[1], config);
+
+        _exit(EXIT_SUCCESS);
+    }
+
+    close(fds[1]);
+
+    if (pid == -1)
+    {
+        close(fds[0]);
+
+        return -1;
+    }
+
+    *fd = fds[0];
+
+    return pid;
+}
+
+bool simulator_wait(pid_t pid)
+{
+    int status;
+
+    return waitpid(pid, &status, 0) == pid && WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS;
+}
+
+void simulator_run(int fd, const simulator_config_t *config)
+{
+    simulator_t *simulator = (simulator_t *)calloc(1, sizeof(simulator_t));
+    uint8_t buffer[RECEIVE_BUFFER_SIZE];
+    size_t length = 0;
+
+    if (simulator == NULL)
+    {
+        return;
+    }
+
+    simulator->config = *config;
+    simulator->fd = fd;
+
+    simulator_reset(simulator);
+
+    for (;;)
+    {
+        ssize_t bytes_read = read(fd, buffer + length, sizeof(buffer) - length);
+
+        if (bytes_read == 0 || (bytes_read < 0 && errno != EINTR && errno != EAGAIN))
+        {
+            break;
+        }
+
+        if (bytes_read < 0)
+        {
+            continue;
+        }
+
+        length += (size_t)bytes_read;
+
+        size_t consumed = simulator_process(simulator, buffer, length);
+
+        memmove(buffer, buffer + consumed, length - consumed);
+        length -= consumed;
+
+        // No end sequence in a full buffer: nothing will ever be parsed.
+        if (length == sizeof(buffer))
+        {
+            length = 0;
+        }
+    }
+
+    printf("simulator: %lu instructions, %lu waveform samples, %lu reparse frames\n",
+           (unsigned long)simulator->instruction_count,
+           (unsigned long)simulator->sample_count,
+           (unsigned long)simulator->frame_count);
+    fflush(stdout);
+
+    close(fd);
+    free(simulator);
+}
+
+static size_t simulator_process(simulator_t *simulator, const uint8_t *data, size_t length)
+{
+    size_t position = 0;
+
+    while (position < length)
+    {
+        if (simulator->transparent_remaining > 0)
+        {
+            size_t count = length - position;
+
+            if (count > simulator->transparent_remaining)
+            {
+                count = simulator->transparent_remaining;
+            }
+
+            if (simulator->transparent_target == TRANSPARENT_TARGET_EEPROM)
+            {
+                memcpy(simulator->eeprom + simulator->transparent_address, data + position, count);
+
+                simulator->transparent_address += count;
+            }
+            else
+            {
+                simulator->sample_count += count;
+            }
+
+            simulator->transparent_remaining -= count;
+            simulator->received_length += count;
+            position += count;
+
+            if (simulator->transparent_remaining == 0)
+            {
+                simulator_send_code(simulator, NEX_DVC_EVT_TRANSPARENT_DATA_FINISHED);
+                simulator_respond(simulator);
+            }
+
+            continue;
+        }
+
+        if (simulator->is_reparse)
+        {
+            size_t consumed = simulator_reparse(simulator, data + position, length - position);
+
+            if (consumed == 0)
+            {
+                break;
+            }
+
+            position += consumed;
+
+            continue;
+        }
+
+        size_t end = position;
+
+        while (end + NEX_DVC_CMD_END_LENGTH <= length &&
+               !(data[end] == NEX_DVC_CMD_END_VALUE && data[end + 1] == NEX_DVC_CMD_END_VALUE && data[end + 2] == NEX_DVC_CMD_END_VALUE))
+        {
+            end++;
+        }
+
+        if (end + NEX_DVC_CMD_END_LENGTH > length)
+        {
+            break;
+        }
+
+        char instruction[RECEIVE_BUFFER_SIZE];
+        size_t instruction_length = end - position;
+
+        memcpy(instruction, data + position, instruction_length);
+        instruction[instruction_length] = '\0';
+
+        simulator->received_length += instruction_length + NEX_DVC_CMD_END_LENGTH;
+        position = end + NEX_DVC_CMD_END_LENGTH;
+
+        // An empty instruction only ends whatever came before it.
+        if (instruction_length > 0)
+        {
+            simulator_execute(simulator, instruction);
+            simulator_respond(simulator);
+        }
+    }
+
+    return position;
+}
+
+static size_t simulator_reparse(simulator_t *simulator, const uint8_t *data, size_t length)
+{
+    static const uint8_t EXIT_SEQUENCE[] = REPARSE_EXIT_SEQUENCE;
+    const size_t exit_length = sizeof(EXIT_SEQUENCE) - 1;
+    const size_t compared = length < exit_length ? length : exit_length;
+
+    if (memcmp(data, EXIT_SEQUENCE, compared) == 0)
+    {
+        if (compared < exit_length)
+        {
+            return 0;
+        }
+
+        simulator->is_reparse = false;
+        simulator->received_length += exit_length;
+
+        simulator_set_number(simulator, "recmod", 0);
+        simulator_respond(simulator);
+
+        return exit_length;
+    }
+
+    if (length < NEXTION_REPARSE_FRAME_LENGTH)
+    {
+        return 0;
+    }
+
+    // What the documented page script does: decode, or drop a byte to resync.
+    uint8_t checksum = 0;
+
+    for (size_t i = 0; i < NEXTION_REPARSE_FRAME_LENGTH - 1; i++)
+    {
+        checksum += data[i];
+    }
+
+    if (checksum != data[NEXTION_REPARSE_FRAME_LENGTH - 1])
+    {
+        return 1;
+    }
+
+    static const char *const PROPERTIES[] = {NULL, "val", "pco", "bco"};
+    const uint32_t value = (uint32_t)data[2] | ((uint32_t)data[3] << 8) | ((uint32_t)data[4] << 16) | ((uint32_t)data[5] << 24);
+
+    if (data[0] < sizeof(PROPERTIES) / sizeof(PROPERTIES[0]) && PROPERTIES[data[0]] != NULL)
+    {
+        char name[VARIABLE_NAME_LENGTH];
+
+        snprintf(name, sizeof(name), "b[%u].%s", (unsigned int)data[1], PROPERTIES[data[0]]);
+        simulator_set_number(simulator, name, (int32_t)value);
+    }
+
+    simulator->frame_count++;
+    simulator->received_length += NEXTION_REPARSE_FRAME_LENGTH;
+
+    simulator_respond(simulator);
+
+    return NEXTION_REPARSE_FRAME_LENGTH;
+}
+
+static void simulator_execute(simulator_t *simulator, char *instruction)
+{
+    simulator->instruction_count++;
+
+    char *divisor = strchr(instruction, NEX_DVC_CMD_PARAMS_DIVISOR);
+    char *equal = strchr(instruction, '=');
+
+    // "t0.txt=\"a b\"" has a divisor inside the text being assigned.
+    if (equal != NULL && (divisor == NULL || equal < divisor))
+    {
+        *equal = '\0';
+
+        simulator_result(simulator, simulator_assign(simulator, instruction, equal + 1));
+
+        return;
+    }
+
+    char *parameters[PARAMETER_COUNT];
+    size_t parameter_count = 0;
+
+    if (divisor != NULL)
+    {
+        *divisor = '\0';
+
+        parameter_count = simulator_split(divisor + 1, parameters);
+    }
+
+    for (size_t i = 0; i < sizeof(COMMANDS) / sizeof(COMMANDS[0]); i++)
+    {
+        if (strcmp(COMMANDS[i].name, instruction) != 0)
+        {
+            continue;
+        }
+
+        if (parameter_count != COMMANDS[i].parameter_count)
+        {
+            simulator_result(simulator, NEX_DVC_ERR_INVALID_INSTRUCTION_PARAMETERS_COUNT);
+
+            return;
+        }
+
+        simulator_result(simulator, COMMANDS[i].handler(simulator, parameters, parameter_count));
+
+        return;
+    }
+
+    simulator_result(simulator, NEX_DVC_INS_FAIL);
+}
+
+static void simulator_reset(simulator_t *simulator)
+{
+    simulator->baud_rate = simulator->config.baud_rate;
+    simulator->response_mode = simulator->config.response_mode;
+    simulator->page_id = 0;
+    simulator->variable_count = 0;
+    simulator->transparent_remaining = 0;
+    simulator->is_reparse = false;
+
+    simulator_set_number(simulator, "baud", (int32_t)simulator->baud_rate);
+    simulator_set_number(simulator, "bauds", (int32_t)simulator->baud_rate);
+    simulator_set_number(simulator, "bkcmd", simulator->response_mode);
+    simulator_set_number(simulator, "dim", 100);
+    simulator_set_number(simulator, "dims", 100);
+    simulator_set_number(simulator, "sleep", 0);
+    simulator_set_number(simulator, "thsp", 0);
+    simulator_set_number(simulator, "ussp", 0);
+    simulator_set_number(simulator, "thup", 0);
+    simulator_set_number(simulator, "usup", 0);
+    simulator_set_number(simulator, "sendxy", 0);
+    simulator_set_number(simulator, "recmod", 0);
+}
+
+static void simulator_respond(simulator_t *simulator)
+{
+    uint64_t delay_us = simulator->config.latency_us;
+
+    if (simulator->config.throttle && simulator->baud_rate > 0)
+    {
+        // 10 bits per byte: start, 8 data and stop.
+        delay_us += (simulator->received_length + simulator->transmit_length) * 10ULL * 1000000ULL / simulator->baud_rate;
+    }
+
+    if (delay_us > 0)
+    {
+        usleep((useconds_t)delay_us);
+    }
+
+    size_t written = 0;
+
+    while (written < simulator->transmit_length)
+    {
+        ssize_t result = write(simulator->fd, simulator->transmit_buffer + written, simulator->transmit_length - written);
+
+        if (result < 0 && errno != EINTR)
+        {
+            break;
+        }
+
+        if (result > 0)
+        {
+            written += (size_t)result;
+        }
+    }
+
+    simulator->transmit_length = 0;
+    simulator->received_length = 0;
+
+    if (simulator->next_baud_rate != 0)
+    {
+        simulator->baud_rate = simulator->next_baud_rate;
+        simulator->next_baud_rate = 0;
+    }
+}
+
+static void simulator_result(simulator_t *simulator, uint8_t code)
+{
+    if (code == NO_RESPONSE)
+    {
+        return;
+    }
+
+    const uint8_t mode = simulator->response_mode;
+
+    // "bkcmd": 1 = successes only, 2 = failures only, 3 = both.
+    if ((code == NEX_DVC_INS_OK && (mode == 1 || mode == 3)) ||
+        (code != NEX_DVC_INS_OK && (mode == 2 || mode == 3)))
+    {
+        simulator_send_code(simulator, code);
+    }
+}
+
+static void simulator_send(simulator_t *simulator, const void *data, size_t length)
+{
+    if (simulator->transmit_length + length > sizeof(simulator->transmit_buffer))
+    {
+        return;
+    }
+
+    memcpy(simulator->transmit_buffer + simulator->transmit_length, data, length);
+
+    simulator->transmit_length += length;
+}
+
+static void simulator_send_code(simulator_t *simulator, uint8_t code)
+{
+    const uint8_t response[NEX_DVC_CMD_ACK_LENGTH] = {code, NEX_DVC_CMD_END_SEQUENCE};
+
+    simulator_send(simulator, response, sizeof(response));
+}
+
+static uint8_t simulator_assign(simulator_t *simulator, const char *name, char *value)
+{
+    variable_t *variable = simulator_find_variable(simulator, name);
+    int32_t number = 0;
+
+    if (simulator_parse_text(value))
+    {
+        if (variable != NULL && !variable->is_text)
+        {
+            return NEX_DVC_ERR_INVALID_ATTRIBUTE_ASSIGNMENT;
+        }
+
+        if (variable == NULL && (variable = simulator_add_variable(simulator, name)) == NULL)
+        {
+            return NEX_DVC_ERR_INVALID_VARIABLE_OR_ATTRIBUTE;
+        }
+
+        variable->is_text = true;
+
+        snprintf(variable->text, sizeof(variable->text), "%s", value);
+
+        return NEX_DVC_INS_OK;
+    }
+
+    if (!simulator_parse_number(value, &number))
+    {
+        const variable_t *source = simulator_find_variable(simulator, value);
+
+        if (source == NULL || source->is_text)
+        {
+            return NEX_DVC_ERR_INVALID_ATTRIBUTE_ASSIGNMENT;
+        }
+
+        number = source->number;
+    }
+
+    if (variable != NULL && variable->is_text)
+    {
+        return NEX_DVC_ERR_INVALID_ATTRIBUTE_ASSIGNMENT;
+    }
+
+    if (strcmp(name, "bkcmd") == 0)
+    {
+        if (number < 0 || number > 3)
+        {
+            return NEX_DVC_ERR_INVALID_ATTRIBUTE_ASSIGNMENT;
+        }
+
+        simulator->response_mode = (uint8_t)number;
+    }
+    else if (strcmp(name, "recmod") == 0)
+    {
+        if (number < 0 || number > 1)
+        {
+            return NEX_DVC_ERR_INVALID_ATTRIBUTE_ASSIGNMENT;
+        }
+
+        // Whatever follows is kept for the page script.
+        simulator->is_reparse = number == 1;
+    }
+    else if (strcmp(name, "baud") == 0 || strcmp(name, "bauds") == 0)
+    {
+        bool is_valid = false;
+
+        for (size_t i = 0; i < sizeof(BAUD_RATES) / sizeof(BAUD_RATES[0]); i++)
+        {
+            is_valid = is_valid || BAUD_RATES[i] == (uint32_t)number;
+        }
+
+        if (!is_valid)
+        {
+            return NEX_DVC_ERR_INVALID_BAUD_RATE;
+        }
+
+        // Takes effect after the result is sent.
+        simulator->next_baud_rate = (uint32_t)number;
+
+        simulator_set_number(simulator, "baud", number);
+    }
+
+    if (variable == NULL && (variable = simulator_add_variable(simulator, name)) == NULL)
+    {
+        return NEX_DVC_ERR_INVALID_VARIABLE_OR_ATTRIBUTE;
+    }
+
+    variable->is_text = false;
+    variable->number = number;
+
+    return NEX_DVC_INS_OK;
+}
+
+static variable_t *simulator_find_variable(simulator_t *simulator, const char *name)
+{
+    for (size_t i = 0; i < simulator->variable_count; i++)
+    {
+        if (strcmp(simulator->variables[i].name, name) == 0)
+        {
+            return &simulator->variables[i];
+        }
+    }
+
+    return NULL;
+}
+
+static variable_t *simulator_add_variable(simulator_t *simulator, const char *name)
+{
+    if (simulator->variable_count == VARIABLE_COUNT || strlen(name) >= VARIABLE_NAME_LENGTH)
+    {
+        return NULL;
+    }
+
+    variable_t *variable = &simulator->variables[simulator->variable_count++];
+
+    memset(variable, 0, sizeof(variable_t));
+    strcpy(variable->name, name);
+
+    return variable;
+}
+
+static void simulator_set_number(simulator_t *simulator, const char *name, int32_t number)
+{
+    variable_t *variable = simulator_find_variable(simulator, name);
+
+    if (variable == NULL && (variable = simulator_add_variable(simulator, name)) == NULL)
+    {
+        return;
+    }
+
+    variable->is_text = false;
+    variable->number = number;
+}
+
+static size_t simulator_split(char *text, char **parameters)
+{
+    size_t count = 0;
+    bool is_quoted = false;
+
+    parameters[count++] = text;
+
+    for (char *c = text; *c != '\0'; c++)
+    {
+        if (*c == '"' && (c == text || c[-1] != '\\'))
+        {
+            is_quoted = !is_quoted;
+        }
+        else if (*c == NEX_DVC_CMD_PARAMS_SEPARATOR && !is_quoted && count < PARAMETER_COUNT)
+        {
+            *c = '\0';
+
+            parameters[count++] = c + 1;
+        }
+    }
+
+    return count;
+}
+
+static bool simulator_parse_number(const char *text, int32_t *number)
+{
+    char *end;
+
+    errno = 0;
+
+    long value = strtol(text, &end, 10);
+
+    if (end == text || *end != '\0' || errno != 0)
+    {
+        return false;
+    }
+
+    *number = (int32_t)value;
+
+    return true;
+}
+
+static bool simulator_parse_text(char *text)
+{
+    size_t length = strlen(text);
+
+    if (length < 2 || text[0] != '"' || text[length - 1] != '"')
+    {
+        return false;
+    }
+
+    // Remove the quotes and unescape in place.
+    size_t out = 0;
+
+    for (size_t i = 1; i < length - 1; i++)
+    {
+        if (text[i] == '\\' && i + 1 < length - 1)
+        {
+            i++;
+        }
+
+        text[out++] = text[i];
+    }
+
+    text[out] = '\0';
+
+    return true;
+}
+
+static uint8_t command_get(simulator_t *simulator, char **parameters, size_t)
+{
+    const variable_t *variable = simulator_find_variable(simulator, parameters[0]);
+
+    if (variable == NULL)
+    {
+        return NEX_DVC_ERR_INVALID_VARIABLE_OR_ATTRIBUTE;
+    }
+
+    if (variable->is_text)
+    {
+        const uint8_t code = NEX_DVC_RSP_GET_TEXT;
+        const uint8_t end[NEX_DVC_CMD_END_LENGTH] = {NEX_DVC_CMD_END_SEQUENCE};
+
+        simulator_send(simulator, &code, 1);
+        simulator_send(simulator, variable->text, strlen(variable->text));
+        simulator_send(simulator, end, sizeof(end));
+    }
+    else
+    {
+        const uint32_t value = (uint32_t)variable->number;
+        const uint8_t response[] = {NEX_DVC_RSP_GET_NUMBER,
+                                    (uint8_t)value,
+                                    (uint8_t)(value >> 8),
+                                    (uint8_t)(value >> 16),
+                                    (uint8_t)(value >> 24),
+                                    NEX_DVC_CMD_END_SEQUENCE};
+
+        simulator_send(simulator, response, sizeof(response));
+    }
+
+    return NO_RESPONSE;
+}
+
+static uint8_t command_sendme(simulator_t *simulator, char **, size_t)
+{
+    const uint8_t response[] = {NEX_DVC_RSP_SENDME, simulator->page_id, NEX_DVC_CMD_END_SEQUENCE};
+
+    simulator_send(simulator, response, sizeof(response));
+
+    return NO_RESPONSE;
+}
+
+static uint8_t command_page(simulator_t *simulator, char **parameters, size_t)
+{
+    const char *page = parameters[0];
+    int32_t page_id;
+
+    // Pages are named "page0", "page1"... or addressed by id.
+    if (strncmp(page, "page", 4) == 0)
+    {
+        page += 4;
+    }
+
+    if (!simulator_parse_number(page, &page_id) || page_id < 0 || page_id >= PAGE_COUNT)
+    {
+        return NEX_DVC_ERR_INVALID_PAGE;
+    }
+
+    simulator->page_id = (uint8_t)page_id;
+
+    return NEX_DVC_INS_OK;
+}
+
+static uint8_t command_draw(simulator_t *, char **parameters, size_t parameter_count)
+{
+    int32_t number;
+
+    for (size_t i = 0; i < parameter_count; i++)
+    {
+        if (!simulator_parse_number(parameters[i], &number))
+        {
+            return NEX_DVC_ERR_INVALID_VARIABLE_OPERATION;
+        }
+    }
+
+    return NEX_DVC_INS_OK;
+}
+
+static uint8_t command_accept(simulator_t *, char **, size_t)
+{
+    return NEX_DVC_INS_OK;
+}
+
+static uint8_t command_add(simulator_t *simulator, char **parameters, size_t)
+{
+    int32_t channel_id;
+    int32_t value;
+
+    if (!simulator_parse_number(parameters[1], &channel_id) || channel_id < 0 || channel_id >= WAVEFORM_CHANNEL_COUNT)
+    {
+        return NEX_DVC_ERR_INVALID_WAVEFORM;
+    }
+
+    if (!simulator_parse_number(parameters[2], &value))
+    {
+        return NEX_DVC_ERR_INVALID_VARIABLE_OPERATION;
+    }
+
+    simulator->sample_count++;
+
+    // Like the device: only failures are returned.
+    return NO_RESPONSE;
+}
+
+static uint8_t command_addt(simulator_t *simulator, char **parameters, size_t)
+{
+    int32_t channel_id;
+    int32_t count;
+
+    if (!simulator_parse_number(parameters[1], &channel_id) || channel_id < 0 || channel_id >= WAVEFORM_CHANNEL_COUNT)
+    {
+        return NEX_DVC_ERR_INVALID_WAVEFORM;
+    }
+
+    if (!simulator_parse_number(parameters[2], &count) || count <= 0 || count >= (int32_t)NEX_DVC_TRANSPARENT_DATA_MAX_DATA_SIZE)
+    {
+        return NEX_DVC_ERR_INVALID_VARIABLE_OPERATION;
+    }
+
+    simulator->transparent_target = TRANSPARENT_TARGET_WAVEFORM;
+    simulator->transparent_remaining = (size_t)count;
+
+    simulator_send_code(simulator, NEX_DVC_RSP_TRANSPARENT_DATA_READY);
+
+    return NO_RESPONSE;
+}
+
+static uint8_t command_cle(simulator_t *, char **parameters, size_t)
+{
+    int32_t channel_id;
+
+    if (!simulator_parse_number(parameters[1], &channel_id) ||
+        (channel_id != WAVEFORM_ALL_CHANNELS && (channel_id < 0 || channel_id >= WAVEFORM_CHANNEL_COUNT)))
+    {
+        return NEX_DVC_ERR_INVALID_WAVEFORM;
+    }
+
+    return NEX_DVC_INS_OK;
+}
+
+static uint8_t command_wepo(simulator_t *simulator, char **parameters, size_t)
+{
+    int32_t address;
+    int32_t number;
+
+    if (!simulator_parse_number(parameters[1], &address) || address < 0 || address >= (int32_t)NEX_DVC_EEPROM_SIZE)
+    {
+        return NEX_DVC_ERR_EEPROM_OPERATION_FAILED;
+    }
+
+    if (simulator_parse_text(parameters[0]))
+    {
+        // The text is written with its null terminator.
+        size_t length = strlen(parameters[0]) + 1;
+
+        if ((size_t)address + length > NEX_DVC_EEPROM_SIZE)
+        {
+            return NEX_DVC_ERR_EEPROM_OPERATION_FAILED;
+        }
+
+        memcpy(simulator->eeprom + address, parameters[0], length);
+
+        return NEX_DVC_INS_OK;
+    }
+
+    if (!simulator_parse_number(parameters[0], &number) || (size_t)address + sizeof(number) > NEX_DVC_EEPROM_SIZE)
+    {
+        return NEX_DVC_ERR_EEPROM_OPERATION_FAILED;
+    }
+
+    const uint32_t value = (uint32_t)number;
+
+    for (size_t i = 0; i < sizeof(value); i++)
+    {
+        simulator->eeprom[address + i] = (uint8_t)(value >> (8 * i));
+    }
+
+    return NEX_DVC_INS_OK;
+}
+
+static uint8_t command_rept(simulator_t *simulator, char **parameters, size_t)
+{
+    int32_t address;
+    int32_t count;
+
+    if (!simulator_parse_number(parameters[0], &address) || !simulator_parse_number(parameters[1], &count) ||
+        address < 0 || count < 0 || count > (int32_t)NEX_DVC_EEPROM_SIZE)
+    {
+        return NEX_DVC_ERR_EEPROM_OPERATION_FAILED;
+    }
+
+    // Exactly what was asked, zeros past the end; no result code.
+    for (int32_t i = 0; i < count; i++)
+    {
+        const uint8_t value = address + i < (int32_t)NEX_DVC_EEPROM_SIZE ? simulator->eeprom[address + i] : 0;
+
+        simulator_send(simulator, &value, 1);
+    }
+
+    return NO_RESPONSE;
+}
+
+static uint8_t command_wept(simulator_t *simulator, char **parameters, size_t)
+{
+    int32_t address;
+    int32_t count;
+
+    if (!simulator_parse_number(parameters[0], &address) || !simulator_parse_number(parameters[1], &count) ||
+        address < 0 || count <= 0 || address + count > (int32_t)NEX_DVC_EEPROM_SIZE)
+    {
+        return NEX_DVC_ERR_EEPROM_OPERATION_FAILED;
+    }
+
+    simulator->transparent_target = TRANSPARENT_TARGET_EEPROM;
+    simulator->transparent_address = (size_t)address;
+    simulator->transparent_remaining = (size_t)count;
+
+    simulator_send_code(simulator, NEX_DVC_RSP_TRANSPARENT_DATA_READY);
+
+    return NO_RESPONSE;
+}
+
+static uint8_t command_rest(simulator_t *simulator, char **, size_t)
+{
+    const uint8_t start[] = {NEX_DVC_EVT_HARDWARE_START_RESET, 0x00, 0x00, NEX_DVC_CMD_END_SEQUENCE};
+
+    simulator_reset(simulator);
+
+    simulator_send(simulator, start, sizeof(start));
+    simulator_send_code(simulator, NEX_DVC_EVT_HARDWARE_READY);
+
+    return NO_RESPONSE;
+}
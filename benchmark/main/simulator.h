@@ -0,0 +1,59 @@
+#ifndef __BENCHMARK_SIMULATOR_H__
+#define __BENCHMARK_SIMULATOR_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @typedef simulator_config_t
+     * @brief How the simulated display behaves.
+     */
+    typedef struct
+    {
+        uint32_t latency_us;   /** @brief Time, in microseconds, the display takes to execute each instruction. */
+        uint32_t baud_rate;    /** @brief Baud rate the display starts with. */
+        uint8_t response_mode; /** @brief "bkcmd" value the display starts with. */
+        bool throttle;         /** @brief If bytes take the time they would take on a UART at the baud rate. */
+    } simulator_config_t;
+
+    /**
+     * @brief Default simulator configuration: no latency, 115200 bps and every result returned.
+     */
+#define SIMULATOR_CONFIG_DEFAULT() {.latency_us = 0, .baud_rate = 115200, .response_mode = 3, .throttle = false}
+
+    /**
+     * @brief Run a simulated display on a child process, connected through a socket pair.
+     * @details The display answers instructions as a real one would,
+     * until the driver side of the connection is closed.
+     * @param[in] config Display configuration.
+     * @param[out] fd Driver side of the connection.
+     * @return Child process id or -1 on error.
+     */
+    pid_t simulator_start(const simulator_config_t *config, int *fd);
+
+    /**
+     * @brief Wait for a simulated display to exit.
+     * @note The driver side of the connection must have been closed.
+     * @param[in] pid Child process id returned by "simulator_start".
+     * @return True if it exited normally, otherwise false.
+     */
+    bool simulator_wait(pid_t pid);
+
+    /**
+     * @brief Run a simulated display on the calling thread.
+     * @details Returns when the other side closes the connection.
+     * @param[in] fd File descriptor connected to the driver: a pty or a socket.
+     * @param[in] config Display configuration.
+     */
+    void simulator_run(int fd, const simulator_config_t *config);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,127 @@
+#ifndef __ESP32_DRIVER_NEXTION_ASYNC_H__
+#define __ESP32_DRIVER_NEXTION_ASYNC_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include "base/codes.h"
+#include "base/types.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @typedef nextion_async_callback_t
+     * @brief Function called when an asynchronous instruction completes.
+     * @warning Called with the UART locked, from the task that received the
+     * response; must be short and must not call any driver function.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] code NEX_OK, NEX_FAIL, NEX_TIMEOUT or any NEX_DVC_ERR_* value.
+     * @param[in] context User context passed when the instruction was queued.
+     */
+    typedef void (*nextion_async_callback_t)(nextion_t *handle, nex_err_t code, void *context);
+
+    /**
+     * @brief Send an instruction without waiting for its response.
+     * @details Instructions are written back to back and their responses are
+     * matched in the order they were sent, so many can be in flight at once.
+     * @warning The device must reply to every instruction ("bkcmd=3"),
+     * otherwise responses will be matched to the wrong instructions. In the
+     * NEXTION_RESPONSE_NONE and NEXTION_RESPONSE_FAILURE modes the callback
+     * is called with NEX_OK as soon as the instruction is written.
+     * @note Blocks when CONFIG_NEX_ASYNC_QUEUE_SIZE instructions are pending.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] instruction A null-terminated string with an instruction that returns only success or failure.
+     * @param[in] callback Function called on completion. Can be NULL.
+     * @param[in] context User context passed to the callback.
+     * @return NEX_OK if queued, otherwise NEX_FAIL.
+     */
+    nex_err_t nextion_async_send(nextion_t *handle,
+                                 const char *instruction,
+                                 nextion_async_callback_t callback,
+                                 void *context);
+
+    /**
+     * @brief Set a component property with a number, without waiting for the response.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] component_name A null-terminated string with the component's name.
+     * @param[in] property_name A null-terminated string with the property's name.
+     * @param[in] number Number to set.
+     * @param[in] callback Function called on completion. Can be NULL.
+     * @param[in] context User context passed to the callback.
+     * @return NEX_OK if queued, otherwise NEX_FAIL.
+     */
+    nex_err_t nextion_async_set_property_number(nextion_t *handle,
+                                                const char *component_name,
+                                                const char *property_name,
+                                                int32_t number,
+                                                nextion_async_callback_t callback,
+                                                void *context);
+
+    /**
+     * @brief Set a component property with a text, without waiting for the response.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] component_name A null-terminated string with the component's name.
+     * @param[in] property_name A null-terminated string with the property's name.
+     * @param[in] text A null-terminated string with the text to set.
+     * @param[in] callback Function called on completion. Can be NULL.
+     * @param[in] context User context passed to the callback.
+     * @return NEX_OK if queued, otherwise NEX_FAIL.
+     */
+    nex_err_t nextion_async_set_property_text(nextion_t *handle,
+                                              const char *component_name,
+                                              const char *property_name,
+                                              const char *text,
+                                              nextion_async_callback_t callback,
+                                              void *context);
+
+    /**
+     * @brief Get a number from a component property, without waiting for the response.
+     * @warning \p number must stay valid until the callback is called.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] component_name A null-terminated string with the component's name.
+     * @param[in] property_name A null-terminated string with the property's name.
+     * @param[out] number Location where the number will be written.
+     * @param[in] callback Function called on completion. Can be NULL.
+     * @param[in] context User context passed to the callback.
+     * @return NEX_OK if queued, otherwise NEX_FAIL.
+     */
+    nex_err_t nextion_async_get_property_number(nextion_t *handle,
+                                                const char *component_name,
+                                                const char *property_name,
+                                                int32_t *number,
+                                                nextion_async_callback_t callback,
+                                                void *context);
+
+    /**
+     * @brief Get a text from a component property, without waiting for the response.
+     * @warning \p buffer must stay valid until the callback is called.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] component_name A null-terminated string with the component's name.
+     * @param[in] property_name A null-terminated string with the property's name.
+     * @param[out] buffer Location where the text will be written.
+     * @param[in] buffer_length Buffer length.
+     * @param[in] callback Function called on completion. Can be NULL.
+     * @param[in] context User context passed to the callback.
+     * @return NEX_OK if queued, otherwise NEX_FAIL.
+     */
+    nex_err_t nextion_async_get_property_text(nextion_t *handle,
+                                              const char *component_name,
+                                              const char *property_name,
+                                              char *buffer,
+                                              size_t buffer_length,
+                                              nextion_async_callback_t callback,
+                                              void *context);
+
+    /**
+     * @brief Wait until all pending asynchronous instructions complete.
+     * @param[in] handle Nextion context pointer.
+     * @return NEX_OK or NEX_FAIL.
+     */
+    nex_err_t nextion_async_wait(nextion_t *handle);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
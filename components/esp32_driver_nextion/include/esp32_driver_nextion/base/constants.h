@@ -83,6 +83,11 @@ extern "C"
  */
 #define NEX_DVC_TRANSPARENT_DATA_MAX_DATA_SIZE 1024U
 
+/**
+ * @brief Maximum number of channels of a waveform.
+ */
+#define NEX_DVC_WAVEFORM_MAX_CHANNELS 4U
+
 /**
  * @brief EEPROM size in bytes.
  */
@@ -105,6 +110,12 @@ extern "C"
  */
 #define NEX_DVC_RESET_WAIT_TIME_MS 100
 
+/**
+ * @brief Time, in milliseconds, that a device needs
+ * to start using a new baud rate.
+ */
+#define NEX_DVC_BAUD_RATE_WAIT_TIME_MS 50
+
 #ifdef __cplusplus
 }
 #endif
@@ -33,6 +33,21 @@ extern "C"
         NEXTION_BAUD_RATE_921600 = 921600U
     } nextion_baud_rate_t;
 
+    /**
+     * @typedef nextion_response_mode_t
+     * @brief Which instruction results the device returns ("bkcmd").
+     */
+    typedef enum
+    {
+        // Values here must have the same values as those
+        // defined in the instruction set manual.
+
+        NEXTION_RESPONSE_NONE = 0U,    /** @brief Return nothing. */
+        NEXTION_RESPONSE_SUCCESS = 1U, /** @brief Return only successes. */
+        NEXTION_RESPONSE_FAILURE = 2U, /** @brief Return only failures. Device default. */
+        NEXTION_RESPONSE_ALL = 3U      /** @brief Return successes and failures. */
+    } nextion_response_mode_t;
+
 #ifdef __cplusplus
 }
 #endif
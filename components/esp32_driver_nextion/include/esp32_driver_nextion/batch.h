@@ -0,0 +1,118 @@
+#ifndef __ESP32_DRIVER_NEXTION_BATCH_H__
+#define __ESP32_DRIVER_NEXTION_BATCH_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include "base/codes.h"
+#include "base/types.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @typedef nextion_batch_t
+     * @brief Instructions encoded back to back, to be sent at once.
+     */
+    typedef struct nextion_batch_t nextion_batch_t;
+
+    /**
+     * @typedef nextion_batch_failure_t
+     * @brief An instruction of a batch that failed.
+     */
+    typedef struct
+    {
+        size_t index;   /** @brief Position of the instruction in the batch, starting at zero. */
+        nex_err_t code; /** @brief NEX_FAIL, NEX_TIMEOUT or any NEX_DVC_ERR_* value. */
+    } nextion_batch_failure_t;
+
+    /**
+     * @brief Start a batch of instructions.
+     * @details Instructions added are only encoded; nothing is sent
+     * until "nextion_batch_commit" is called.
+     * @note Allocates CONFIG_NEX_BATCH_BUFFER_SIZE bytes, released on commit.
+     * @param[in] handle Nextion context pointer.
+     * @return Pointer to a batch or NULL.
+     */
+    nextion_batch_t *nextion_batch_begin(nextion_t *handle);
+
+    /**
+     * @brief Add an instruction to a batch.
+     * @param[in] batch Batch pointer.
+     * @param[in] instruction A null-terminated string with an instruction that returns only success or failure.
+     * @return NEX_OK or NEX_FAIL.
+     */
+    nex_err_t nextion_batch_add(nextion_batch_t *batch, const char *instruction);
+
+    /**
+     * @brief Add to a batch an instruction that sets a component property with a number.
+     * @param[in] batch Batch pointer.
+     * @param[in] component_name A null-terminated string with the component's name.
+     * @param[in] property_name A null-terminated string with the property's name.
+     * @param[in] number Number to set.
+     * @return NEX_OK or NEX_FAIL.
+     */
+    nex_err_t nextion_batch_add_property_number(nextion_batch_t *batch,
+                                                const char *component_name,
+                                                const char *property_name,
+                                                int32_t number);
+
+    /**
+     * @brief Add to a batch an instruction that sets a component property with a text.
+     * @param[in] batch Batch pointer.
+     * @param[in] component_name A null-terminated string with the component's name.
+     * @param[in] property_name A null-terminated string with the property's name.
+     * @param[in] text A null-terminated string with the text to set.
+     * @return NEX_OK or NEX_FAIL.
+     */
+    nex_err_t nextion_batch_add_property_text(nextion_batch_t *batch,
+                                              const char *component_name,
+                                              const char *property_name,
+                                              const char *text);
+
+    /**
+     * @brief Add to a batch an instruction that sets a component value.
+     * @param[in] batch Batch pointer.
+     * @param[in] component_name A null-terminated string with the component's name.
+     * @param[in] number Number to set.
+     * @return NEX_OK or NEX_FAIL.
+     */
+    nex_err_t nextion_batch_add_value(nextion_batch_t *batch, const char *component_name, int32_t number);
+
+    /**
+     * @brief Add to a batch an instruction that sets a component text.
+     * @param[in] batch Batch pointer.
+     * @param[in] component_name A null-terminated string with the component's name.
+     * @param[in] text A null-terminated string with the text to set.
+     * @return NEX_OK or NEX_FAIL.
+     */
+    nex_err_t nextion_batch_add_text(nextion_batch_t *batch, const char *component_name, const char *text);
+
+    /**
+     * @brief Send all instructions of a batch in one write and collect their results.
+     * @details Results are read in a single pass after the write. The batch
+     * is released whatever the result.
+     * @note When the response mode is not NEXTION_RESPONSE_ALL the batch is
+     * wrapped with "bkcmd" instructions, so every result is returned.
+     * @param[in] batch Batch pointer.
+     * @param[out] failures Location where failed instructions will be written. Can be NULL.
+     * @param[in] failures_length Maximum number of failures written.
+     * @param[out] failure_count Number of failed instructions, even if more than \p failures_length. Can be NULL.
+     * @return NEX_OK if all instructions succeeded, otherwise NEX_FAIL.
+     */
+    nex_err_t nextion_batch_commit(nextion_batch_t *batch,
+                                   nextion_batch_failure_t *failures,
+                                   size_t failures_length,
+                                   size_t *failure_count);
+
+    /**
+     * @brief Release a batch without sending it.
+     * @param[in] batch Batch pointer.
+     */
+    void nextion_batch_discard(nextion_batch_t *batch);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,86 @@
+#ifndef __ESP32_DRIVER_NEXTION_COALESCE_H__
+#define __ESP32_DRIVER_NEXTION_COALESCE_H__
+
+#include <stdint.h>
+#include "base/codes.h"
+#include "base/types.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @brief Write a number to a component property on the next frame.
+     * @details Writing the same property again before the frame ends replaces
+     * the value; only the last one is sent.
+     * @note Requires CONFIG_NEX_COALESCE, otherwise always fails.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] component_name A null-terminated string with the component's name.
+     * @param[in] property_name A null-terminated string with the property's name.
+     * @param[in] number Number to set.
+     * @return NEX_OK or NEX_FAIL.
+     */
+    nex_err_t nextion_coalesce_set_property_number(nextion_t *handle,
+                                                   const char *component_name,
+                                                   const char *property_name,
+                                                   int32_t number);
+
+    /**
+     * @brief Write a text to a component property on the next frame.
+     * @details Writing the same property again before the frame ends replaces
+     * the value; only the last one is sent.
+     * @note Requires CONFIG_NEX_COALESCE, otherwise always fails.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] component_name A null-terminated string with the component's name.
+     * @param[in] property_name A null-terminated string with the property's name.
+     * @param[in] text A null-terminated string with the text to set.
+     * @return NEX_OK or NEX_FAIL.
+     */
+    nex_err_t nextion_coalesce_set_property_text(nextion_t *handle,
+                                                 const char *component_name,
+                                                 const char *property_name,
+                                                 const char *text);
+
+    /**
+     * @brief Write a component value on the next frame.
+     * @note Requires CONFIG_NEX_COALESCE, otherwise always fails.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] component_name A null-terminated string with the component's name.
+     * @param[in] number Number to set.
+     * @return NEX_OK or NEX_FAIL.
+     */
+    nex_err_t nextion_coalesce_set_value(nextion_t *handle, const char *component_name, int32_t number);
+
+    /**
+     * @brief Write a component text on the next frame.
+     * @note Requires CONFIG_NEX_COALESCE, otherwise always fails.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] component_name A null-terminated string with the component's name.
+     * @param[in] text A null-terminated string with the text to set.
+     * @return NEX_OK or NEX_FAIL.
+     */
+    nex_err_t nextion_coalesce_set_text(nextion_t *handle, const char *component_name, const char *text);
+
+    /**
+     * @brief Send all values waiting now, without waiting for the frame to end.
+     * @note Requires CONFIG_NEX_COALESCE, otherwise always fails.
+     * @param[in] handle Nextion context pointer.
+     * @return NEX_OK if all values were set, otherwise NEX_FAIL.
+     */
+    nex_err_t nextion_coalesce_flush(nextion_t *handle);
+
+    /**
+     * @brief Change the frame period.
+     * @details Starts as CONFIG_NEX_COALESCE_PERIOD_MS; applies from the next frame.
+     * @note Requires CONFIG_NEX_COALESCE, otherwise always fails.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] period_ms Frame period, in milliseconds. Must be at least one tick.
+     * @return NEX_OK or NEX_FAIL.
+     */
+    nex_err_t nextion_coalesce_set_period(nextion_t *handle, uint32_t period_ms);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
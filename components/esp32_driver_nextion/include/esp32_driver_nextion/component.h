@@ -89,6 +89,20 @@ extern "C"
                                           const char *component_name,
                                           int32_t *number);
 
+    /**
+     * @brief Get the ".val" value of many components in a single response.
+     * @note Shorthand for "nextion_component_get_property_numbers" using "val" property.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] component_names Array of null-terminated strings with the component names.
+     * @param[in] count Number of components.
+     * @param[out] numbers Array of "count" numbers where the retrieved values will be stored, in the same order.
+     * @return NEX_OK or NEX_FAIL | NEX_TIMEOUT.
+     */
+    nex_err_t nextion_component_get_values(nextion_t *handle,
+                                           const char *const *component_names,
+                                           size_t count,
+                                           int32_t *numbers);
+
     /**
      * @brief Get a component ".val" value converted to boolean.
      * @note Shorthand for "nextion_component_get_property_number" using "val" property
@@ -169,6 +183,25 @@ extern "C"
                                                     const char *property_name,
                                                     int32_t *number);
 
+    /**
+     * @brief Get a number from the same property of many components in a single response.
+     * @details All values are printed by the device one after another, so the response
+     * wait is paid once instead of once per component.
+     * @note The response must fit in CONFIG_NEX_UART_RECV_FRAME_BUFFER_SIZE: up to 31 numbers by default.
+     * @note A component or property that does not exist prints nothing; the read then fails by timeout.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] component_names Array of null-terminated strings with the component names.
+     * @param[in] count Number of components.
+     * @param[in] property_name A null-terminated string with the property name to retrieve the numbers from.
+     * @param[out] numbers Array of "count" numbers where the retrieved values will be stored, in the same order.
+     * @return NEX_OK or NEX_FAIL | NEX_TIMEOUT.
+     */
+    nex_err_t nextion_component_get_property_numbers(nextion_t *handle,
+                                                     const char *const *component_names,
+                                                     size_t count,
+                                                     const char *property_name,
+                                                     int32_t *numbers);
+
     /**
      * @brief Set a component property with a text.
      * @param[in] handle Nextion context pointer.
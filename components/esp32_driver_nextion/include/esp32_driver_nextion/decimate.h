@@ -0,0 +1,102 @@
+#ifndef __ESP32_DRIVER_NEXTION_DECIMATE_H__
+#define __ESP32_DRIVER_NEXTION_DECIMATE_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "base/codes.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Buffer length, in bytes, a NEXTION_DECIMATE_LTTB decimator needs.
+ * @param window_length Samples shown across the width.
+ * @param width Waveform width, in pixels.
+ */
+#define NEXTION_DECIMATE_LTTB_BUFFER_LENGTH(window_length, width) (2U * ((window_length) / (width)))
+
+    /**
+     * @typedef nextion_decimate_mode_t
+     * @brief How samples are reduced.
+     */
+    typedef enum
+    {
+        NEXTION_DECIMATE_MIN_MAX = 0, /** @brief Minimum and maximum of every two pixel columns, in the order they came. */
+        NEXTION_DECIMATE_LTTB = 1     /** @brief Largest-Triangle-Three-Buckets: one sample per pixel column. */
+    } nextion_decimate_mode_t;
+
+    /**
+     * @typedef nextion_decimator_t
+     * @brief Reduces samples to what a waveform can show, as they come.
+     */
+    typedef struct
+    {
+        nextion_decimate_mode_t mode; /** @brief How samples are reduced. */
+        size_t bucket_length;         /** @brief Samples reduced at once. */
+        size_t count;                 /** @brief Samples on the bucket being filled. */
+        uint8_t min;                  /** @brief Minimum of the bucket being filled; min/max only. */
+        uint8_t max;                  /** @brief Maximum of the bucket being filled; min/max only. */
+        bool is_min_first;            /** @brief If the minimum came before the maximum; min/max only. */
+        uint32_t sum;                 /** @brief Sum of the bucket being filled; LTTB only. */
+        uint8_t *filling;             /** @brief Bucket being filled; LTTB only. */
+        uint8_t *pending;             /** @brief Bucket filled, waiting for the next one; LTTB only. */
+        bool has_pending;             /** @brief If a bucket is waiting; LTTB only. */
+        bool has_anchor;              /** @brief If a sample was selected already; LTTB only. */
+        float anchor_x;               /** @brief Position of the last sample selected, from the waiting bucket start; LTTB only. */
+        uint8_t anchor_y;             /** @brief Last sample selected; LTTB only. */
+    } nextion_decimator_t;
+
+    /**
+     * @brief Initialize a decimator.
+     * @param[out] decimator Location where the decimator will be written.
+     * @param[in] mode How samples are reduced.
+     * @param[in] window_length Samples shown across the width; at least twice the width.
+     * @param[in] width Waveform width, in pixels.
+     * @param[in] buffer Buffer for NEXTION_DECIMATE_LTTB, of NEXTION_DECIMATE_LTTB_BUFFER_LENGTH bytes. Can be NULL for NEXTION_DECIMATE_MIN_MAX.
+     * @param[in] buffer_length Buffer length.
+     * @return NEX_OK or NEX_FAIL.
+     */
+    nex_err_t nextion_decimate_init(nextion_decimator_t *decimator,
+                                    nextion_decimate_mode_t mode,
+                                    size_t window_length,
+                                    uint16_t width,
+                                    uint8_t *buffer,
+                                    size_t buffer_length);
+
+    /**
+     * @brief Get how many samples can come out when pushing some.
+     * @param[in] decimator Decimator.
+     * @param[in] sample_count Number of samples pushed.
+     * @return Maximum number of samples written by "nextion_decimate_push" or "nextion_decimate_flush".
+     */
+    size_t nextion_decimate_max_output(const nextion_decimator_t *decimator, size_t sample_count);
+
+    /**
+     * @brief Push samples, writing the reduced ones of every bucket completed.
+     * @details The output can be streamed right away.
+     * @param[in] decimator Decimator.
+     * @param[in] samples Samples.
+     * @param[in] sample_count Number of samples.
+     * @param[out] output Location where the reduced samples will be written; "nextion_decimate_max_output" bytes.
+     * @return Number of samples written.
+     */
+    size_t nextion_decimate_push(nextion_decimator_t *decimator,
+                                 const uint8_t *samples,
+                                 size_t sample_count,
+                                 uint8_t *output);
+
+    /**
+     * @brief Reduce the samples waiting, as if no more will come, and start over.
+     * @param[in] decimator Decimator.
+     * @param[out] output Location where the reduced samples will be written; "nextion_decimate_max_output" bytes.
+     * @return Number of samples written.
+     */
+    size_t nextion_decimate_flush(nextion_decimator_t *decimator, uint8_t *output);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
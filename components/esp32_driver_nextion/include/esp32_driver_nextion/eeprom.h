@@ -87,11 +87,22 @@ extern "C"
 
     /**
      * @brief Write a value onto the EEPROM stream.
+     * @note Prefer "nextion_eeprom_stream_write_buffer": every call waits for the value to be transmitted.
      * @param[in] handle Nextion context pointer.
      * @param[in] value Value to be written.
-     * @return NEX_OK if success, otherwise NEX_FAIL.
+     * @return NEX_OK if success, otherwise NEX_FAIL | NEX_TIMEOUT.
+     */
+    nex_err_t nextion_eeprom_stream_write(nextion_t *handle, uint8_t value);
+
+    /**
+     * @brief Write many values onto the EEPROM stream, in a single write.
+     * @details When the values complete the count given on begin, waits for the device to finish the stream.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] values Values to be written.
+     * @param[in] value_count Number of values; at most what is left of the count given on begin.
+     * @return NEX_OK if success, otherwise NEX_FAIL | NEX_TIMEOUT.
      */
-    nex_err_t nextion_eeprom_stream_write(const nextion_t *handle, uint8_t value);
+    nex_err_t nextion_eeprom_stream_write_buffer(nextion_t *handle, const uint8_t *values, size_t value_count);
 
 #ifdef __cplusplus
 }
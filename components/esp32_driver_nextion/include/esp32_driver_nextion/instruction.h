@@ -0,0 +1,58 @@
+#ifndef __ESP32_DRIVER_NEXTION_INSTRUCTION_H__
+#define __ESP32_DRIVER_NEXTION_INSTRUCTION_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include "base/codes.h"
+#include "base/types.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @brief Send an instruction already built, that returns only success or failure.
+     * @details Nothing is formatted; the instruction is written as is, followed by the end sequence.
+     * @note A property assigned, as in "component.property=value", is forgotten by the shadow cache.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] instruction Instruction, without the end sequence.
+     * @param[in] instruction_length Instruction length.
+     * @return NEX_OK or NEX_FAIL | NEX_DVC_ERR_*.
+     */
+    nex_err_t nextion_instruction_send(nextion_t *handle, const char *instruction, size_t instruction_length);
+
+    /**
+     * @brief Send an instruction already built, that returns a number.
+     * @details Nothing is formatted; the instruction is written as is, followed by the end sequence.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] instruction Instruction, without the end sequence.
+     * @param[in] instruction_length Instruction length.
+     * @param[out] number Location where the returned number will be written.
+     * @return NEX_OK or NEX_FAIL | NEX_DVC_ERR_*.
+     */
+    nex_err_t nextion_instruction_send_get_number(nextion_t *handle,
+                                                  const char *instruction,
+                                                  size_t instruction_length,
+                                                  int32_t *number);
+
+    /**
+     * @brief Send an instruction already built, that returns a text.
+     * @details Nothing is formatted; the instruction is written as is, followed by the end sequence.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] instruction Instruction, without the end sequence.
+     * @param[in] instruction_length Instruction length.
+     * @param[out] buffer Location where the returned text will be written, null-terminated.
+     * @param[in] buffer_length Buffer length.
+     * @return NEX_OK or NEX_FAIL | NEX_DVC_ERR_*.
+     */
+    nex_err_t nextion_instruction_send_get_text(nextion_t *handle,
+                                                const char *instruction,
+                                                size_t instruction_length,
+                                                char *buffer,
+                                                size_t buffer_length);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
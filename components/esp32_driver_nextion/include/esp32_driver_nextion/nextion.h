@@ -2,18 +2,18 @@
 #define __ESP32_DRIVER_NEXTION_NEXTION_H__
 
 #include <stdint.h>
-#include "driver/gpio.h"
-#include "driver/uart.h"
 #include "base/constants.h"
 #include "base/codes.h"
 #include "base/types.h"
 #include "base/events.h"
+#include "transport.h"
 
 #ifdef __cplusplus
 extern "C"
 {
 #endif
 
+#ifndef CONFIG_IDF_TARGET_LINUX
     /**
      * @brief Install the Nextion driver and creates a Nextion context with the driver.
      * @note UART ISR handler will be attached to the same CPU core that this function is running on.
@@ -28,6 +28,16 @@ extern "C"
                                       uint32_t baud_rate,
                                       gpio_num_t tx_io_num,
                                       gpio_num_t rx_io_num);
+#endif
+
+    /**
+     * @brief Install the Nextion driver over a transport and creates a Nextion context with the driver.
+     * @note The driver takes ownership of \p transport and destroys it when deleted.
+     * @param[in] transport Transport connected to the display.
+     * @param[in] baud_rate Baud rate the transport was created with, between NEX_UART_BAUD_RATE_MIN and NEX_UART_BAUD_RATE_MAX.
+     * @return Pointer to a Nextion context or NULL.
+     */
+    nextion_t *nextion_driver_install_transport(nextion_transport_t *transport, uint32_t baud_rate);
 
     /**
      * @brief Initialize a Nextion context.
@@ -38,6 +48,19 @@ extern "C"
      */
     nex_err_t nextion_init(nextion_t *handle);
 
+    /**
+     * @brief Initialize a Nextion context, finding the baud rate the display uses.
+     * @details Every "nextion_baud_rate_t" is tried, starting with the one the
+     * driver was installed with. The display is then moved to the highest rate,
+     * up to \p max_baud_rate, that it answers correctly on; the change is not persisted.
+     * @warning Must be called before doing any operation, instead of "nextion_init".
+     * @note Will turn the display on.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] max_baud_rate Highest baud rate to move to.
+     * @return NEX_OK if success, otherwise NEX_FAIL.
+     */
+    nex_err_t nextion_init_auto_baud(nextion_t *handle, nextion_baud_rate_t max_baud_rate);
+
     /**
      * @brief Delete a Nextion driver and context.
      * @note It will call "nextion_free".
@@ -0,0 +1,330 @@
+#ifndef __ESP32_DRIVER_NEXTION_HPP__
+#define __ESP32_DRIVER_NEXTION_HPP__
+
+#if __cplusplus < 202002L
+#error "esp32_driver_nextion/nextion.hpp requires C++20"
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "base/codes.h"
+#include "base/types.h"
+#include "instruction.h"
+
+/**
+ * @brief Header-only C++ layer.
+ * @details Instructions are joined at compile time from component and property
+ * names, and the response expected is chosen by the value type; at runtime only
+ * the value is written.
+ */
+namespace nextion
+{
+    /**
+     * @brief A string usable as a template argument.
+     * @tparam N Length, including the null terminator.
+     */
+    template <std::size_t N>
+    struct fixed_string
+    {
+        char text[N] = {}; /** @brief Null-terminated text. */
+
+        constexpr fixed_string() = default;
+
+        constexpr fixed_string(const char (&value)[N])
+        {
+            for (std::size_t i = 0; i < N; i++)
+            {
+                text[i] = value[i];
+            }
+        }
+
+        /**
+         * @brief Get the text length, without the null terminator.
+         */
+        static constexpr std::size_t length()
+        {
+            return N - 1;
+        }
+    };
+
+    /**
+     * @brief Join two fixed strings.
+     */
+    template <std::size_t A, std::size_t B>
+    constexpr fixed_string<A + B - 1> operator+(const fixed_string<A> &left, const fixed_string<B> &right)
+    {
+        fixed_string<A + B - 1> joined;
+
+        for (std::size_t i = 0; i < A - 1; i++)
+        {
+            joined.text[i] = left.text[i];
+        }
+
+        for (std::size_t i = 0; i < B; i++)
+        {
+            joined.text[A - 1 + i] = right.text[i];
+        }
+
+        return joined;
+    }
+
+    /**
+     * @brief Value returned by the device, with the result code.
+     * @tparam T Value type.
+     */
+    template <typename T>
+    struct result
+    {
+        nex_err_t code; /** @brief NEX_OK or NEX_FAIL | NEX_DVC_ERR_*. */
+        T value;        /** @brief Value returned. Only valid on NEX_OK. */
+
+        constexpr bool ok() const
+        {
+            return code == NEX_OK;
+        }
+
+        constexpr explicit operator bool() const
+        {
+            return ok();
+        }
+    };
+
+    /**
+     * @brief Text with a capacity known at compile time.
+     * @tparam Capacity Capacity, including the null terminator.
+     */
+    template <std::size_t Capacity>
+    struct text
+    {
+        char data[Capacity] = {}; /** @brief Null-terminated text. */
+
+        const char *c_str() const
+        {
+            return data;
+        }
+    };
+
+    namespace detail
+    {
+        // Longest int32_t in decimal: "-2147483648".
+        inline constexpr std::size_t NUMBER_MAX_LENGTH = 11;
+
+        /**
+         * @brief Write a number in decimal.
+         * @return Number of characters written.
+         */
+        inline std::size_t write_number(char *destination, int32_t number)
+        {
+            char digits[NUMBER_MAX_LENGTH];
+            char *position = digits + sizeof(digits);
+
+            // Negating INT32_MIN overflows; do it as unsigned.
+            uint32_t value = number < 0 ? 0U - (uint32_t)number : (uint32_t)number;
+
+            do
+            {
+                *--position = (char)('0' + (value % 10));
+                value /= 10;
+            } while (value > 0);
+
+            if (number < 0)
+            {
+                *--position = '-';
+            }
+
+            const std::size_t length = (std::size_t)(digits + sizeof(digits) - position);
+
+            std::memcpy(destination, position, length);
+
+            return length;
+        }
+
+        /**
+         * @brief How a value type is read and written.
+         * @details Picks, at compile time, the response the device returns.
+         */
+        template <typename T>
+        struct value_traits;
+
+        template <>
+        struct value_traits<int32_t>
+        {
+            using input_type = int32_t;
+
+            static nex_err_t get(nextion_t *handle, const char *instruction, std::size_t length, int32_t &value)
+            {
+                return nextion_instruction_send_get_number(handle, instruction, length, &value);
+            }
+
+            template <fixed_string Prefix>
+            static nex_err_t set(nextion_t *handle, int32_t value)
+            {
+                char instruction[Prefix.length() + NUMBER_MAX_LENGTH];
+
+                std::memcpy(instruction, Prefix.text, Prefix.length());
+
+                const std::size_t length = Prefix.length() + write_number(instruction + Prefix.length(), value);
+
+                return nextion_instruction_send(handle, instruction, length);
+            }
+        };
+
+        template <>
+        struct value_traits<bool>
+        {
+            using input_type = bool;
+
+            static nex_err_t get(nextion_t *handle, const char *instruction, std::size_t length, bool &value)
+            {
+                int32_t number = 0;
+                nex_err_t code = nextion_instruction_send_get_number(handle, instruction, length, &number);
+
+                value = number != 0;
+
+                return code;
+            }
+
+            template <fixed_string Prefix>
+            static nex_err_t set(nextion_t *handle, bool value)
+            {
+                char instruction[Prefix.length() + 1];
+
+                std::memcpy(instruction, Prefix.text, Prefix.length());
+
+                instruction[Prefix.length()] = value ? '1' : '0';
+
+                return nextion_instruction_send(handle, instruction, sizeof(instruction));
+            }
+        };
+
+        template <std::size_t Capacity>
+        struct value_traits<text<Capacity>>
+        {
+            using input_type = const char *;
+
+            static nex_err_t get(nextion_t *handle, const char *instruction, std::size_t length, text<Capacity> &value)
+            {
+                return nextion_instruction_send_get_text(handle, instruction, length, value.data, Capacity);
+            }
+
+            template <fixed_string Prefix>
+            static nex_err_t set(nextion_t *handle, const char *value)
+            {
+                if (value == nullptr)
+                {
+                    return NEX_FAIL;
+                }
+
+                const std::size_t value_length = std::strlen(value);
+
+                // Same bound as reading, so what is written can be read back.
+                if (value_length >= Capacity)
+                {
+                    return NEX_FAIL;
+                }
+
+                char instruction[Prefix.length() + Capacity + 2];
+
+                std::memcpy(instruction, Prefix.text, Prefix.length());
+
+                instruction[Prefix.length()] = '"';
+
+                std::memcpy(instruction + Prefix.length() + 1, value, value_length);
+
+                instruction[Prefix.length() + 1 + value_length] = '"';
+
+                return nextion_instruction_send(handle, instruction, Prefix.length() + value_length + 2);
+            }
+        };
+    }
+
+    /**
+     * @brief Send an instruction known at compile time, that returns only success or failure.
+     * @tparam Instruction Instruction, e.g. "page 0".
+     * @param[in] handle Nextion context pointer.
+     * @return NEX_OK or NEX_FAIL | NEX_DVC_ERR_*.
+     */
+    template <fixed_string Instruction>
+    nex_err_t send(nextion_t *handle)
+    {
+        return nextion_instruction_send(handle, Instruction.text, Instruction.length());
+    }
+
+    /**
+     * @brief Send an instruction known at compile time, that returns a value.
+     * @tparam T Value type: int32_t, bool or text.
+     * @tparam Instruction Instruction, e.g. "get n0.val".
+     * @param[in] handle Nextion context pointer.
+     * @return Value and result code.
+     */
+    template <typename T, fixed_string Instruction>
+    result<T> get(nextion_t *handle)
+    {
+        result<T> returned = {};
+
+        returned.code = detail::value_traits<T>::get(handle, Instruction.text, Instruction.length(), returned.value);
+
+        return returned;
+    }
+
+    /**
+     * @brief A component property, with its instructions built at compile time.
+     * @tparam Component Component name.
+     * @tparam Property Property name.
+     * @tparam T Value type: int32_t, bool or text.
+     */
+    template <fixed_string Component, fixed_string Property, typename T>
+    struct property
+    {
+        /** @brief Property reference: "component.property". */
+        static constexpr auto path = Component + fixed_string(".") + Property;
+
+        /** @brief Instruction prefix to set the value: "component.property=". */
+        static constexpr auto assignment = path + fixed_string("=");
+
+        /** @brief Instruction to get the value: "get component.property". */
+        static constexpr auto query = fixed_string("get ") + path;
+
+        /**
+         * @brief Get the value.
+         * @param[in] handle Nextion context pointer.
+         * @return Value and NEX_OK or NEX_FAIL | NEX_DVC_ERR_*.
+         */
+        static result<T> get(nextion_t *handle)
+        {
+            return nextion::get<T, query>(handle);
+        }
+
+        /**
+         * @brief Set the value.
+         * @param[in] handle Nextion context pointer.
+         * @param[in] value Value to set. Texts must fit the text capacity.
+         * @return NEX_OK or NEX_FAIL | NEX_DVC_ERR_*.
+         */
+        static nex_err_t set(nextion_t *handle, typename detail::value_traits<T>::input_type value)
+        {
+            return detail::value_traits<T>::template set<assignment>(handle, value);
+        }
+    };
+
+    /**
+     * @brief The "val" property of a component, as a number.
+     */
+    template <fixed_string Component>
+    using component_value = property<Component, "val", int32_t>;
+
+    /**
+     * @brief The "val" property of a component, as a boolean.
+     */
+    template <fixed_string Component>
+    using component_boolean = property<Component, "val", bool>;
+
+    /**
+     * @brief The "txt" property of a component.
+     * @tparam Capacity Text capacity, including the null terminator.
+     */
+    template <fixed_string Component, std::size_t Capacity>
+    using component_text = property<Component, "txt", text<Capacity>>;
+}
+#endif
@@ -0,0 +1,91 @@
+#ifndef __ESP32_DRIVER_NEXTION_PROPERTY_H__
+#define __ESP32_DRIVER_NEXTION_PROPERTY_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include "base/codes.h"
+#include "base/types.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Maximum length of a property reference: "component.property".
+ */
+#define NEXTION_PROPERTY_PATH_MAX_LENGTH 32U
+
+/**
+ * @brief Length of the "get " instruction prefix.
+ */
+#define NEXTION_PROPERTY_QUERY_PREFIX_LENGTH 4U
+
+    /**
+     * @typedef nextion_property_t
+     * @brief A component property with its instructions encoded once.
+     * @details Holds "get component.property=": the query is the text
+     * without the trailing '=', and the assignment prefix is the text after "get ".
+     */
+    typedef struct
+    {
+        nextion_t *handle;                                   /** @brief Nextion context pointer. */
+        char instruction[NEXTION_PROPERTY_QUERY_PREFIX_LENGTH
+                         + NEXTION_PROPERTY_PATH_MAX_LENGTH
+                         + 2];                               /** @brief Encoded instructions, null-terminated. */
+        uint8_t path_length;                                 /** @brief Length of "component.property". */
+        uint32_t read_ttl_ms;                                /** @brief For how long gets may return the value from the shadow cache. */
+    } nextion_property_t;
+
+    /**
+     * @brief Prepare a component property, so its instructions are encoded only once.
+     * @details "read_ttl_ms" starts as CONFIG_NEX_SHADOW_CACHE_READ_TTL_MS, and can be
+     * changed afterwards for this property only.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] component_name A null-terminated string with the component's name.
+     * @param[in] property_name A null-terminated string with the property's name.
+     * @param[out] property Location where the prepared property will be written.
+     * @return NEX_OK or NEX_FAIL.
+     */
+    nex_err_t nextion_property_prepare(nextion_t *handle,
+                                       const char *component_name,
+                                       const char *property_name,
+                                       nextion_property_t *property);
+
+    /**
+     * @brief Get a prepared property number.
+     * @param[in] property Prepared property.
+     * @param[out] number Location where the retrieved number will be stored.
+     * @return NEX_OK or NEX_FAIL | NEX_DVC_ERR_INVALID_VARIABLE_OR_ATTRIBUTE.
+     */
+    nex_err_t nextion_property_get_number(const nextion_property_t *property, int32_t *number);
+
+    /**
+     * @brief Get a prepared property text.
+     * @param[in] property Prepared property.
+     * @param[out] buffer Location where the retrieved text will be stored.
+     * @param[in] buffer_length Buffer length.
+     * @return NEX_OK or NEX_FAIL | NEX_DVC_ERR_INVALID_VARIABLE_OR_ATTRIBUTE.
+     */
+    nex_err_t nextion_property_get_text(const nextion_property_t *property, char *buffer, size_t buffer_length);
+
+    /**
+     * @brief Set a prepared property number.
+     * @param[in] property Prepared property.
+     * @param[in] number Number to set.
+     * @return NEX_OK or NEX_FAIL | NEX_DVC_ERR_INVALID_VARIABLE_OR_ATTRIBUTE.
+     */
+    nex_err_t nextion_property_set_number(const nextion_property_t *property, int32_t number);
+
+    /**
+     * @brief Set a prepared property text.
+     * @param[in] property Prepared property.
+     * @param[in] text A null-terminated string with the text to set.
+     * @return NEX_OK or NEX_FAIL | NEX_DVC_ERR_INVALID_VARIABLE_OR_ATTRIBUTE.
+     */
+    nex_err_t nextion_property_set_text(const nextion_property_t *property, const char *text);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
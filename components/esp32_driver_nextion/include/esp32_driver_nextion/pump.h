@@ -0,0 +1,88 @@
+#ifndef __ESP32_DRIVER_NEXTION_PUMP_H__
+#define __ESP32_DRIVER_NEXTION_PUMP_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "base/codes.h"
+#include "base/types.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @typedef nextion_pump_channel_t
+     * @brief Samples of a waveform channel waiting to be streamed.
+     */
+    typedef struct nextion_pump_channel_t nextion_pump_channel_t;
+
+    /**
+     * @brief Open a waveform channel for pushing samples.
+     * @details A driver task streams the samples pushed, once per period,
+     * using the Transparent Data Mode.
+     * @note Requires CONFIG_NEX_WAVEFORM_PUMP, otherwise always fails.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] waveform_id Waveform id.
+     * @param[in] channel_id Channel id.
+     * @return Channel pointer, or NULL if the channel is already open or no more can be open.
+     */
+    nextion_pump_channel_t *nextion_pump_open(nextion_t *handle, uint8_t waveform_id, uint8_t channel_id);
+
+    /**
+     * @brief Close a waveform channel, dropping the samples not streamed yet.
+     * @note Stop pushing samples before closing.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] channel Channel pointer.
+     * @return NEX_OK or NEX_FAIL.
+     */
+    nex_err_t nextion_pump_close(nextion_t *handle, nextion_pump_channel_t *channel);
+
+    /**
+     * @brief Push a sample; never waits.
+     * @note Safe to call from an interrupt. Only one task or interrupt can push onto a channel.
+     * @param[in] channel Channel pointer; not checked.
+     * @param[in] value Sample to push.
+     * @return True if pushed, or false if the channel is full and the sample was dropped.
+     */
+    bool nextion_pump_push(nextion_pump_channel_t *channel, uint8_t value);
+
+    /**
+     * @brief Push many samples; never waits.
+     * @note Safe to call from an interrupt. Only one task or interrupt can push onto a channel.
+     * @param[in] channel Channel pointer; not checked.
+     * @param[in] values Samples to push.
+     * @param[in] value_count Number of samples.
+     * @return How many samples were pushed; the others were dropped.
+     */
+    size_t nextion_pump_push_buffer(nextion_pump_channel_t *channel, const uint8_t *values, size_t value_count);
+
+    /**
+     * @brief Get how many samples were dropped, as the channel was full, since it was open.
+     * @param[in] channel Channel pointer.
+     * @return Number of samples dropped.
+     */
+    size_t nextion_pump_get_dropped(const nextion_pump_channel_t *channel);
+
+    /**
+     * @brief Stream all samples waiting now, without waiting for the next period.
+     * @note Requires CONFIG_NEX_WAVEFORM_PUMP, otherwise always fails.
+     * @param[in] handle Nextion context pointer.
+     * @return NEX_OK or NEX_FAIL.
+     */
+    nex_err_t nextion_pump_flush(nextion_t *handle);
+
+    /**
+     * @brief Change the time between streams.
+     * @note Requires CONFIG_NEX_WAVEFORM_PUMP, otherwise always fails.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] period_ms Period, in milliseconds; at least a tick.
+     * @return NEX_OK or NEX_FAIL.
+     */
+    nex_err_t nextion_pump_set_period(nextion_t *handle, uint32_t period_ms);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
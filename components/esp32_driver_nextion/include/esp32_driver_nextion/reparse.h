@@ -0,0 +1,96 @@
+#ifndef __ESP32_DRIVER_NEXTION_REPARSE_H__
+#define __ESP32_DRIVER_NEXTION_REPARSE_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include "base/codes.h"
+#include "base/types.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Size, in bytes, of a frame: opcode, component id, value and checksum.
+ */
+#define NEXTION_REPARSE_FRAME_LENGTH 7U
+
+    /**
+     * @typedef nextion_reparse_opcode_t
+     * @brief What the device script does with a frame value.
+     */
+    typedef enum
+    {
+        NEXTION_REPARSE_OPCODE_SET_VALUE = 0x01U,      /** @brief Set the component ".val". */
+        NEXTION_REPARSE_OPCODE_SET_FOREGROUND = 0x02U, /** @brief Set the component ".pco". */
+        NEXTION_REPARSE_OPCODE_SET_BACKGROUND = 0x03U  /** @brief Set the component ".bco". */
+    } nextion_reparse_opcode_t;
+
+    /**
+     * @brief Enter the Protocol Reparse mode ("recmod=1").
+     * @details The device stops parsing instructions and keeps every byte received
+     * for a script to decode. Only frames and "nextion_reparse_end" can be sent meanwhile.
+     * @note The page must have the decoding script; see the reparse.h documentation.
+     * @param[in] handle Nextion context pointer.
+     * @return NEX_OK or NEX_FAIL.
+     */
+    nex_err_t nextion_reparse_begin(nextion_t *handle);
+
+    /**
+     * @brief Leave the Protocol Reparse mode.
+     * @details Frames received before are still decoded by the script.
+     * @param[in] handle Nextion context pointer.
+     * @return NEX_OK or NEX_FAIL.
+     */
+    nex_err_t nextion_reparse_end(nextion_t *handle);
+
+    /**
+     * @brief Encode a frame.
+     * @param[out] frame Location where the frame will be stored. Must have NEXTION_REPARSE_FRAME_LENGTH bytes.
+     * @param[in] opcode What to do with the value.
+     * @param[in] component_id Component id, on the current page.
+     * @param[in] value Value, sent as little-endian.
+     */
+    void nextion_reparse_encode(uint8_t *frame,
+                                nextion_reparse_opcode_t opcode,
+                                uint8_t component_id,
+                                int32_t value);
+
+    /**
+     * @brief Send a frame.
+     * @note The device returns nothing; a frame it cannot decode is dropped.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] opcode What to do with the value.
+     * @param[in] component_id Component id, on the current page.
+     * @param[in] value Value to send.
+     * @return NEX_OK or NEX_FAIL.
+     */
+    nex_err_t nextion_reparse_send(const nextion_t *handle,
+                                   nextion_reparse_opcode_t opcode,
+                                   uint8_t component_id,
+                                   int32_t value);
+
+    /**
+     * @brief Send frames already encoded, in a single write.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] frames Frames encoded with "nextion_reparse_encode", one after another.
+     * @param[in] frame_count Number of frames.
+     * @return NEX_OK or NEX_FAIL.
+     */
+    nex_err_t nextion_reparse_send_frames(const nextion_t *handle, const uint8_t *frames, size_t frame_count);
+
+    /**
+     * @brief Set a component ".val" value.
+     * @note Shorthand for "nextion_reparse_send" using NEXTION_REPARSE_OPCODE_SET_VALUE.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] component_id Component id, on the current page.
+     * @param[in] number Value to set.
+     * @return NEX_OK or NEX_FAIL.
+     */
+    nex_err_t nextion_reparse_set_value(const nextion_t *handle, uint8_t component_id, int32_t number);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
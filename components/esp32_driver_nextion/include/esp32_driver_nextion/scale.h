@@ -0,0 +1,138 @@
+#ifndef __ESP32_DRIVER_NEXTION_SCALE_H__
+#define __ESP32_DRIVER_NEXTION_SCALE_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include "base/codes.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Maximum number of batches an auto-range window spans.
+ */
+#define NEXTION_SCALE_AUTORANGE_MAX_BATCHES 16U
+
+    /**
+     * @typedef nextion_scale_t
+     * @brief How values are turned into waveform samples: (value - offset) * gain, rounded and clamped to 0-255.
+     */
+    typedef struct
+    {
+        float offset; /** @brief Value turned into 0. */
+        float gain;   /** @brief Sample units per value unit. */
+    } nextion_scale_t;
+
+    /**
+     * @typedef nextion_scale_autorange_t
+     * @brief Range of the values of the last batches, used to scale the next ones.
+     */
+    typedef struct
+    {
+        float mins[NEXTION_SCALE_AUTORANGE_MAX_BATCHES]; /** @brief Minimum of every batch on the window. */
+        float maxs[NEXTION_SCALE_AUTORANGE_MAX_BATCHES]; /** @brief Maximum of every batch on the window. */
+        size_t batch_count;                              /** @brief Batches the window spans. */
+        size_t head;                                     /** @brief Index where the next batch goes. */
+        size_t used;                                     /** @brief Batches on the window. */
+    } nextion_scale_autorange_t;
+
+    /**
+     * @brief Initialize a scale turning a range of values into 0-255.
+     * @param[out] scale Location where the scale will be written.
+     * @param[in] min Value turned into 0.
+     * @param[in] max Value turned into 255; greater than \p min.
+     * @return NEX_OK or NEX_FAIL.
+     */
+    nex_err_t nextion_scale_init(nextion_scale_t *scale, float min, float max);
+
+    /**
+     * @brief Turn 16 bits integers into waveform samples.
+     * @param[in] scale Scale.
+     * @param[in] values Values.
+     * @param[in] count Number of values.
+     * @param[out] output Location where the samples will be written; \p count bytes.
+     * @return NEX_OK or NEX_FAIL.
+     */
+    nex_err_t nextion_scale_int16(const nextion_scale_t *scale, const int16_t *values, size_t count, uint8_t *output);
+
+    /**
+     * @brief Turn 32 bits integers into waveform samples.
+     * @param[in] scale Scale.
+     * @param[in] values Values.
+     * @param[in] count Number of values.
+     * @param[out] output Location where the samples will be written; \p count bytes.
+     * @return NEX_OK or NEX_FAIL.
+     */
+    nex_err_t nextion_scale_int32(const nextion_scale_t *scale, const int32_t *values, size_t count, uint8_t *output);
+
+    /**
+     * @brief Turn floats into waveform samples.
+     * @note NaN is turned into 0.
+     * @param[in] scale Scale.
+     * @param[in] values Values.
+     * @param[in] count Number of values.
+     * @param[out] output Location where the samples will be written; \p count bytes.
+     * @return NEX_OK or NEX_FAIL.
+     */
+    nex_err_t nextion_scale_float(const nextion_scale_t *scale, const float *values, size_t count, uint8_t *output);
+
+    /**
+     * @brief Initialize an auto-range window.
+     * @param[out] autorange Location where the window will be written.
+     * @param[in] batch_count Batches the window spans; at most NEXTION_SCALE_AUTORANGE_MAX_BATCHES.
+     * @return NEX_OK or NEX_FAIL.
+     */
+    nex_err_t nextion_scale_autorange_init(nextion_scale_autorange_t *autorange, size_t batch_count);
+
+    /**
+     * @brief Turn 16 bits integers into waveform samples, using the range of this and the last batches.
+     * @param[in] autorange Auto-range window.
+     * @param[in] values Values.
+     * @param[in] count Number of values; at least one.
+     * @param[out] output Location where the samples will be written; \p count bytes.
+     * @param[out] scale Location where the scale used will be written. Can be NULL.
+     * @return NEX_OK or NEX_FAIL.
+     */
+    nex_err_t nextion_scale_autorange_int16(nextion_scale_autorange_t *autorange,
+                                            const int16_t *values,
+                                            size_t count,
+                                            uint8_t *output,
+                                            nextion_scale_t *scale);
+
+    /**
+     * @brief Turn 32 bits integers into waveform samples, using the range of this and the last batches.
+     * @param[in] autorange Auto-range window.
+     * @param[in] values Values.
+     * @param[in] count Number of values; at least one.
+     * @param[out] output Location where the samples will be written; \p count bytes.
+     * @param[out] scale Location where the scale used will be written. Can be NULL.
+     * @return NEX_OK or NEX_FAIL.
+     */
+    nex_err_t nextion_scale_autorange_int32(nextion_scale_autorange_t *autorange,
+                                            const int32_t *values,
+                                            size_t count,
+                                            uint8_t *output,
+                                            nextion_scale_t *scale);
+
+    /**
+     * @brief Turn floats into waveform samples, using the range of this and the last batches.
+     * @note NaN is ignored for the range, and turned into 0.
+     * @param[in] autorange Auto-range window.
+     * @param[in] values Values.
+     * @param[in] count Number of values; at least one.
+     * @param[out] output Location where the samples will be written; \p count bytes.
+     * @param[out] scale Location where the scale used will be written. Can be NULL.
+     * @return NEX_OK or NEX_FAIL.
+     */
+    nex_err_t nextion_scale_autorange_float(nextion_scale_autorange_t *autorange,
+                                            const float *values,
+                                            size_t count,
+                                            uint8_t *output,
+                                            nextion_scale_t *scale);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,55 @@
+#ifndef __ESP32_DRIVER_NEXTION_SHADOW_H__
+#define __ESP32_DRIVER_NEXTION_SHADOW_H__
+
+#include <stdint.h>
+#include "base/codes.h"
+#include "base/types.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @typedef nextion_shadow_stats_t
+     * @brief Shadow cache counters.
+     */
+    typedef struct
+    {
+        uint32_t read_hits;      /** @brief Gets returned from the cache. */
+        uint32_t read_misses;    /** @brief Gets that could use the cache, but had to ask the device. */
+        uint32_t writes_skipped; /** @brief Sets not sent, as the device already had the value. */
+        uint32_t evictions;      /** @brief Values forgotten to make room for others. */
+    } nextion_shadow_stats_t;
+
+    /**
+     * @brief Forget all component property values remembered.
+     * @details Call it after changing properties by other means than
+     * the component and property functions, like raw instructions or HMI code.
+     * @note Requires CONFIG_NEX_SHADOW_CACHE, otherwise always fails.
+     * @param[in] handle Nextion context pointer.
+     * @return NEX_OK or NEX_FAIL.
+     */
+    nex_err_t nextion_shadow_clear(nextion_t *handle);
+
+    /**
+     * @brief Get the shadow cache counters.
+     * @note Requires CONFIG_NEX_SHADOW_CACHE, otherwise always fails.
+     * @param[in] handle Nextion context pointer.
+     * @param[out] stats Location where the counters will be copied.
+     * @return NEX_OK or NEX_FAIL.
+     */
+    nex_err_t nextion_shadow_get_stats(nextion_t *handle, nextion_shadow_stats_t *stats);
+
+    /**
+     * @brief Zero the shadow cache counters.
+     * @note Requires CONFIG_NEX_SHADOW_CACHE, otherwise always fails.
+     * @param[in] handle Nextion context pointer.
+     * @return NEX_OK or NEX_FAIL.
+     */
+    nex_err_t nextion_shadow_reset_stats(nextion_t *handle);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,110 @@
+#ifndef __ESP32_DRIVER_NEXTION_STATS_H__
+#define __ESP32_DRIVER_NEXTION_STATS_H__
+
+#include <stdint.h>
+#include "base/codes.h"
+#include "base/types.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @brief Number of histogram buckets.
+     * @details Bucket 0 counts durations below 1us; bucket "n" counts durations
+     * from 2^(n-1)us up to 2^n us. The last one also counts everything above.
+     */
+#define NEXTION_STATS_BUCKET_COUNT 20
+
+    /**
+     * @typedef nextion_stats_class_t
+     * @brief Instruction class, by the response it expects.
+     */
+    typedef enum
+    {
+        NEXTION_STATS_CLASS_ACK = 0,        /** @brief Returns success or failure. Includes instructions without response. */
+        NEXTION_STATS_CLASS_GET_TEXT = 1,   /** @brief Returns a text. */
+        NEXTION_STATS_CLASS_GET_NUMBER = 2, /** @brief Returns a number, including "sendme". */
+        NEXTION_STATS_CLASS_TDM_START = 3,  /** @brief Starts the Transparent Data Mode. */
+        NEXTION_STATS_CLASS_RAW = 4,        /** @brief Returns raw bytes ("rept") or is a raw byte. */
+        NEXTION_STATS_CLASS_MAX = 5         /** @brief Number of classes. */
+    } nextion_stats_class_t;
+
+    /**
+     * @typedef nextion_stats_phase_t
+     * @brief Phase of an instruction.
+     */
+    typedef enum
+    {
+        NEXTION_STATS_PHASE_LOCK = 0,     /** @brief Waiting for other instructions to release the UART. */
+        NEXTION_STATS_PHASE_DRAIN = 1,    /** @brief Waiting previous responses and processing events. */
+        NEXTION_STATS_PHASE_TRANSMIT = 2, /** @brief Writing the instruction and waiting its transmission. */
+        NEXTION_STATS_PHASE_RESPONSE = 3, /** @brief Waiting and parsing the response. */
+        NEXTION_STATS_PHASE_TOTAL = 4,    /** @brief All the above. */
+        NEXTION_STATS_PHASE_MAX = 5       /** @brief Number of phases. */
+    } nextion_stats_phase_t;
+
+    /**
+     * @typedef nextion_stats_histogram_t
+     * @brief Durations of a phase.
+     */
+    typedef struct
+    {
+        uint32_t count;                                /** @brief Number of durations recorded. */
+        uint64_t total_us;                             /** @brief Sum of durations, in microseconds. */
+        uint32_t max_us;                               /** @brief Longest duration, in microseconds. */
+        uint32_t buckets[NEXTION_STATS_BUCKET_COUNT]; /** @brief Durations per power of two microseconds. */
+    } nextion_stats_histogram_t;
+
+    /**
+     * @typedef nextion_stats_instruction_t
+     * @brief Statistics of an instruction class.
+     */
+    typedef struct
+    {
+        uint32_t count;                                            /** @brief Instructions sent. */
+        uint32_t failures;                                         /** @brief Instructions that failed or timed out. */
+        uint32_t contentions;                                      /** @brief Instructions that found the UART locked. */
+        nextion_stats_histogram_t phases[NEXTION_STATS_PHASE_MAX]; /** @brief Durations per phase. */
+    } nextion_stats_instruction_t;
+
+    /**
+     * @typedef nextion_stats_t
+     * @brief Instruction statistics.
+     */
+    typedef struct
+    {
+        nextion_stats_instruction_t classes[NEXTION_STATS_CLASS_MAX]; /** @brief Statistics per instruction class. */
+    } nextion_stats_t;
+
+    /**
+     * @brief Get a copy of the instruction statistics.
+     * @details Only synchronous instructions and raw bytes are measured.
+     * @note Requires CONFIG_NEX_STATS, otherwise always fails.
+     * @param[in] handle Nextion context pointer.
+     * @param[out] stats Location where the statistics will be copied. Big; avoid the stack.
+     * @return NEX_OK or NEX_FAIL.
+     */
+    nex_err_t nextion_stats_get(nextion_t *handle, nextion_stats_t *stats);
+
+    /**
+     * @brief Clear the instruction statistics.
+     * @note Requires CONFIG_NEX_STATS, otherwise always fails.
+     * @param[in] handle Nextion context pointer.
+     * @return NEX_OK or NEX_FAIL.
+     */
+    nex_err_t nextion_stats_reset(nextion_t *handle);
+
+    /**
+     * @brief Estimate a percentile of a histogram.
+     * @param[in] histogram Histogram.
+     * @param[in] percentile Percentile, from 0 to 100.
+     * @return Upper bound, in microseconds, of the bucket the percentile falls in. Zero when empty.
+     */
+    uint32_t nextion_stats_percentile(const nextion_stats_histogram_t *histogram, uint8_t percentile);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -11,6 +11,21 @@ extern "C"
 {
 #endif
 
+    /**
+     * @typedef nextion_failure_callback_t
+     * @brief Function called when an instruction that was not waited on fails.
+     * @warning Called with the UART locked, from the task that received the
+     * failure; must be short and must not call any driver function.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] code NEX_FAIL or any NEX_DVC_ERR_* value.
+     * @param[in] instruction A null-terminated string with the beginning of the failed instruction.
+     * @param[in] context User context passed when the callback was set.
+     */
+    typedef void (*nextion_failure_callback_t)(nextion_t *handle,
+                                               nex_err_t code,
+                                               const char *instruction,
+                                               void *context);
+
     /**
      * @brief Reset the display, losing all volatile configuration.
      * @param[in] handle Nextion context pointer.
@@ -43,6 +58,27 @@ extern "C"
                                             bool persisted,
                                             uint8_t *percentage);
 
+    /**
+     * @brief Get the baud rate the display is using.
+     * @param[in] handle Nextion context pointer.
+     * @param[out] baud_rate Location where the baud rate will be written.
+     * @return NEX_OK or NEX_FAIL.
+     */
+    nex_err_t nextion_system_get_baud_rate(nextion_t *handle, uint32_t *baud_rate);
+
+    /**
+     * @brief Change the baud rate used by the display and the UART.
+     * @details The UART switches once the instruction is transmitted;
+     * the new rate is then checked by reading it back from the display.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] baud_rate New baud rate.
+     * @param[in] persist If the value must persist between resets.
+     * @return NEX_OK or NEX_FAIL.
+     */
+    nex_err_t nextion_system_set_baud_rate(nextion_t *handle,
+                                           nextion_baud_rate_t baud_rate,
+                                           bool persist);
+
     /**
      * @brief Set the display brightness.
      * @param[in] handle Nextion context pointer.
@@ -115,6 +151,28 @@ extern "C"
      */
     nex_err_t nextion_system_set_send_xy(nextion_t *handle, bool send_xy);
 
+    /**
+     * @brief Set which instruction results the device returns ("bkcmd").
+     * @details Instructions that only return success or failure are not
+     * waited on when their success is not returned:
+     *   - NEXTION_RESPONSE_NONE: they return NEX_OK as soon as they are written.
+     *   - NEXTION_RESPONSE_FAILURE: same, and failures arriving later are sent to \p on_failure.
+     *   - NEXTION_RESPONSE_SUCCESS: no response within the wait time means failure.
+     *   - NEXTION_RESPONSE_ALL: all are waited on.
+     * @warning A late failure is matched to the oldest instruction sent less than
+     * CONFIG_NEX_UART_FAILURE_WAIT_TIME_MS before; with several in flight it may be the wrong one.
+     * @note Not persisted through resets. The driver assumes NEXTION_RESPONSE_ALL until set.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] mode Response mode.
+     * @param[in] on_failure Function called on late failures. Can be NULL.
+     * @param[in] context User context passed to the callback.
+     * @return NEX_OK or NEX_FAIL | NEX_DVC_ERR_*. The mode is kept on failure.
+     */
+    nex_err_t nextion_system_set_response_mode(nextion_t *handle,
+                                               nextion_response_mode_t mode,
+                                               nextion_failure_callback_t on_failure,
+                                               void *context);
+
     /**
      * @brief Get a text from a variable.
      * @note It's the caller responsibility to allocate a buffer big enough to
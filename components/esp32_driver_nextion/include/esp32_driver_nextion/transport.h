@@ -0,0 +1,120 @@
+#ifndef __ESP32_DRIVER_NEXTION_TRANSPORT_H__
+#define __ESP32_DRIVER_NEXTION_TRANSPORT_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "sdkconfig.h"
+#include "freertos/FreeRTOS.h"
+#ifndef CONFIG_IDF_TARGET_LINUX
+#include "driver/gpio.h"
+#include "driver/uart.h"
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @typedef nextion_transport_event_t
+     * @brief What woke a transport waiting for events.
+     */
+    typedef enum
+    {
+        NEXTION_TRANSPORT_EVENT_TIMEOUT = 0U,  /** @brief Nothing happened until the timeout. */
+        NEXTION_TRANSPORT_EVENT_DATA = 1U,     /** @brief Data was received. */
+        NEXTION_TRANSPORT_EVENT_OVERFLOW = 2U, /** @brief Received data was lost. */
+        NEXTION_TRANSPORT_EVENT_WAKE = 3U      /** @brief Woken by "wake" or by an event of no interest. */
+    } nextion_transport_event_t;
+
+    /**
+     * @typedef nextion_transport_t
+     * @brief Byte stream connecting the driver to a display.
+     * @details Embed it as the first member of a backend structure;
+     * the driver only calls the functions below.
+     */
+    typedef struct nextion_transport_t nextion_transport_t;
+
+    struct nextion_transport_t
+    {
+        /**
+         * @brief Queue bytes to be transmitted.
+         * @return Number of bytes queued or -1 on error.
+         */
+        int (*write)(nextion_transport_t *transport, const uint8_t *data, size_t length);
+
+        /**
+         * @brief Read \p length bytes, waiting up to \p timeout for all of them, like "uart_read_bytes".
+         * @details Returning once some bytes arrived is not enough: responses are read whole with a single call.
+         * @return Number of bytes read, fewer than \p length on timeout, or -1 on error.
+         */
+        int (*read)(nextion_transport_t *transport, uint8_t *buffer, size_t length, TickType_t timeout);
+
+        /**
+         * @brief Get how many received bytes can be read without waiting.
+         * @param[in] complete_frames_only If nothing must be counted until a frame end is detected.
+         * Backends that cannot detect frame ends count every byte.
+         */
+        size_t (*buffered_length)(nextion_transport_t *transport, bool complete_frames_only);
+
+        /**
+         * @brief Discard every received byte.
+         */
+        void (*flush_input)(nextion_transport_t *transport);
+
+        /**
+         * @brief Wait until every byte queued was transmitted.
+         * @return True if transmitted, otherwise false.
+         */
+        bool (*wait_tx_done)(nextion_transport_t *transport, TickType_t timeout);
+
+        /**
+         * @brief Change the baud rate.
+         * @return True if changed or meaningless for the backend, otherwise false.
+         */
+        bool (*set_baud_rate)(nextion_transport_t *transport, uint32_t baud_rate);
+
+        /**
+         * @brief Wait until data is received, data is lost or "wake" is called.
+         */
+        nextion_transport_event_t (*wait_event)(nextion_transport_t *transport, TickType_t timeout);
+
+        /**
+         * @brief Make a "wait_event" in progress, or the next one, return.
+         */
+        void (*wake)(nextion_transport_t *transport);
+
+        /**
+         * @brief Release the transport and everything it owns.
+         */
+        void (*destroy)(nextion_transport_t *transport);
+    };
+
+#ifndef CONFIG_IDF_TARGET_LINUX
+    /**
+     * @brief Create a transport over an ESP32 UART, installing the UART driver.
+     * @param[in] uart_num UART port number; any uart_port_t value.
+     * @param[in] baud_rate UART baud rate, between NEX_UART_BAUD_RATE_MIN and NEX_UART_BAUD_RATE_MAX.
+     * @param[in] tx_io_num UART TX pin GPIO number.
+     * @param[in] rx_io_num UART RX pin GPIO number.
+     * @return Pointer to a transport or NULL.
+     */
+    nextion_transport_t *nextion_transport_uart_create(uart_port_t uart_num,
+                                                       uint32_t baud_rate,
+                                                       gpio_num_t tx_io_num,
+                                                       gpio_num_t rx_io_num);
+#else
+    /**
+     * @brief Create a transport over a POSIX file descriptor: a tty, a pty or a socket.
+     * @note The transport takes ownership of \p fd and closes it when destroyed.
+     * @param[in] fd Open file descriptor, readable and writable.
+     * @return Pointer to a transport or NULL.
+     */
+    nextion_transport_t *nextion_transport_posix_create(int fd);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+#endif
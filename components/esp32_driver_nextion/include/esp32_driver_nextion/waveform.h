@@ -74,11 +74,38 @@ extern "C"
 
     /**
      * @brief Write a value onto the waveform stream.
+     * @note Prefer "nextion_waveform_stream_write_buffer": every call waits for the value to be transmitted.
      * @param[in] handle Nextion context pointer.
      * @param[in] value Value to be written.
-     * @return NEX_OK if success, otherwise NEX_FAIL.
+     * @return NEX_OK if success, otherwise NEX_FAIL | NEX_TIMEOUT.
      */
-    nex_err_t nextion_waveform_stream_write(const nextion_t *handle, uint8_t value);
+    nex_err_t nextion_waveform_stream_write(nextion_t *handle, uint8_t value);
+
+    /**
+     * @brief Write many values onto the waveform stream, in a single write.
+     * @details When the values complete the count given on begin, waits for the device to finish the stream.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] values Values to be written.
+     * @param[in] value_count Number of values; at most what is left of the count given on begin.
+     * @return NEX_OK if success, otherwise NEX_FAIL | NEX_TIMEOUT.
+     */
+    nex_err_t nextion_waveform_stream_write_buffer(nextion_t *handle, const uint8_t *values, size_t value_count);
+
+    /**
+     * @brief Stream interleaved samples onto many channels, so they advance together.
+     * @details The channels are streamed back to back, and no other instruction is sent in between.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] waveform_id Waveform id.
+     * @param[in] channel_count Number of channels, from channel 0; at most NEX_DVC_WAVEFORM_MAX_CHANNELS.
+     * @param[in] frames Frames of one sample per channel, in channel order; \p frame_count * \p channel_count bytes.
+     * @param[in] frame_count Number of frames; less than NEX_DVC_TRANSPARENT_DATA_MAX_DATA_SIZE - 20.
+     * @return NEX_OK or NEX_FAIL | NEX_TIMEOUT.
+     */
+    nex_err_t nextion_waveform_stream_channels(nextion_t *handle,
+                                               uint8_t waveform_id,
+                                               uint8_t channel_count,
+                                               const uint8_t *frames,
+                                               size_t frame_count);
 
 #ifdef __cplusplus
 }
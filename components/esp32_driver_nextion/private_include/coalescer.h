@@ -0,0 +1,83 @@
+#ifndef __ESP32_DRIVER_NEXTION_COALESCER_H__
+#define __ESP32_DRIVER_NEXTION_COALESCER_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp32_driver_nextion/base/codes.h"
+#include "esp32_driver_nextion/base/types.h"
+#include "esp32_driver_nextion/batch.h"
+#include "esp32_driver_nextion/property.h"
+#include "config.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#ifdef CONFIG_NEX_COALESCE
+    /**
+     * @typedef coalesce_entry_t
+     * @brief Last value written to a component property during the current frame.
+     */
+    typedef struct
+    {
+        int32_t number;                              /*!< Number written; unused for texts. */
+        uint8_t component_length;                    /*!< Length of the component name in the path. */
+        uint8_t path_length;                         /*!< Property reference length. */
+        uint8_t text_length;                         /*!< Text length; unused for numbers. */
+        bool is_text;                                /*!< If the value is a text. */
+        char path[NEXTION_PROPERTY_PATH_MAX_LENGTH]; /*!< Property reference: "component.property". */
+        char text[CONFIG_NEX_COALESCE_TEXT_LENGTH];  /*!< Text written, not null-terminated; unused for numbers. */
+    } coalesce_entry_t;
+
+    /**
+     * @typedef coalescer_t
+     * @brief Component property writes waiting for the next frame.
+     */
+    typedef struct
+    {
+        portMUX_TYPE lock;                                  /*!< Guards the entries; writers and the flusher run on different tasks. */
+        SemaphoreHandle_t flush_sync;                       /*!< Keeps flushes in order, so newer values are never sent first. */
+        TaskHandle_t task;                                  /*!< Task that flushes once per frame. */
+        nextion_batch_t *batch;                             /*!< Batch the values are sent on; reused every frame. */
+        uint32_t period_ms;                                 /*!< Frame period, in milliseconds. */
+        size_t head;                                        /*!< Index of the oldest entry waiting. */
+        size_t count;                                       /*!< Number of entries used, including the ones already taken before "head". */
+        coalesce_entry_t entries[CONFIG_NEX_COALESCE_SIZE]; /*!< Entries, in the order they were first written. */
+    } coalescer_t;
+
+    /**
+     * @brief Initialize a coalescer and start its flusher task.
+     * @param[in] coalescer Coalescer.
+     * @param[in] handle Nextion context pointer the values are sent to.
+     * @return True if started, otherwise false.
+     */
+    bool nextion_coalesce_init(coalescer_t *coalescer, nextion_t *handle);
+
+    /**
+     * @brief Stop the flusher task of a coalescer, dropping any value waiting.
+     * @param[in] coalescer Coalescer.
+     */
+    void nextion_coalesce_deinit(coalescer_t *coalescer);
+
+    /**
+     * @brief Send all values waiting.
+     * @param[in] handle Nextion context pointer.
+     * @return NEX_OK or NEX_FAIL.
+     */
+    nex_err_t nextion_coalesce_flush_pending(nextion_t *handle);
+
+#define COALESCE_FLUSH(handle) nextion_coalesce_flush_pending(handle)
+#else
+// Coalescing disabled: nothing waits.
+#define COALESCE_FLUSH(handle)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -36,6 +36,20 @@ extern "C"
 #define CONFIG_NEX_UART_RECV_BUFFER_SIZE 256
 #endif
 
+#ifndef CONFIG_NEX_UART_TRANS_BUFFER_SIZE
+/**
+ * @brief UART transmitter buffer size (bytes).
+ */
+#define CONFIG_NEX_UART_TRANS_BUFFER_SIZE 256
+#endif
+
+#ifndef CONFIG_NEX_UART_RECV_FRAME_BUFFER_SIZE
+/**
+ * @brief UART frame assembly buffer size (bytes).
+ */
+#define CONFIG_NEX_UART_RECV_FRAME_BUFFER_SIZE 128
+#endif
+
 #ifndef CONFIG_NEX_UART_TRANS_COMMAND_FORMAT_BUFFER_SIZE
 /**
  * @brief UART command format buffer size (bytes).
@@ -43,6 +57,90 @@ extern "C"
 #define CONFIG_NEX_UART_TRANS_COMMAND_FORMAT_BUFFER_SIZE 256
 #endif
 
+#ifndef CONFIG_NEX_UART_FAILURE_WAIT_TIME_MS
+/**
+ * @brief Failure wait time on failure-only response mode (ms).
+ */
+#define CONFIG_NEX_UART_FAILURE_WAIT_TIME_MS 20
+#endif
+
+#ifndef CONFIG_NEX_BATCH_BUFFER_SIZE
+/**
+ * @brief Batch buffer size.
+ */
+#define CONFIG_NEX_BATCH_BUFFER_SIZE 1024
+#endif
+
+#ifndef CONFIG_NEX_ASYNC_QUEUE_SIZE
+/**
+ * @brief Asynchronous instruction queue size.
+ */
+#define CONFIG_NEX_ASYNC_QUEUE_SIZE 8
+#endif
+
+#ifndef CONFIG_NEX_SHADOW_CACHE_SIZE
+/**
+ * @brief Shadow cache size (properties).
+ */
+#define CONFIG_NEX_SHADOW_CACHE_SIZE 32
+#endif
+
+#ifndef CONFIG_NEX_SHADOW_CACHE_TEXT_LENGTH
+/**
+ * @brief Shadow cache text length (bytes).
+ */
+#define CONFIG_NEX_SHADOW_CACHE_TEXT_LENGTH 16
+#endif
+
+#ifndef CONFIG_NEX_SHADOW_CACHE_READ_TTL_MS
+/**
+ * @brief Shadow cache read time to live (ms).
+ */
+#define CONFIG_NEX_SHADOW_CACHE_READ_TTL_MS 0
+#endif
+
+#ifndef CONFIG_NEX_COALESCE_PERIOD_MS
+/**
+ * @brief Coalescing frame period (ms).
+ */
+#define CONFIG_NEX_COALESCE_PERIOD_MS 50
+#endif
+
+#ifndef CONFIG_NEX_COALESCE_SIZE
+/**
+ * @brief Coalescing queue size (properties).
+ */
+#define CONFIG_NEX_COALESCE_SIZE 16
+#endif
+
+#ifndef CONFIG_NEX_COALESCE_TEXT_LENGTH
+/**
+ * @brief Coalescing text length (bytes).
+ */
+#define CONFIG_NEX_COALESCE_TEXT_LENGTH 16
+#endif
+
+#ifndef CONFIG_NEX_WAVEFORM_PUMP_PERIOD_MS
+/**
+ * @brief Waveform pump period (ms).
+ */
+#define CONFIG_NEX_WAVEFORM_PUMP_PERIOD_MS 20
+#endif
+
+#ifndef CONFIG_NEX_WAVEFORM_PUMP_CHANNELS
+/**
+ * @brief Waveform pump channels.
+ */
+#define CONFIG_NEX_WAVEFORM_PUMP_CHANNELS 4
+#endif
+
+#ifndef CONFIG_NEX_WAVEFORM_PUMP_RING_SIZE
+/**
+ * @brief Waveform pump ring size (samples).
+ */
+#define CONFIG_NEX_WAVEFORM_PUMP_RING_SIZE 512
+#endif
+
 #ifndef CONFIG_NEX_UART_TASK_PRIORITY
 /**
  * @brief UART task priority.
@@ -0,0 +1,96 @@
+#ifndef __ESP32_DRIVER_NEXTION_INSTRUMENTATION_H__
+#define __ESP32_DRIVER_NEXTION_INSTRUMENTATION_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+#include "esp32_driver_nextion/base/codes.h"
+#include "esp32_driver_nextion/stats.h"
+#include "protocol/parsers/parser.h"
+#include "config.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#ifdef CONFIG_NEX_STATS
+    /**
+     * @typedef stats_collector_t
+     * @brief Instruction statistics of a context.
+     */
+    typedef struct
+    {
+        portMUX_TYPE lock;     /*!< Guards the statistics; raw bytes are sent without the UART mutex. */
+        nextion_stats_t stats; /*!< Statistics collected. */
+    } stats_collector_t;
+
+    /**
+     * @typedef stats_timer_t
+     * @brief Phase durations of one instruction.
+     */
+    typedef struct
+    {
+        int64_t start;                            /*!< When the instruction started, in microseconds. */
+        int64_t last;                             /*!< When the last phase ended, in microseconds. */
+        uint32_t phases[NEXTION_STATS_PHASE_MAX]; /*!< Phase durations, in microseconds. */
+        uint8_t measured;                         /*!< Bit mask of the phases measured. */
+        bool contended;                           /*!< If the UART was locked by someone else. */
+    } stats_timer_t;
+
+    /**
+     * @brief Initialize a statistics collector.
+     * @param[in] collector Collector.
+     */
+    void nextion_stats_collector_init(stats_collector_t *collector);
+
+    /**
+     * @brief Start timing an instruction.
+     * @param[in] timer Timer.
+     */
+    void nextion_stats_timer_start(stats_timer_t *timer);
+
+    /**
+     * @brief End a phase, which lasted since the previous one ended.
+     * @param[in] timer Timer.
+     * @param[in] phase Phase ended.
+     */
+    void nextion_stats_timer_lap(stats_timer_t *timer, nextion_stats_phase_t phase);
+
+    /**
+     * @brief Get the class of an instruction by its response parser.
+     * @param[in] parser Response parser. Can be NULL.
+     * @return Instruction class.
+     */
+    nextion_stats_class_t nextion_stats_classify(const parser_t *parser);
+
+    /**
+     * @brief Add an instruction to the statistics.
+     * @param[in] collector Collector.
+     * @param[in] instruction_class Instruction class.
+     * @param[in] timer Instruction timer.
+     * @param[in] code Instruction result code.
+     */
+    void nextion_stats_record(stats_collector_t *collector,
+                              nextion_stats_class_t instruction_class,
+                              const stats_timer_t *timer,
+                              nex_err_t code);
+
+#define STATS_TIMER_START(timer) \
+    stats_timer_t timer;         \
+    nextion_stats_timer_start(&(timer))
+#define STATS_TIMER_LAP(timer, phase) nextion_stats_timer_lap(&(timer), phase)
+#define STATS_TIMER_CONTENDED(timer) ((timer).contended = true)
+#define STATS_RECORD(collector, instruction_class, timer, code) nextion_stats_record(collector, instruction_class, &(timer), code)
+#else
+// Instrumentation disabled: nothing is measured nor stored.
+#define STATS_TIMER_START(timer)
+#define STATS_TIMER_LAP(timer, phase)
+#define STATS_TIMER_CONTENDED(timer)
+#define STATS_RECORD(collector, instruction_class, timer, code)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,102 @@
+#ifndef __ESP32_DRIVER_NEXTION_PROTO_ENCODER_H__
+#define __ESP32_DRIVER_NEXTION_PROTO_ENCODER_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @typedef encoder_t
+     * @brief Writes an instruction piece by piece, without "vsnprintf".
+     * @details Appending past the capacity marks the encoder as
+     * overflowed; the check is done once, on "encoder_end".
+     */
+    typedef struct
+    {
+        char *buffer;       /** @brief Where the instruction is written. */
+        size_t capacity;    /** @brief Buffer length, including the null terminator. */
+        size_t length;      /** @brief Number of characters written. */
+        bool is_overflowed; /** @brief If something did not fit in the buffer. */
+    } encoder_t;
+
+    /**
+     * @brief Start encoding onto a buffer.
+     * @param[in] encoder Encoder pointer.
+     * @param[in] buffer Buffer to write into.
+     * @param[in] capacity Buffer length, including the null terminator.
+     */
+    void encoder_begin(encoder_t *encoder, char *buffer, size_t capacity);
+
+    /**
+     * @brief Append characters.
+     * @param[in] encoder Encoder pointer.
+     * @param[in] data Characters to append.
+     * @param[in] length Number of characters.
+     */
+    void encoder_append(encoder_t *encoder, const char *data, size_t length);
+
+    /**
+     * @brief Append a null-terminated text.
+     * @param[in] encoder Encoder pointer.
+     * @param[in] text Text to append.
+     */
+    void encoder_append_text(encoder_t *encoder, const char *text);
+
+    /**
+     * @brief Append a text between double quotes.
+     * @param[in] encoder Encoder pointer.
+     * @param[in] text Text to append.
+     */
+    void encoder_append_quoted(encoder_t *encoder, const char *text);
+
+    /**
+     * @brief Append a component property reference: "component.property".
+     * @param[in] encoder Encoder pointer.
+     * @param[in] component_name Component name.
+     * @param[in] property_name Property name.
+     */
+    void encoder_append_property(encoder_t *encoder, const char *component_name, const char *property_name);
+
+    /**
+     * @brief Append a character.
+     * @param[in] encoder Encoder pointer.
+     * @param[in] character Character to append.
+     */
+    void encoder_append_char(encoder_t *encoder, char character);
+
+    /**
+     * @brief Append a number in decimal.
+     * @param[in] encoder Encoder pointer.
+     * @param[in] number Number to append.
+     */
+    void encoder_append_number(encoder_t *encoder, int32_t number);
+
+    /**
+     * @brief Append numbers in decimal, separated by commas.
+     * @param[in] encoder Encoder pointer.
+     * @param[in] numbers Numbers to append.
+     * @param[in] count Number of numbers.
+     */
+    void encoder_append_numbers(encoder_t *encoder, const int32_t *numbers, size_t count);
+
+    /**
+     * @brief Finish the instruction, adding the null terminator.
+     * @param[in] encoder Encoder pointer.
+     * @return True if the instruction fits in the buffer, otherwise false.
+     */
+    bool encoder_end(encoder_t *encoder);
+
+    /**
+     * @brief Append a string literal, with its length known at compile time.
+     */
+#define ENCODER_APPEND_LITERAL(encoder, literal) encoder_append(encoder, literal, sizeof(literal) - 1)
+
+#ifdef __cplusplus
+}
+#endif
+#endif
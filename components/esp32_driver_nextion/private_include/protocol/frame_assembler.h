@@ -0,0 +1,83 @@
+#ifndef __ESP32_DRIVER_NEXTION_PROTO_FRAME_ASM_H__
+#define __ESP32_DRIVER_NEXTION_PROTO_FRAME_ASM_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "protocol/parsers/parser.h"
+#include "config.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @typedef frame_assembler_t
+     * @brief Accumulates received bytes and cuts complete frames out of them.
+     * @details Bytes are appended in bulk at the tail and frames are removed
+     * from the head; bytes of a partial frame are kept for the next read.
+     */
+    typedef struct
+    {
+        uint8_t buffer[CONFIG_NEX_UART_RECV_FRAME_BUFFER_SIZE]; /** @brief Received bytes, oldest first. */
+        size_t length;                                          /** @brief Number of bytes in the buffer. */
+    } frame_assembler_t;
+
+    /**
+     * @brief Get how many bytes can still be appended.
+     * @param[in] assembler Frame assembler pointer.
+     * @return Free space in bytes.
+     */
+    size_t frame_assembler_free_space(const frame_assembler_t *assembler);
+
+    /**
+     * @brief Get the address where new bytes must be written.
+     * @details Write at most "frame_assembler_free_space" bytes and
+     * then call "frame_assembler_commit".
+     * @param[in] assembler Frame assembler pointer.
+     * @return Write address.
+     */
+    uint8_t *frame_assembler_tail(frame_assembler_t *assembler);
+
+    /**
+     * @brief Mark bytes written at the tail as received.
+     * @param[in] assembler Frame assembler pointer.
+     * @param[in] length Number of bytes written.
+     */
+    void frame_assembler_commit(frame_assembler_t *assembler, size_t length);
+
+    /**
+     * @brief Append bytes to the assembler.
+     * @param[in] assembler Frame assembler pointer.
+     * @param[in] data Bytes to append.
+     * @param[in] length Number of bytes to append.
+     * @return Number of bytes appended; less than \p length if the buffer is full.
+     */
+    size_t frame_assembler_push(frame_assembler_t *assembler, const uint8_t *data, size_t length);
+
+    /**
+     * @brief Find the length of the frame at the head of the buffer.
+     * @param[in] assembler Frame assembler pointer.
+     * @param[in] parser Parser that knows the frame format.
+     * @return Frame length if a complete frame is available, otherwise zero.
+     */
+    size_t frame_assembler_find_frame(const frame_assembler_t *assembler, const parser_t *parser);
+
+    /**
+     * @brief Remove bytes from the head of the buffer.
+     * @param[in] assembler Frame assembler pointer.
+     * @param[in] length Number of bytes to remove.
+     */
+    void frame_assembler_consume(frame_assembler_t *assembler, size_t length);
+
+    /**
+     * @brief Discard all buffered bytes.
+     * @param[in] assembler Frame assembler pointer.
+     */
+    void frame_assembler_reset(frame_assembler_t *assembler);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -25,7 +25,7 @@ extern "C"
      * @param[in] length Data length.
      * @return Number of bytes needed.
      */
-    int parser_evy_tdm_stop_need_more_bytes(const parser_t *parser, const uint8_t *data, size_t length);
+    int parser_evt_tdm_stop_need_more_bytes(const parser_t *parser, const uint8_t *data, size_t length);
 
     /**
      * @brief Parse the data.
@@ -37,6 +37,15 @@ extern "C"
      */
     bool parser_evt_tdm_stop_parse(const parser_t *parser, const uint8_t *data, size_t length);
 
+    /**
+     * @brief Create an TDM_STOP parser.
+     */
+#define PARSER_TDM_STOP()                                       \
+    {                                                           \
+        .can_parse = parser_evt_tdm_stop_can_parse,             \
+        .need_more_bytes = parser_evt_tdm_stop_need_more_bytes, \
+        .parse = parser_evt_tdm_stop_parse}
+
 #ifdef __cplusplus
 }
 #endif
@@ -46,6 +46,11 @@ extern "C"
         .need_more_bytes = parser_rsp_ack_need_more_bytes, \
         .parse = parser_rsp_ack_parse}
 
+    /**
+     * @brief Verify if a parser is an ACK parser.
+     */
+#define PARSER_IS_ACK(parser) ((parser)->can_parse == parser_rsp_ack_can_parse)
+
 #ifdef __cplusplus
 }
 #endif
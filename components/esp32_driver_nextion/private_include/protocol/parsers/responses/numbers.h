@@ -0,0 +1,68 @@
+#ifndef __ESP32_DRIVER_NEXTION_PROTO_PRSR_RSP_NUMS_H__
+#define __ESP32_DRIVER_NEXTION_PROTO_PRSR_RSP_NUMS_H__
+
+#include "protocol/parsers/parser.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief First byte of a response with many numbers, printed by the driver's own "printh".
+ * @details Not used by the device for anything else.
+ */
+#define PARSER_NUMBERS_HEADER 0x72U
+
+/**
+ * @brief Hexadecimal text of the header, as given to "printh".
+ */
+#define PARSER_NUMBERS_HEADER_TEXT "72"
+
+    /**
+     * @brief Verify if the parser can parse the data.
+     * @note Used to parse responses with many numbers.
+     * @param[in] parser Parser context pointer.
+     * @param[in] data_id Data identifier.
+     * @return If can parse.
+     */
+    bool parser_rsp_numbers_can_parse(const parser_t *parser, const uint8_t data_id);
+
+    /**
+     * @brief Verify if the parser needs more data.
+     * @note Used to parse responses with many numbers.
+     * @param[in] parser Parser context pointer.
+     * @param[in] data Data pointer to be parsed.
+     * @param[in] length Data length.
+     * @return Number of bytes needed.
+     */
+    int parser_rsp_numbers_need_more_bytes(const parser_t *parser, const uint8_t *data, size_t length);
+
+    /**
+     * @brief Parse the data.
+     * @note Used to parse responses with many numbers.
+     * @param[in] parser Parser context pointer.
+     * @param[in] data Data pointer to be parsed.
+     * @param[in] length Data length.
+     * @return Success or failure.
+     */
+    bool parser_rsp_numbers_parse(const parser_t *parser, const uint8_t *data, size_t length);
+
+    /**
+     * @brief Create a NUMBERS parser.
+     * @details The response is the header, every number as 4 bytes, and the end sequence.
+     * @param result_buffer_value Array of "int32_t" to write the parsed numbers into.
+     * @param result_buffer_length_value Array length, in bytes.
+     */
+#define PARSER_NUMBERS(result_buffer_value, result_buffer_length_value) \
+    {                                                                   \
+        .can_parse = parser_rsp_numbers_can_parse,                      \
+        .need_more_bytes = parser_rsp_numbers_need_more_bytes,          \
+        .parse = parser_rsp_numbers_parse,                              \
+        .result_buffer = result_buffer_value,                           \
+        .result_buffer_length = result_buffer_length_value}
+
+#ifdef __cplusplus
+}
+#endif
+#endif
\ No newline at end of file
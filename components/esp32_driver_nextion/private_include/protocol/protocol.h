@@ -6,7 +6,16 @@
 #include <stddef.h>
 #include "esp32_driver_nextion/base/codes.h"
 #include "esp32_driver_nextion/base/types.h"
+#include "esp32_driver_nextion/async.h"
+#include "esp32_driver_nextion/batch.h"
+#include "esp32_driver_nextion/system.h"
 #include "protocol/parsers/parser.h"
+#include "protocol/encoder.h"
+#include "instrumentation.h"
+#include "shadow_cache.h"
+#include "coalescer.h"
+#include "waveform_pump.h"
+#include "config.h"
 
 #ifdef __cplusplus
 extern "C"
@@ -16,38 +25,65 @@ extern "C"
     /**
      * @typedef formated_instruction_t
      * @brief A formated instruction ready to be sent.
+     * @details Holds its own text, so each sender formats on its own
+     * stack, in parallel, and only the write is serialized.
      */
     typedef struct
     {
-        const char *text; /** @brief Null-terminated text. */
-        size_t length;    /** @brief Text length. */
+        char text[CONFIG_NEX_UART_TRANS_COMMAND_FORMAT_BUFFER_SIZE]; /** @brief Null-terminated text. */
+        size_t length;                                               /** @brief Text length. */
     } formated_instruction_t;
 
+    /**
+     * @typedef tdm_stream_t
+     * @brief Instruction starting the Transparent Data Mode and the data sent on it.
+     */
+    typedef struct
+    {
+        const char *instruction;   /** @brief Instruction, like "addt", without the end sequence. */
+        size_t instruction_length; /** @brief Instruction length. */
+        const uint8_t *data;       /** @brief Data sent once the device is ready. */
+        size_t data_length;        /** @brief Data length. */
+        const uint8_t *tail_data;  /** @brief Data sent right after, like the start of a wrapped ring. Can be NULL. */
+        size_t tail_length;        /** @brief Tail data length; with the data length, what the instruction announced. */
+    } tdm_stream_t;
+
     /**
      * @brief Format an instruction.
-     * @param[in] handle Nextion context pointer.
-     * @param[in] formated_instruction A null-terminated string with the instruction to be sent.
+     * @param[out] formated_instruction Location where the formated instruction will be written.
      * @param[in] instruction A null-terminated string to format.
      * @param[in] ... Format parameters.
      * @return NEX_OK or NEX_FAIL
      */
-    bool nextion_protocol_format_instruction(nextion_t *handle,
-                                             formated_instruction_t *formated_instruction,
+    bool nextion_protocol_format_instruction(formated_instruction_t *formated_instruction,
                                              const char *instruction,
                                              ...);
 
     /**
      * @brief Format an instruction using a va_list.
-     * @param[in] handle Nextion context pointer.
-     * @param[in] formated_instruction A null-terminated string with the instruction to be sent.
+     * @param[out] formated_instruction Location where the formated instruction will be written.
      * @param[in] instruction A null-terminated string to format.
      * @param[in] args Format parameters.
      * @return NEX_OK or NEX_FAIL
      */
-    bool nextion_protocol_format_instruction_variadic(nextion_t *handle,
-                                                      formated_instruction_t *formated_instruction,
+    bool nextion_protocol_format_instruction_variadic(formated_instruction_t *formated_instruction,
                                                       const char *instruction,
                                                       va_list args);
+    /**
+     * @brief Start encoding an instruction onto the text of a formated instruction.
+     * @details Faster than formatting for instructions made of names and numbers.
+     * @param[in] formated_instruction Where the instruction will be written. Must outlive the encoder.
+     * @param[in] encoder Encoder pointer.
+     */
+    void nextion_protocol_encoder_begin(formated_instruction_t *formated_instruction, encoder_t *encoder);
+
+    /**
+     * @brief Finish encoding an instruction, null-terminating it.
+     * @param[in] encoder Encoder started with "nextion_protocol_encoder_begin".
+     * @return True if it fit the buffer, otherwise false.
+     */
+    bool nextion_protocol_end_encoding(encoder_t *encoder);
+
     /**
      * @brief Send a instruction to the device.
      * @param[in] handle Nextion context pointer.
@@ -105,21 +141,275 @@ extern "C"
      * @brief Send an TDM_START instruction to the device, formating it before sending.
      * @remark An TDM_START instruction starts the Transparent Data Mode.
      * @param[in] handle Nextion context pointer.
+     * @param[in] data_length Number of bytes the device will expect.
      * @param[in] instruction A null-terminated string to format.
      * @param[in] ... Format parameters.
      * @return NEX_OK or NEX_FAIL | NEX_DVC_ERR_*
      */
     nex_err_t nextion_protocol_send_instruction_tdm_start(nextion_t *handle,
+                                                          size_t data_length,
+                                                          const char *instruction,
+                                                          ...);
+
+    /**
+     * @brief Send an ACK instruction already encoded.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] encoder Encoder started with "nextion_protocol_encoder_begin".
+     * @return NEX_OK or NEX_FAIL | NEX_DVC_ERR_*
+     */
+    nex_err_t nextion_protocol_send_encoded_ack(nextion_t *handle, encoder_t *encoder);
+
+    /**
+     * @brief Send an GET_NUMBER instruction already encoded.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] number Buffer to write the parsed number into.
+     * @param[in] encoder Encoder started with "nextion_protocol_encoder_begin".
+     * @return NEX_OK or NEX_FAIL | NEX_DVC_ERR_*
+     */
+    nex_err_t nextion_protocol_send_encoded_get_number(nextion_t *handle, int32_t *number, encoder_t *encoder);
+
+    /**
+     * @brief Send an TDM_START instruction already encoded.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] encoder Encoder started with "nextion_protocol_encoder_begin".
+     * @param[in] data_length Number of bytes the device will expect.
+     * @return NEX_OK or NEX_FAIL | NEX_DVC_ERR_*
+     */
+    nex_err_t nextion_protocol_send_encoded_tdm_start(nextion_t *handle, encoder_t *encoder, size_t data_length);
+
+    /**
+     * @brief Send a instruction to the device without waiting for its response.
+     * @details The response is matched, in order, by the UART receiving path,
+     * which then calls \p callback.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] instruction A null-terminated string with the instruction to be sent.
+     * @param[in] instruction_length Instruction length.
+     * @param[in] parser Parser responsible for parsing the response. Copied; its result buffer must outlive the call.
+     * @param[in] success_code Response code that means success, besides NEX_DVC_INS_OK.
+     * @param[in] callback Function called on completion. Can be NULL.
+     * @param[in] context User context passed to the callback.
+     * @return NEX_OK if queued, otherwise NEX_FAIL.
+     */
+    nex_err_t nextion_protocol_send_instruction_async(nextion_t *handle,
+                                                      const char *instruction,
+                                                      size_t instruction_length,
+                                                      const parser_t *parser,
+                                                      uint8_t success_code,
+                                                      nextion_async_callback_t callback,
+                                                      void *context);
+
+    /**
+     * @brief Send an ACK instruction to the device without waiting for its response, formating it before sending.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] callback Function called on completion. Can be NULL.
+     * @param[in] context User context passed to the callback.
+     * @param[in] instruction A null-terminated string to format.
+     * @param[in] ... Format parameters.
+     * @return NEX_OK if queued, otherwise NEX_FAIL.
+     */
+    nex_err_t nextion_protocol_send_instruction_ack_async(nextion_t *handle,
+                                                          nextion_async_callback_t callback,
+                                                          void *context,
                                                           const char *instruction,
                                                           ...);
 
     /**
-     * @brief Send a raw byte to the device.
+     * @brief Send an GET_TEXT instruction to the device without waiting for its response, formating it before sending.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] buffer Buffer to write the parsed text into. Must outlive the call.
+     * @param[in] buffer_length Buffer length.
+     * @param[in] callback Function called on completion. Can be NULL.
+     * @param[in] context User context passed to the callback.
+     * @param[in] instruction A null-terminated string to format.
+     * @param[in] ... Format parameters.
+     * @return NEX_OK if queued, otherwise NEX_FAIL.
+     */
+    nex_err_t nextion_protocol_send_instruction_get_text_async(nextion_t *handle,
+                                                               char *buffer,
+                                                               size_t buffer_length,
+                                                               nextion_async_callback_t callback,
+                                                               void *context,
+                                                               const char *instruction,
+                                                               ...);
+
+    /**
+     * @brief Send an GET_NUMBER instruction to the device without waiting for its response, formating it before sending.
      * @param[in] handle Nextion context pointer.
-     * @param[in] value Byte to be sent.
+     * @param[in] number Buffer to write the parsed number into. Must outlive the call.
+     * @param[in] callback Function called on completion. Can be NULL.
+     * @param[in] context User context passed to the callback.
+     * @param[in] instruction A null-terminated string to format.
+     * @param[in] ... Format parameters.
+     * @return NEX_OK if queued, otherwise NEX_FAIL.
+     */
+    nex_err_t nextion_protocol_send_instruction_get_number_async(nextion_t *handle,
+                                                                 int32_t *number,
+                                                                 nextion_async_callback_t callback,
+                                                                 void *context,
+                                                                 const char *instruction,
+                                                                 ...);
+
+    /**
+     * @brief Send an ACK instruction already encoded, without waiting for its response.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] callback Function called on completion. Can be NULL.
+     * @param[in] context User context passed to the callback.
+     * @param[in] encoder Encoder started with "nextion_protocol_encoder_begin".
+     * @return NEX_OK if queued, otherwise NEX_FAIL.
+     */
+    nex_err_t nextion_protocol_send_encoded_ack_async(nextion_t *handle,
+                                                      nextion_async_callback_t callback,
+                                                      void *context,
+                                                      encoder_t *encoder);
+
+    /**
+     * @brief Wait until all asynchronous instructions complete.
+     * @param[in] handle Nextion context pointer.
+     * @return NEX_OK or NEX_FAIL.
+     */
+    nex_err_t nextion_protocol_wait_async(nextion_t *handle);
+
+    /**
+     * @brief Send instructions already encoded, each followed by the end sequence, and collect their results.
+     * @details Everything is written at once; results are then read in order.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] data Encoded instructions.
+     * @param[in] data_length Encoded instructions length.
+     * @param[in] instruction_count Number of instructions encoded.
+     * @param[out] failures Location where failed instructions will be written. Can be NULL.
+     * @param[in] failures_length Maximum number of failures written.
+     * @param[out] failure_count Number of failed instructions. Can be NULL.
+     * @return NEX_OK if all instructions succeeded, otherwise NEX_FAIL.
+     */
+    nex_err_t nextion_protocol_send_batch(nextion_t *handle,
+                                          const uint8_t *data,
+                                          size_t data_length,
+                                          size_t instruction_count,
+                                          nextion_batch_failure_t *failures,
+                                          size_t failures_length,
+                                          size_t *failure_count);
+
+    /**
+     * @brief Send instructions already encoded that print many numbers in a single response.
+     * @details The instructions must print PARSER_NUMBERS_HEADER, every number as 4 bytes,
+     * and the end sequence. The device returns no instruction result meanwhile.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] data Encoded instructions, each followed by the end sequence.
+     * @param[in] data_length Encoded instructions length.
+     * @param[out] numbers Location where the numbers will be stored.
+     * @param[in] count Number of numbers printed.
+     * @return NEX_OK or NEX_FAIL | NEX_TIMEOUT.
+     */
+    nex_err_t nextion_protocol_send_get_numbers(nextion_t *handle,
+                                                const uint8_t *data,
+                                                size_t data_length,
+                                                int32_t *numbers,
+                                                size_t count);
+
+    /**
+     * @brief Set which instruction results the device returns and the driver expects.
+     * @details Sends "bkcmd" once every result of the old mode was received, and
+     * waits for its own result as the new mode returns it. The mode is kept on failure.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] mode Response mode.
+     * @param[in] on_failure Function called on late failures. Can be NULL.
+     * @param[in] context User context passed to the callback.
+     * @return NEX_OK or NEX_FAIL | NEX_DVC_ERR_*.
+     */
+    nex_err_t nextion_protocol_set_response_mode(nextion_t *handle,
+                                                 nextion_response_mode_t mode,
+                                                 nextion_failure_callback_t on_failure,
+                                                 void *context);
+
+    /**
+     * @brief Send a baud rate change to the device and switch the UART to it.
+     * @details The UART switches after the instruction is transmitted and
+     * the device had time to switch as well. Anything received meanwhile is discarded.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] baud_rate New baud rate.
+     * @param[in] persist If the device must keep the baud rate between resets ("bauds").
      * @return NEX_OK or NEX_FAIL.
      */
-    nex_err_t nextion_protocol_send_raw_byte(const nextion_t *handle, uint8_t value);
+    nex_err_t nextion_protocol_set_baud_rate(nextion_t *handle, uint32_t baud_rate, bool persist);
+
+    /**
+     * @brief Get the baud rate the UART is using.
+     * @param[in] handle Nextion context pointer.
+     * @return Baud rate.
+     */
+    uint32_t nextion_protocol_get_baud_rate(const nextion_t *handle);
+
+    /**
+     * @brief Set how many bytes the device expects on the Transparent Data Mode just started.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] data_length Number of bytes.
+     */
+    void nextion_protocol_set_tdm_length(nextion_t *handle, size_t data_length);
+
+    /**
+     * @brief Send data on the Transparent Data Mode, in a single write.
+     * @details When the data completes what the device expects, waits for it to leave the mode.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] data Bytes to be sent.
+     * @param[in] length Number of bytes; at most what the device still expects.
+     * @return NEX_OK or NEX_FAIL | NEX_TIMEOUT.
+     */
+    nex_err_t nextion_protocol_send_tdm_data(nextion_t *handle, const uint8_t *data, size_t length);
+
+    /**
+     * @brief Send many Transparent Data Mode streams back to back, holding the lock between them.
+     * @details Each instruction is sent after the previous stream finished; nothing else is sent meanwhile.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] streams Streams.
+     * @param[in] stream_count Number of streams.
+     * @return NEX_OK or NEX_FAIL | NEX_TIMEOUT.
+     */
+    nex_err_t nextion_protocol_send_tdm_streams(nextion_t *handle, const tdm_stream_t *streams, size_t stream_count);
+
+    /**
+     * @brief Send raw bytes to the device, in a single write.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] data Bytes to be sent.
+     * @param[in] length Number of bytes.
+     * @return NEX_OK or NEX_FAIL.
+     */
+    nex_err_t nextion_protocol_send_raw(const nextion_t *handle, const uint8_t *data, size_t length);
+
+#ifdef CONFIG_NEX_STATS
+    /**
+     * @brief Get the instruction statistics collector.
+     * @param[in] handle Nextion context pointer.
+     * @return Statistics collector.
+     */
+    stats_collector_t *nextion_protocol_get_stats(nextion_t *handle);
+#endif
+
+#ifdef CONFIG_NEX_SHADOW_CACHE
+    /**
+     * @brief Get the shadow cache of component property values.
+     * @param[in] handle Nextion context pointer.
+     * @return Shadow cache.
+     */
+    shadow_cache_t *nextion_protocol_get_shadow(nextion_t *handle);
+#endif
+
+#ifdef CONFIG_NEX_COALESCE
+    /**
+     * @brief Get the coalescer of component property writes.
+     * @param[in] handle Nextion context pointer.
+     * @return Coalescer.
+     */
+    coalescer_t *nextion_protocol_get_coalescer(nextion_t *handle);
+#endif
+
+#ifdef CONFIG_NEX_WAVEFORM_PUMP
+    /**
+     * @brief Get the waveform pump.
+     * @param[in] handle Nextion context pointer.
+     * @return Waveform pump.
+     */
+    waveform_pump_t *nextion_protocol_get_pump(nextion_t *handle);
+#endif
 
 #ifdef __cplusplus
 }
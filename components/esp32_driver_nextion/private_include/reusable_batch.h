@@ -0,0 +1,30 @@
+#ifndef __ESP32_DRIVER_NEXTION_REUSABLE_BATCH_H__
+#define __ESP32_DRIVER_NEXTION_REUSABLE_BATCH_H__
+
+#include <stddef.h>
+#include "esp32_driver_nextion/base/codes.h"
+#include "esp32_driver_nextion/batch.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @brief Send all instructions of a batch, like "nextion_batch_commit", but keep the batch.
+     * @details The batch is left empty, ready for the next instructions; it is released with "nextion_batch_discard".
+     * @param[in] batch Batch pointer.
+     * @param[out] failures Location where failed instructions will be written. Can be NULL.
+     * @param[in] failures_length Maximum number of failures written.
+     * @param[out] failure_count Number of failed instructions, even if more than \p failures_length. Can be NULL.
+     * @return NEX_OK if all instructions succeeded, otherwise NEX_FAIL.
+     */
+    nex_err_t nextion_batch_send(nextion_batch_t *batch,
+                                 nextion_batch_failure_t *failures,
+                                 size_t failures_length,
+                                 size_t *failure_count);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,170 @@
+#ifndef __ESP32_DRIVER_NEXTION_SHADOW_CACHE_H__
+#define __ESP32_DRIVER_NEXTION_SHADOW_CACHE_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "freertos/FreeRTOS.h"
+#include "esp32_driver_nextion/base/codes.h"
+#include "esp32_driver_nextion/base/types.h"
+#include "esp32_driver_nextion/instruction.h"
+#include "esp32_driver_nextion/property.h"
+#include "esp32_driver_nextion/shadow.h"
+#include "protocol/encoder.h"
+#include "config.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#ifdef CONFIG_NEX_SHADOW_CACHE
+/**
+ * @brief Component id of entries whose component was never asked for its id.
+ */
+#define SHADOW_COMPONENT_ID_UNKNOWN -1
+
+    /**
+     * @typedef shadow_entry_t
+     * @brief Last value acknowledged or read for a component property.
+     */
+    typedef struct
+    {
+        uint32_t hash;                                  /*!< Hash of the property reference. */
+        uint32_t last_used;                             /*!< When it was last looked up, for eviction. */
+        TickType_t expires_at;                          /*!< Until when reads can return it. */
+        int32_t number;                                 /*!< Number set; unused for texts. */
+        int16_t component_id;                           /*!< Component id, or SHADOW_COMPONENT_ID_UNKNOWN. */
+        uint8_t component_length;                       /*!< Length of the component name in the path. */
+        uint8_t path_length;                            /*!< Property reference length. */
+        uint8_t text_length;                            /*!< Text length; unused for numbers. */
+        bool is_text;                                   /*!< If the value is a text. */
+        char path[NEXTION_PROPERTY_PATH_MAX_LENGTH];    /*!< Property reference: "component.property". */
+        char text[CONFIG_NEX_SHADOW_CACHE_TEXT_LENGTH]; /*!< Text set, not null-terminated; unused for numbers. */
+    } shadow_entry_t;
+
+    /**
+     * @typedef shadow_cache_t
+     * @brief Component property values acknowledged by or read from the device.
+     */
+    typedef struct
+    {
+        portMUX_TYPE lock;                                    /*!< Guards the cache; events clear it from the UART task. */
+        uint32_t generation;                                  /*!< Changes on every store and clear, to drop stale stores. */
+        uint32_t clock;                                       /*!< Lookup counter, for eviction. */
+        nextion_shadow_stats_t stats;                         /*!< Hit and miss counters. */
+        size_t count;                                         /*!< Number of entries used. */
+        shadow_entry_t entries[CONFIG_NEX_SHADOW_CACHE_SIZE]; /*!< Entries. */
+    } shadow_cache_t;
+
+    /**
+     * @brief Initialize a shadow cache.
+     * @param[in] cache Cache.
+     */
+    void nextion_shadow_init(shadow_cache_t *cache);
+
+    /**
+     * @brief Forget all values.
+     * @param[in] cache Cache.
+     */
+    void nextion_shadow_clear_all(shadow_cache_t *cache);
+
+    /**
+     * @brief Forget the values of a component touched, and of components with unknown id.
+     * @param[in] cache Cache.
+     * @param[in] component_id Component id.
+     */
+    void nextion_shadow_touch(shadow_cache_t *cache, uint8_t component_id);
+
+    /**
+     * @brief Forget the value of a component property.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] component_name Component name.
+     * @param[in] property_name Property name.
+     */
+    void nextion_shadow_forget(nextion_t *handle, const char *component_name, const char *property_name);
+
+    /**
+     * @brief Forget the value of the component property an instruction assigns, if any.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] instruction Instruction, like "component.property=value".
+     * @param[in] instruction_length Instruction length.
+     */
+    void nextion_shadow_forget_assignment(nextion_t *handle, const char *instruction, size_t instruction_length);
+
+    /**
+     * @brief Send an instruction that sets a number, unless the device already has it.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] encoder Encoder holding "component.property=number".
+     * @param[in] path_length Length of "component.property".
+     * @param[in] number Number set.
+     * @return NEX_OK or NEX_FAIL | NEX_DVC_ERR_*
+     */
+    nex_err_t nextion_shadow_send_number(nextion_t *handle, encoder_t *encoder, size_t path_length, int32_t number);
+
+    /**
+     * @brief Send an instruction that sets a text, unless the device already has it.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] encoder Encoder holding "component.property=\"text\"".
+     * @param[in] path_length Length of "component.property".
+     * @param[in] text Text set.
+     * @return NEX_OK or NEX_FAIL | NEX_DVC_ERR_*
+     */
+    nex_err_t nextion_shadow_send_text(nextion_t *handle, encoder_t *encoder, size_t path_length, const char *text);
+
+    /**
+     * @brief Get a number, from the cache while it is fresh.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] query A null-terminated string with "get component.property".
+     * @param[in] query_length Query length.
+     * @param[in] ttl_ms For how long the number read is returned from the cache. Zero skips the cache.
+     * @param[out] number Location where the number will be stored.
+     * @return NEX_OK or NEX_FAIL | NEX_DVC_ERR_*
+     */
+    nex_err_t nextion_shadow_get_number(nextion_t *handle,
+                                        const char *query,
+                                        size_t query_length,
+                                        uint32_t ttl_ms,
+                                        int32_t *number);
+
+    /**
+     * @brief Get a text, from the cache while it is fresh.
+     * @param[in] handle Nextion context pointer.
+     * @param[in] query A null-terminated string with "get component.property".
+     * @param[in] query_length Query length.
+     * @param[in] ttl_ms For how long the text read is returned from the cache. Zero skips the cache.
+     * @param[out] buffer Location where the text will be stored.
+     * @param[in] buffer_length Buffer length.
+     * @return NEX_OK or NEX_FAIL | NEX_DVC_ERR_*
+     */
+    nex_err_t nextion_shadow_get_text(nextion_t *handle,
+                                      const char *query,
+                                      size_t query_length,
+                                      uint32_t ttl_ms,
+                                      char *buffer,
+                                      size_t buffer_length);
+
+#define SHADOW_CLEAR(cache) nextion_shadow_clear_all(cache)
+#define SHADOW_TOUCH(cache, component_id) nextion_shadow_touch(cache, component_id)
+#define SHADOW_FORGET(handle, component_name, property_name) nextion_shadow_forget(handle, component_name, property_name)
+#define SHADOW_FORGET_ASSIGNMENT(handle, instruction, instruction_length) nextion_shadow_forget_assignment(handle, instruction, instruction_length)
+#define SHADOW_SEND_NUMBER(handle, encoder, path_length, number) nextion_shadow_send_number(handle, encoder, path_length, number)
+#define SHADOW_SEND_TEXT(handle, encoder, path_length, text) nextion_shadow_send_text(handle, encoder, path_length, text)
+#define SHADOW_GET_NUMBER(handle, query, query_length, ttl_ms, number) nextion_shadow_get_number(handle, query, query_length, ttl_ms, number)
+#define SHADOW_GET_TEXT(handle, query, query_length, ttl_ms, buffer, buffer_length) nextion_shadow_get_text(handle, query, query_length, ttl_ms, buffer, buffer_length)
+#else
+// Cache disabled: everything is sent and read.
+#define SHADOW_CLEAR(cache)
+#define SHADOW_TOUCH(cache, component_id)
+#define SHADOW_FORGET(handle, component_name, property_name)
+#define SHADOW_FORGET_ASSIGNMENT(handle, instruction, instruction_length)
+#define SHADOW_SEND_NUMBER(handle, encoder, path_length, number) ((void)(path_length), nextion_protocol_send_encoded_ack(handle, encoder))
+#define SHADOW_SEND_TEXT(handle, encoder, path_length, text) ((void)(path_length), nextion_protocol_send_encoded_ack(handle, encoder))
+#define SHADOW_GET_NUMBER(handle, query, query_length, ttl_ms, number) ((void)(ttl_ms), nextion_instruction_send_get_number(handle, query, query_length, number))
+#define SHADOW_GET_TEXT(handle, query, query_length, ttl_ms, buffer, buffer_length) ((void)(ttl_ms), nextion_instruction_send_get_text(handle, query, query_length, buffer, buffer_length))
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+#endif
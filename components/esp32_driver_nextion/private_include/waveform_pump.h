@@ -0,0 +1,69 @@
+#ifndef __ESP32_DRIVER_NEXTION_WAVEFORM_PUMP_H__
+#define __ESP32_DRIVER_NEXTION_WAVEFORM_PUMP_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdatomic.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp32_driver_nextion/base/codes.h"
+#include "esp32_driver_nextion/base/types.h"
+#include "esp32_driver_nextion/pump.h"
+#include "config.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#ifdef CONFIG_NEX_WAVEFORM_PUMP
+    /**
+     * @brief Ring of samples of a waveform channel.
+     * @details Lock-free with a single producer and a single consumer: only the
+     * producer moves the head, only the pump moves the tail. One slot is always
+     * left empty, so a full ring can be told apart from an empty one.
+     */
+    struct nextion_pump_channel_t
+    {
+        atomic_size_t head;                                  /*!< Index of the next sample pushed. */
+        atomic_size_t tail;                                  /*!< Index of the next sample streamed. */
+        atomic_size_t dropped;                               /*!< Samples dropped as the ring was full; only the producer changes it. */
+        uint8_t waveform_id;                                 /*!< Waveform id. */
+        uint8_t channel_id;                                  /*!< Channel id. */
+        bool is_open;                                        /*!< If the channel is in use; changed only holding "drain_sync". */
+        uint8_t samples[CONFIG_NEX_WAVEFORM_PUMP_RING_SIZE]; /*!< Samples. */
+    };
+
+    /**
+     * @typedef waveform_pump_t
+     * @brief Waveform channels streamed by a background task.
+     */
+    typedef struct
+    {
+        SemaphoreHandle_t drain_sync;                                         /*!< Keeps channels from being opened or closed while streamed. */
+        TaskHandle_t task;                                                    /*!< Task that streams once per period. */
+        uint32_t period_ms;                                                   /*!< Period, in milliseconds. */
+        nextion_pump_channel_t channels[CONFIG_NEX_WAVEFORM_PUMP_CHANNELS]; /*!< Channels. */
+    } waveform_pump_t;
+
+    /**
+     * @brief Initialize a waveform pump and start its task.
+     * @param[in] pump Waveform pump.
+     * @param[in] handle Nextion context pointer the samples are sent to.
+     * @return True if started, otherwise false.
+     */
+    bool nextion_pump_init(waveform_pump_t *pump, nextion_t *handle);
+
+    /**
+     * @brief Stop the task of a waveform pump, dropping any sample waiting.
+     * @param[in] pump Waveform pump.
+     */
+    void nextion_pump_deinit(waveform_pump_t *pump);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+#endif
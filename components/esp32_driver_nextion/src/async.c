@@ -0,0 +1,121 @@
+#include <string.h>
+#include "esp32_driver_nextion/async.h"
+#include "protocol/parsers/responses/ack.h"
+#include "protocol/protocol.h"
+#include "shadow_cache.h"
+#include "assertion.h"
+
+nex_err_t nextion_async_send(nextion_t *handle,
+                             const char *instruction,
+                             nextion_async_callback_t callback,
+                             void *context)
+{
+    CMP_CHECK_HANDLE(handle, NEX_FAIL)
+    CMP_CHECK((instruction != NULL), "instruction error(NULL)", NEX_FAIL)
+
+    parser_t parser = PARSER_ACK();
+    const size_t instruction_length = strlen(instruction);
+
+    nex_err_t code = nextion_protocol_send_instruction_async(handle,
+                                                             instruction,
+                                                             instruction_length,
+                                                             &parser,
+                                                             NEX_DVC_INS_OK,
+                                                             callback,
+                                                             context);
+
+    SHADOW_FORGET_ASSIGNMENT(handle, instruction, instruction_length);
+
+    return code;
+}
+
+nex_err_t nextion_async_set_property_number(nextion_t *handle,
+                                            const char *component_name,
+                                            const char *property_name,
+                                            int32_t number,
+                                            nextion_async_callback_t callback,
+                                            void *context)
+{
+    CMP_CHECK_HANDLE(handle, NEX_FAIL)
+    CMP_CHECK((component_name != NULL), "component_name error(NULL)", NEX_FAIL)
+    CMP_CHECK((property_name != NULL), "property_name error(NULL)", NEX_FAIL)
+
+    formated_instruction_t instruction;
+    encoder_t encoder;
+
+    nextion_protocol_encoder_begin(&instruction, &encoder);
+    encoder_append_property(&encoder, component_name, property_name);
+    encoder_append_char(&encoder, '=');
+    encoder_append_number(&encoder, number);
+
+    nex_err_t code = nextion_protocol_send_encoded_ack_async(handle, callback, context, &encoder);
+
+    // The result is only known later; send it again next time. Forgotten once
+    // written, as a value remembered before would be overwritten by this one.
+    SHADOW_FORGET(handle, component_name, property_name);
+
+    return code;
+}
+
+nex_err_t nextion_async_set_property_text(nextion_t *handle,
+                                          const char *component_name,
+                                          const char *property_name,
+                                          const char *text,
+                                          nextion_async_callback_t callback,
+                                          void *context)
+{
+    CMP_CHECK_HANDLE(handle, NEX_FAIL)
+    CMP_CHECK((component_name != NULL), "component_name error(NULL)", NEX_FAIL)
+    CMP_CHECK((property_name != NULL), "property_name error(NULL)", NEX_FAIL)
+    CMP_CHECK((text != NULL), "text error(NULL)", NEX_FAIL)
+
+    nex_err_t code = nextion_protocol_send_instruction_ack_async(handle, callback, context, "%s.%s=\"%s\"", component_name, property_name, text);
+
+    SHADOW_FORGET(handle, component_name, property_name);
+
+    return code;
+}
+
+nex_err_t nextion_async_get_property_number(nextion_t *handle,
+                                            const char *component_name,
+                                            const char *property_name,
+                                            int32_t *number,
+                                            nextion_async_callback_t callback,
+                                            void *context)
+{
+    CMP_CHECK_HANDLE(handle, NEX_FAIL)
+    CMP_CHECK((component_name != NULL), "component_name error(NULL)", NEX_FAIL)
+    CMP_CHECK((property_name != NULL), "property_name error(NULL)", NEX_FAIL)
+    CMP_CHECK((number != NULL), "number error(NULL)", NEX_FAIL)
+
+    return nextion_protocol_send_instruction_get_number_async(handle, number, callback, context, "get %s.%s", component_name, property_name);
+}
+
+nex_err_t nextion_async_get_property_text(nextion_t *handle,
+                                          const char *component_name,
+                                          const char *property_name,
+                                          char *buffer,
+                                          size_t buffer_length,
+                                          nextion_async_callback_t callback,
+                                          void *context)
+{
+    CMP_CHECK_HANDLE(handle, NEX_FAIL)
+    CMP_CHECK((component_name != NULL), "component_name error(NULL)", NEX_FAIL)
+    CMP_CHECK((property_name != NULL), "property_name error(NULL)", NEX_FAIL)
+    CMP_CHECK((buffer != NULL), "buffer error(NULL)", NEX_FAIL)
+    CMP_CHECK((buffer_length > 0), "buffer_length error(0)", NEX_FAIL)
+
+    return nextion_protocol_send_instruction_get_text_async(handle,
+                                                            buffer,
+                                                            buffer_length,
+                                                            callback,
+                                                            context,
+                                                            "get %s.%s", component_name, property_name);
+}
+
+nex_err_t nextion_async_wait(nextion_t *handle)
+{
+    CMP_CHECK_HANDLE(handle, NEX_FAIL)
+
+    return nextion_protocol_wait_async(handle);
+}
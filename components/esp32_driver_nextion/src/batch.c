@@ -0,0 +1,237 @@
+#include <malloc.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include "esp32_driver_nextion/batch.h"
+#include "esp32_driver_nextion/base/constants.h"
+#include "protocol/protocol.h"
+#include "reusable_batch.h"
+#include "shadow_cache.h"
+#include "assertion.h"
+#include "config.h"
+
+struct nextion_batch_t
+{
+    nextion_t *handle;                            /*!< Nextion context the batch will be sent to. */
+    uint8_t buffer[CONFIG_NEX_BATCH_BUFFER_SIZE]; /*!< Encoded instructions, each followed by the end sequence. */
+    size_t length;                                /*!< Number of bytes encoded. */
+    size_t count;                                 /*!< Number of instructions encoded. */
+    bool is_overflowed;                           /*!< If an instruction did not fit in the buffer. */
+};
+
+static nex_err_t nextion_batch_add_format(nextion_batch_t *batch, const char *instruction, ...);
+static void nextion_batch_encoder_begin(nextion_batch_t *batch, encoder_t *encoder);
+static nex_err_t nextion_batch_encoder_end(nextion_batch_t *batch, encoder_t *encoder);
+static void nextion_batch_end_instruction(nextion_batch_t *batch, size_t instruction_length);
+#ifdef CONFIG_NEX_SHADOW_CACHE
+static void nextion_batch_forget(nextion_batch_t *batch);
+#endif
+
+nextion_batch_t *nextion_batch_begin(nextion_t *handle)
+{
+    CMP_CHECK_HANDLE(handle, NULL)
+
+    nextion_batch_t *batch = (nextion_batch_t *)malloc(sizeof(nextion_batch_t));
+
+    CMP_CHECK((batch != NULL), "malloc error(batch)", NULL)
+
+    batch->handle = handle;
+    batch->length = 0;
+    batch->count = 0;
+    batch->is_overflowed = false;
+
+    return batch;
+}
+
+nex_err_t nextion_batch_add(nextion_batch_t *batch, const char *instruction)
+{
+    CMP_CHECK((instruction != NULL), "instruction error(NULL)", NEX_FAIL)
+
+    return nextion_batch_add_format(batch, "%s", instruction);
+}
+
+nex_err_t nextion_batch_add_property_number(nextion_batch_t *batch,
+                                            const char *component_name,
+                                            const char *property_name,
+                                            int32_t number)
+{
+    CMP_CHECK((batch != NULL), "batch error(NULL)", NEX_FAIL)
+    CMP_CHECK((component_name != NULL), "component_name error(NULL)", NEX_FAIL)
+    CMP_CHECK((property_name != NULL), "property_name error(NULL)", NEX_FAIL)
+
+    encoder_t encoder;
+
+    nextion_batch_encoder_begin(batch, &encoder);
+    encoder_append_property(&encoder, component_name, property_name);
+    encoder_append_char(&encoder, '=');
+    encoder_append_number(&encoder, number);
+
+    return nextion_batch_encoder_end(batch, &encoder);
+}
+
+nex_err_t nextion_batch_add_property_text(nextion_batch_t *batch,
+                                          const char *component_name,
+                                          const char *property_name,
+                                          const char *text)
+{
+    CMP_CHECK((batch != NULL), "batch error(NULL)", NEX_FAIL)
+    CMP_CHECK((component_name != NULL), "component_name error(NULL)", NEX_FAIL)
+    CMP_CHECK((property_name != NULL), "property_name error(NULL)", NEX_FAIL)
+    CMP_CHECK((text != NULL), "text error(NULL)", NEX_FAIL)
+
+    return nextion_batch_add_format(batch, "%s.%s=\"%s\"", component_name, property_name, text);
+}
+
+nex_err_t nextion_batch_add_value(nextion_batch_t *batch, const char *component_name, int32_t number)
+{
+    return nextion_batch_add_property_number(batch, component_name, "val", number);
+}
+
+nex_err_t nextion_batch_add_text(nextion_batch_t *batch, const char *component_name, const char *text)
+{
+    return nextion_batch_add_property_text(batch, component_name, "txt", text);
+}
+
+nex_err_t nextion_batch_commit(nextion_batch_t *batch,
+                               nextion_batch_failure_t *failures,
+                               size_t failures_length,
+                               size_t *failure_count)
+{
+    CMP_CHECK((batch != NULL), "batch error(NULL)", NEX_FAIL)
+
+    nex_err_t code = nextion_batch_send(batch, failures, failures_length, failure_count);
+
+    free(batch);
+
+    return code;
+}
+
+void nextion_batch_discard(nextion_batch_t *batch)
+{
+    free(batch);
+}
+
+nex_err_t nextion_batch_send(nextion_batch_t *batch,
+                             nextion_batch_failure_t *failures,
+                             size_t failures_length,
+                             size_t *failure_count)
+{
+    CMP_CHECK((batch != NULL), "batch error(NULL)", NEX_FAIL)
+
+    nex_err_t code = NEX_FAIL;
+
+    if (failure_count != NULL)
+    {
+        *failure_count = 0;
+    }
+
+    // A partial batch would leave the screen half updated.
+    if (batch->is_overflowed)
+    {
+        CMP_LOGE("batch buffer insufficient: has %lu", (unsigned long)sizeof(batch->buffer));
+    }
+    else if (batch->count == 0)
+    {
+        code = NEX_OK;
+    }
+    else
+    {
+        code = nextion_protocol_send_batch(batch->handle,
+                                           batch->buffer,
+                                           batch->length,
+                                           batch->count,
+                                           failures,
+                                           failures_length,
+                                           failure_count);
+
+#ifdef CONFIG_NEX_SHADOW_CACHE
+        nextion_batch_forget(batch);
+#endif
+    }
+
+    batch->length = 0;
+    batch->count = 0;
+    batch->is_overflowed = false;
+
+    return code;
+}
+
+static nex_err_t nextion_batch_add_format(nextion_batch_t *batch, const char *instruction, ...)
+{
+    CMP_CHECK((batch != NULL), "batch error(NULL)", NEX_FAIL)
+
+    const size_t free_space = sizeof(batch->buffer) - batch->length;
+
+    va_list args;
+    va_start(args, instruction);
+
+    int result = vsnprintf((char *)batch->buffer + batch->length, free_space, instruction, args);
+
+    va_end(args);
+
+    // Room is needed for the end sequence as well; "vsnprintf"
+    // only needs one byte for its null terminator.
+    if (result < 0 || (size_t)result + NEX_DVC_CMD_END_LENGTH > free_space)
+    {
+        batch->is_overflowed = true;
+
+        CMP_LOGE("batch buffer insufficient: needed %d, has %lu", result + NEX_DVC_CMD_END_LENGTH, (unsigned long)free_space);
+
+        return NEX_FAIL;
+    }
+
+    nextion_batch_end_instruction(batch, (size_t)result);
+
+    return NEX_OK;
+}
+
+static void nextion_batch_encoder_begin(nextion_batch_t *batch, encoder_t *encoder)
+{
+    encoder_begin(encoder, (char *)batch->buffer + batch->length, sizeof(batch->buffer) - batch->length);
+}
+
+static nex_err_t nextion_batch_encoder_end(nextion_batch_t *batch, encoder_t *encoder)
+{
+    // Room is needed for the end sequence, not for a null terminator.
+    if (encoder->is_overflowed || encoder->length + NEX_DVC_CMD_END_LENGTH > encoder->capacity)
+    {
+        batch->is_overflowed = true;
+
+        CMP_LOGE("batch buffer insufficient: has %lu", (unsigned long)encoder->capacity);
+
+        return NEX_FAIL;
+    }
+
+    nextion_batch_end_instruction(batch, encoder->length);
+
+    return NEX_OK;
+}
+
+static void nextion_batch_end_instruction(nextion_batch_t *batch, size_t instruction_length)
+{
+    batch->length += instruction_length;
+
+    memset(batch->buffer + batch->length, NEX_DVC_CMD_END_VALUE, NEX_DVC_CMD_END_LENGTH);
+
+    batch->length += NEX_DVC_CMD_END_LENGTH;
+    batch->count++;
+}
+
+#ifdef CONFIG_NEX_SHADOW_CACHE
+static void nextion_batch_forget(nextion_batch_t *batch)
+{
+    const char *instruction = (const char *)batch->buffer;
+    const char *end = instruction + batch->length;
+
+    // Batched values are not remembered; send them again next time. Forgotten
+    // once written, as a value remembered before would be overwritten by them.
+    while (instruction < end)
+    {
+        const char *instruction_end = (const char *)memchr(instruction, NEX_DVC_CMD_END_VALUE, (size_t)(end - instruction));
+
+        SHADOW_FORGET_ASSIGNMENT(batch->handle, instruction, (size_t)(instruction_end - instruction));
+
+        instruction = instruction_end + NEX_DVC_CMD_END_LENGTH;
+    }
+}
+#endif
@@ -0,0 +1,390 @@
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp32_driver_nextion/base/constants.h"
+#include "esp32_driver_nextion/batch.h"
+#include "esp32_driver_nextion/coalesce.h"
+#include "esp32_driver_nextion/component.h"
+#include "protocol/protocol.h"
+#include "reusable_batch.h"
+#include "coalescer.h"
+#include "assertion.h"
+#include "config.h"
+
+#ifdef CONFIG_NEX_COALESCE
+/**
+ * @brief Longest number encoded: "-2147483648".
+ */
+#define COALESCE_NUMBER_MAX_LENGTH 11U
+
+/**
+ * @typedef coalesce_value_t
+ * @brief Value being written.
+ */
+typedef struct
+{
+    const char *text;   /*!< Text written, or NULL for numbers. */
+    size_t text_length; /*!< Text length. */
+    int32_t number;     /*!< Number written. */
+} coalesce_value_t;
+
+static nex_err_t nextion_coalesce_set(nextion_t *handle,
+                                      const char *component_name,
+                                      const char *property_name,
+                                      const coalesce_value_t *value);
+static bool nextion_coalesce_take(coalescer_t *coalescer, coalesce_entry_t *entry);
+static size_t nextion_coalesce_encoded_length(const coalesce_entry_t *entry);
+static nex_err_t nextion_coalesce_add(nextion_batch_t *batch, const coalesce_entry_t *entry);
+static nex_err_t nextion_coalesce_send(nextion_batch_t *batch);
+static void nextion_coalesce_task(void *pv);
+#endif
+
+nex_err_t nextion_coalesce_set_property_number(nextion_t *handle,
+                                               const char *component_name,
+                                               const char *property_name,
+                                               int32_t number)
+{
+    CMP_CHECK_HANDLE(handle, NEX_FAIL)
+    CMP_CHECK((component_name != NULL), "component_name error(NULL)", NEX_FAIL)
+    CMP_CHECK((property_name != NULL), "property_name error(NULL)", NEX_FAIL)
+
+#ifdef CONFIG_NEX_COALESCE
+    const coalesce_value_t value = {.text = NULL, .text_length = 0, .number = number};
+
+    return nextion_coalesce_set(handle, component_name, property_name, &value);
+#else
+    CMP_LOGW("coalescing disabled: enable CONFIG_NEX_COALESCE");
+
+    return NEX_FAIL;
+#endif
+}
+
+nex_err_t nextion_coalesce_set_property_text(nextion_t *handle,
+                                             const char *component_name,
+                                             const char *property_name,
+                                             const char *text)
+{
+    CMP_CHECK_HANDLE(handle, NEX_FAIL)
+    CMP_CHECK((component_name != NULL), "component_name error(NULL)", NEX_FAIL)
+    CMP_CHECK((property_name != NULL), "property_name error(NULL)", NEX_FAIL)
+    CMP_CHECK((text != NULL), "text error(NULL)", NEX_FAIL)
+
+#ifdef CONFIG_NEX_COALESCE
+    const coalesce_value_t value = {.text = text, .text_length = strlen(text), .number = 0};
+
+    return nextion_coalesce_set(handle, component_name, property_name, &value);
+#else
+    CMP_LOGW("coalescing disabled: enable CONFIG_NEX_COALESCE");
+
+    return NEX_FAIL;
+#endif
+}
+
+nex_err_t nextion_coalesce_set_value(nextion_t *handle, const char *component_name, int32_t number)
+{
+    return nextion_coalesce_set_property_number(handle, component_name, "val", number);
+}
+
+nex_err_t nextion_coalesce_set_text(nextion_t *handle, const char *component_name, const char *text)
+{
+    return nextion_coalesce_set_property_text(handle, component_name, "txt", text);
+}
+
+nex_err_t nextion_coalesce_flush(nextion_t *handle)
+{
+    CMP_CHECK_HANDLE(handle, NEX_FAIL)
+
+#ifdef CONFIG_NEX_COALESCE
+    return nextion_coalesce_flush_pending(handle);
+#else
+    CMP_LOGW("coalescing disabled: enable CONFIG_NEX_COALESCE");
+
+    return NEX_FAIL;
+#endif
+}
+
+nex_err_t nextion_coalesce_set_period(nextion_t *handle, uint32_t period_ms)
+{
+    CMP_CHECK_HANDLE(handle, NEX_FAIL)
+    CMP_CHECK((pdMS_TO_TICKS(period_ms) > 0), "period_ms error(less than a tick)", NEX_FAIL)
+
+#ifdef CONFIG_NEX_COALESCE
+    nextion_protocol_get_coalescer(handle)->period_ms = period_ms;
+
+    return NEX_OK;
+#else
+    CMP_LOGW("coalescing disabled: enable CONFIG_NEX_COALESCE");
+
+    return NEX_FAIL;
+#endif
+}
+
+#ifdef CONFIG_NEX_COALESCE
+bool nextion_coalesce_init(coalescer_t *coalescer, nextion_t *handle)
+{
+    portMUX_INITIALIZE(&coalescer->lock);
+
+    coalescer->period_ms = CONFIG_NEX_COALESCE_PERIOD_MS;
+    coalescer->head = 0;
+    coalescer->count = 0;
+    coalescer->batch = nextion_batch_begin(handle);
+    coalescer->flush_sync = xSemaphoreCreateMutex();
+
+    if (coalescer->batch == NULL || coalescer->flush_sync == NULL)
+    {
+        nextion_batch_discard(coalescer->batch);
+
+        if (coalescer->flush_sync != NULL)
+        {
+            vSemaphoreDelete(coalescer->flush_sync);
+        }
+
+        return false;
+    }
+
+    if (xTaskCreate(&nextion_coalesce_task,
+                    "nextion_frame",
+                    3072,
+                    (void *)handle,
+                    CONFIG_NEX_UART_TASK_PRIORITY,
+                    &coalescer->task) != pdPASS)
+    {
+        nextion_batch_discard(coalescer->batch);
+        vSemaphoreDelete(coalescer->flush_sync);
+
+        return false;
+    }
+
+    return true;
+}
+
+void nextion_coalesce_deinit(coalescer_t *coalescer)
+{
+    // Never stop the task half way through a flush.
+    xSemaphoreTake(coalescer->flush_sync, portMAX_DELAY);
+
+    vTaskDelete(coalescer->task);
+    vSemaphoreDelete(coalescer->flush_sync);
+    nextion_batch_discard(coalescer->batch);
+}
+
+nex_err_t nextion_coalesce_flush_pending(nextion_t *handle)
+{
+    coalescer_t *coalescer = nextion_protocol_get_coalescer(handle);
+    size_t batch_length = 0;
+    nex_err_t code = NEX_OK;
+    coalesce_entry_t entry;
+
+    // Also keeps the batch to a single flush at a time.
+    xSemaphoreTake(coalescer->flush_sync, portMAX_DELAY);
+
+    // Bounded, as writers may keep adding; what is left goes on the next frame.
+    for (size_t i = 0; i < CONFIG_NEX_COALESCE_SIZE && nextion_coalesce_take(coalescer, &entry); i++)
+    {
+        const size_t length = nextion_coalesce_encoded_length(&entry);
+
+        // Batches refuse to send once overflowed; send it before.
+        if (batch_length > 0 && batch_length + length > CONFIG_NEX_BATCH_BUFFER_SIZE)
+        {
+            code = nextion_coalesce_send(coalescer->batch) == NEX_OK ? code : NEX_FAIL;
+            batch_length = 0;
+        }
+
+        if (nextion_coalesce_add(coalescer->batch, &entry) != NEX_OK)
+        {
+            code = NEX_FAIL;
+
+            continue;
+        }
+
+        batch_length += length;
+    }
+
+    if (batch_length > 0)
+    {
+        code = nextion_coalesce_send(coalescer->batch) == NEX_OK ? code : NEX_FAIL;
+    }
+
+    xSemaphoreGive(coalescer->flush_sync);
+
+    return code;
+}
+
+static nex_err_t nextion_coalesce_set(nextion_t *handle,
+                                      const char *component_name,
+                                      const char *property_name,
+                                      const coalesce_value_t *value)
+{
+    coalescer_t *coalescer = nextion_protocol_get_coalescer(handle);
+    char path[NEXTION_PROPERTY_PATH_MAX_LENGTH + 1];
+    encoder_t encoder;
+
+    encoder_begin(&encoder, path, sizeof(path));
+    encoder_append_property(&encoder, component_name, property_name);
+
+    const bool is_path_valid = encoder_end(&encoder);
+    const bool is_queueable = is_path_valid && value->text_length <= CONFIG_NEX_COALESCE_TEXT_LENGTH;
+    coalesce_entry_t *entry = NULL;
+
+    portENTER_CRITICAL(&coalescer->lock);
+
+    for (size_t i = coalescer->head; is_path_valid && i < coalescer->count; i++)
+    {
+        if (coalescer->entries[i].path_length == encoder.length && memcmp(coalescer->entries[i].path, path, encoder.length) == 0)
+        {
+            entry = &coalescer->entries[i];
+
+            break;
+        }
+    }
+
+    if (!is_queueable && entry != NULL)
+    {
+        // Sent now instead; the older value must not follow it. The others keep their order.
+        memmove(entry, entry + 1, (size_t)(&coalescer->entries[coalescer->count] - (entry + 1)) * sizeof(coalesce_entry_t));
+
+        coalescer->count--;
+        entry = NULL;
+    }
+    else if (is_queueable && entry == NULL && coalescer->count == CONFIG_NEX_COALESCE_SIZE && coalescer->head > 0)
+    {
+        // Rare: only when written while a flush takes the oldest ones.
+        memmove(coalescer->entries,
+                &coalescer->entries[coalescer->head],
+                (coalescer->count - coalescer->head) * sizeof(coalesce_entry_t));
+
+        coalescer->count -= coalescer->head;
+        coalescer->head = 0;
+    }
+
+    if (is_queueable && entry == NULL && coalescer->count < CONFIG_NEX_COALESCE_SIZE)
+    {
+        entry = &coalescer->entries[coalescer->count++];
+
+        entry->component_length = (uint8_t)strlen(component_name);
+        entry->path_length = (uint8_t)encoder.length;
+
+        memcpy(entry->path, path, encoder.length);
+    }
+
+    if (entry != NULL)
+    {
+        entry->is_text = value->text != NULL;
+        entry->number = value->number;
+        entry->text_length = (uint8_t)value->text_length;
+
+        if (value->text != NULL)
+        {
+            memcpy(entry->text, value->text, value->text_length);
+        }
+    }
+
+    portEXIT_CRITICAL(&coalescer->lock);
+
+    if (entry != NULL)
+    {
+        return NEX_OK;
+    }
+
+    // Full, or too long to wait: sent now, after any flush already
+    // in progress, which may hold an older value of this property.
+    xSemaphoreTake(coalescer->flush_sync, portMAX_DELAY);
+
+    nex_err_t code = value->text != NULL
+                         ? nextion_component_set_property_text(handle, component_name, property_name, value->text)
+                         : nextion_component_set_property_number(handle, component_name, property_name, value->number);
+
+    xSemaphoreGive(coalescer->flush_sync);
+
+    return code;
+}
+
+static bool nextion_coalesce_take(coalescer_t *coalescer, coalesce_entry_t *entry)
+{
+    portENTER_CRITICAL(&coalescer->lock);
+
+    const bool has_entry = coalescer->head < coalescer->count;
+
+    // Oldest first, as values may depend on each other, like "vis" and then a value.
+    if (has_entry)
+    {
+        *entry = coalescer->entries[coalescer->head++];
+    }
+
+    if (coalescer->head == coalescer->count)
+    {
+        coalescer->head = 0;
+        coalescer->count = 0;
+    }
+
+    portEXIT_CRITICAL(&coalescer->lock);
+
+    return has_entry;
+}
+
+static size_t nextion_coalesce_encoded_length(const coalesce_entry_t *entry)
+{
+    // "component.property=value" and the end sequence; texts are quoted.
+    const size_t value_length = entry->is_text ? entry->text_length + 2U : COALESCE_NUMBER_MAX_LENGTH;
+
+    return entry->path_length + 1U + value_length + NEX_DVC_CMD_END_LENGTH;
+}
+
+static nex_err_t nextion_coalesce_add(nextion_batch_t *batch, const coalesce_entry_t *entry)
+{
+    char path[NEXTION_PROPERTY_PATH_MAX_LENGTH + 1];
+    char text[CONFIG_NEX_COALESCE_TEXT_LENGTH + 1];
+
+    // "component.property" becomes two strings, split at the dot.
+    memcpy(path, entry->path, entry->path_length);
+
+    path[entry->component_length] = '\0';
+    path[entry->path_length] = '\0';
+
+    const char *component_name = path;
+    const char *property_name = path + entry->component_length + 1;
+
+    if (!entry->is_text)
+    {
+        return nextion_batch_add_property_number(batch, component_name, property_name, entry->number);
+    }
+
+    memcpy(text, entry->text, entry->text_length);
+
+    text[entry->text_length] = '\0';
+
+    return nextion_batch_add_property_text(batch, component_name, property_name, text);
+}
+
+static nex_err_t nextion_coalesce_send(nextion_batch_t *batch)
+{
+    size_t failure_count = 0;
+    nex_err_t code = nextion_batch_send(batch, NULL, 0, &failure_count);
+
+    if (code != NEX_OK)
+    {
+        CMP_LOGW("coalesced values failed: %lu", (unsigned long)failure_count);
+    }
+
+    return code;
+}
+
+static void nextion_coalesce_task(void *pv)
+{
+    nextion_t *handle = (nextion_t *)pv;
+    coalescer_t *coalescer = nextion_protocol_get_coalescer(handle);
+    TickType_t frame_start = xTaskGetTickCount();
+
+    while (true)
+    {
+        vTaskDelayUntil(&frame_start, pdMS_TO_TICKS(coalescer->period_ms));
+
+        // Failures were logged; their values are dropped.
+        if (coalescer->count > 0)
+        {
+            nextion_coalesce_flush_pending(handle);
+        }
+    }
+}
+#endif
\ No newline at end of file
@@ -1,6 +1,23 @@
+#include <malloc.h>
+#include "esp32_driver_nextion/base/constants.h"
 #include "esp32_driver_nextion/component.h"
+#include "esp32_driver_nextion/property.h"
+#include "protocol/parsers/responses/numbers.h"
 #include "protocol/protocol.h"
 #include "assertion.h"
+#include "config.h"
+
+/**
+ * @brief Longest instruction printing a number: "prints component.property,4".
+ */
+#define COMPONENT_PRINT_MAX_LENGTH (sizeof("prints ,4") - 1 + NEXTION_PROPERTY_PATH_MAX_LENGTH)
+
+/**
+ * @brief Most numbers read at once; the whole response must fit in the frame buffer.
+ */
+#define COMPONENT_NUMBERS_MAX_COUNT ((CONFIG_NEX_UART_RECV_FRAME_BUFFER_SIZE - NEX_DVC_CMD_START_LENGTH - NEX_DVC_CMD_END_LENGTH) / sizeof(int32_t))
+
+static void nextion_component_encode_end(encoder_t *encoder);
 
 nex_err_t nextion_component_refresh(nextion_t *handle, const char *component_name_or_id)
 {
@@ -15,7 +32,16 @@ nex_err_t nextion_component_set_visibility(nextion_t *handle, const char *compon
     CMP_CHECK_HANDLE(handle, NEX_FAIL)
     CMP_CHECK((component_name_or_id != NULL), "component_name_or_id error(NULL)", NEX_FAIL)
 
-    return nextion_protocol_send_instruction_ack(handle, "vis %s,%d", component_name_or_id, is_visible);
+    formated_instruction_t instruction;
+    encoder_t encoder;
+
+    nextion_protocol_encoder_begin(&instruction, &encoder);
+    ENCODER_APPEND_LITERAL(&encoder, "vis ");
+    encoder_append_text(&encoder, component_name_or_id);
+    encoder_append_char(&encoder, ',');
+    encoder_append_number(&encoder, is_visible);
+
+    return nextion_protocol_send_encoded_ack(handle, &encoder);
 }
 
 nex_err_t nextion_component_set_visibility_all(nextion_t *handle, bool is_visible)
@@ -30,7 +56,16 @@ nex_err_t nextion_component_set_touchable(nextion_t *handle, const char *compone
     CMP_CHECK_HANDLE(handle, NEX_FAIL)
     CMP_CHECK((component_name_or_id != NULL), "component_name_or_id error(NULL)", NEX_FAIL)
 
-    return nextion_protocol_send_instruction_ack(handle, "tsw %s,%d", component_name_or_id, is_touchable);
+    formated_instruction_t instruction;
+    encoder_t encoder;
+
+    nextion_protocol_encoder_begin(&instruction, &encoder);
+    ENCODER_APPEND_LITERAL(&encoder, "tsw ");
+    encoder_append_text(&encoder, component_name_or_id);
+    encoder_append_char(&encoder, ',');
+    encoder_append_number(&encoder, is_touchable);
+
+    return nextion_protocol_send_encoded_ack(handle, &encoder);
 }
 
 nex_err_t nextion_component_set_touchable_all(nextion_t *handle, bool is_touchable)
@@ -53,6 +88,14 @@ nex_err_t nextion_component_get_value(nextion_t *handle, const char *component_n
     return nextion_component_get_property_number(handle, component_name, "val", number);
 }
 
+nex_err_t nextion_component_get_values(nextion_t *handle,
+                                       const char *const *component_names,
+                                       size_t count,
+                                       int32_t *numbers)
+{
+    return nextion_component_get_property_numbers(handle, component_names, count, "val", numbers);
+}
+
 nex_err_t nextion_component_get_boolean(nextion_t *handle, const char *component_name, bool *value)
 {
     int32_t temp = 0;
@@ -89,10 +132,24 @@ nex_err_t nextion_component_get_property_text(nextion_t *handle,
     CMP_CHECK((property_name != NULL), "property_name error(NULL)", NEX_FAIL)
     CMP_CHECK((buffer != NULL), "buffer error(NULL)", NEX_FAIL)
 
-    return nextion_protocol_send_instruction_get_text(handle,
-                                                      buffer,
-                                                      buffer_length,
-                                                      "get %s.%s", component_name, property_name);
+    formated_instruction_t instruction;
+    encoder_t encoder;
+
+    nextion_protocol_encoder_begin(&instruction, &encoder);
+    ENCODER_APPEND_LITERAL(&encoder, "get ");
+    encoder_append_property(&encoder, component_name, property_name);
+
+    if (!nextion_protocol_end_encoding(&encoder))
+    {
+        return NEX_FAIL;
+    }
+
+    return SHADOW_GET_TEXT(handle,
+                           encoder.buffer,
+                           encoder.length,
+                           CONFIG_NEX_SHADOW_CACHE_READ_TTL_MS,
+                           buffer,
+                           buffer_length);
 }
 
 nex_err_t nextion_component_get_property_number(nextion_t *handle,
@@ -105,7 +162,19 @@ nex_err_t nextion_component_get_property_number(nextion_t *handle,
     CMP_CHECK((property_name != NULL), "property_name error(NULL)", NEX_FAIL)
     CMP_CHECK((number != NULL), "number error(NULL)", NEX_FAIL)
 
-    return nextion_protocol_send_instruction_get_number(handle, number, "get %s.%s", component_name, property_name);
+    formated_instruction_t instruction;
+    encoder_t encoder;
+
+    nextion_protocol_encoder_begin(&instruction, &encoder);
+    ENCODER_APPEND_LITERAL(&encoder, "get ");
+    encoder_append_property(&encoder, component_name, property_name);
+
+    if (!nextion_protocol_end_encoding(&encoder))
+    {
+        return NEX_FAIL;
+    }
+
+    return SHADOW_GET_NUMBER(handle, encoder.buffer, encoder.length, CONFIG_NEX_SHADOW_CACHE_READ_TTL_MS, number);
 }
 
 nex_err_t nextion_component_set_property_text(nextion_t *handle,
@@ -118,7 +187,18 @@ nex_err_t nextion_component_set_property_text(nextion_t *handle,
     CMP_CHECK((property_name != NULL), "property_name error(NULL)", NEX_FAIL)
     CMP_CHECK((text != NULL), "text error(NULL)", NEX_FAIL)
 
-    return nextion_protocol_send_instruction_ack(handle, "%s.%s=\"%s\"", component_name, property_name, text);
+    formated_instruction_t instruction;
+    encoder_t encoder;
+
+    nextion_protocol_encoder_begin(&instruction, &encoder);
+    encoder_append_property(&encoder, component_name, property_name);
+
+    const size_t path_length = encoder.length;
+
+    encoder_append_char(&encoder, '=');
+    encoder_append_quoted(&encoder, text);
+
+    return SHADOW_SEND_TEXT(handle, &encoder, path_length, text);
 }
 
 nex_err_t nextion_component_set_property_number(nextion_t *handle,
@@ -130,5 +210,81 @@ nex_err_t nextion_component_set_property_number(nextion_t *handle,
     CMP_CHECK((component_name != NULL), "component_name error(NULL)", NEX_FAIL)
     CMP_CHECK((property_name != NULL), "property_name error(NULL)", NEX_FAIL)
 
-    return nextion_protocol_send_instruction_ack(handle, "%s.%s=%ld", component_name, property_name, number);
+    formated_instruction_t instruction;
+    encoder_t encoder;
+
+    nextion_protocol_encoder_begin(&instruction, &encoder);
+    encoder_append_property(&encoder, component_name, property_name);
+
+    const size_t path_length = encoder.length;
+
+    encoder_append_char(&encoder, '=');
+    encoder_append_number(&encoder, number);
+
+    return SHADOW_SEND_NUMBER(handle, &encoder, path_length, number);
+}
+
+nex_err_t nextion_component_get_property_numbers(nextion_t *handle,
+                                                 const char *const *component_names,
+                                                 size_t count,
+                                                 const char *property_name,
+                                                 int32_t *numbers)
+{
+    CMP_CHECK_HANDLE(handle, NEX_FAIL)
+    CMP_CHECK((component_names != NULL), "component_names error(NULL)", NEX_FAIL)
+    CMP_CHECK((count > 0), "count error(0)", NEX_FAIL)
+    CMP_CHECK((property_name != NULL), "property_name error(NULL)", NEX_FAIL)
+    CMP_CHECK((numbers != NULL), "numbers error(NULL)", NEX_FAIL)
+    CMP_CHECK((count <= COMPONENT_NUMBERS_MAX_COUNT), "count error(response bigger than the frame buffer)", NEX_FAIL)
+
+    // "printh 72", a "prints" per value and "printh ff ff ff", each with the end sequence.
+    const size_t capacity = sizeof("printh " PARSER_NUMBERS_HEADER_TEXT) - 1
+                            + count * (COMPONENT_PRINT_MAX_LENGTH + NEX_DVC_CMD_END_LENGTH)
+                            + sizeof("printh ff ff ff") - 1
+                            + 2 * NEX_DVC_CMD_END_LENGTH
+                            + 1;
+    char *buffer = (char *)malloc(capacity);
+    encoder_t encoder;
+
+    CMP_CHECK((buffer != NULL), "malloc error(buffer)", NEX_FAIL)
+
+    encoder_begin(&encoder, buffer, capacity);
+    ENCODER_APPEND_LITERAL(&encoder, "printh " PARSER_NUMBERS_HEADER_TEXT);
+    nextion_component_encode_end(&encoder);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        // Always 4 bytes, little-endian, as in a "get" response.
+        ENCODER_APPEND_LITERAL(&encoder, "prints ");
+        encoder_append_property(&encoder, component_names[i] != NULL ? component_names[i] : "", property_name);
+        ENCODER_APPEND_LITERAL(&encoder, ",4");
+        nextion_component_encode_end(&encoder);
+    }
+
+    ENCODER_APPEND_LITERAL(&encoder, "printh ff ff ff");
+    nextion_component_encode_end(&encoder);
+
+    nex_err_t code = NEX_FAIL;
+
+    if (!encoder_end(&encoder))
+    {
+        CMP_LOGE("component error(name too long)");
+    }
+    else
+    {
+        code = nextion_protocol_send_get_numbers(handle, (const uint8_t *)buffer, encoder.length, numbers, count);
+    }
+
+    free(buffer);
+
+    return code;
+}
+
+static void nextion_component_encode_end(encoder_t *encoder)
+{
+    const char END_SEQUENCE[NEX_DVC_CMD_END_LENGTH] = {(char)NEX_DVC_CMD_END_VALUE,
+                                                       (char)NEX_DVC_CMD_END_VALUE,
+                                                       (char)NEX_DVC_CMD_END_VALUE};
+
+    encoder_append(encoder, END_SEQUENCE, NEX_DVC_CMD_END_LENGTH);
 }
\ No newline at end of file
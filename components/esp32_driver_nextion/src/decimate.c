@@ -0,0 +1,246 @@
+#include <math.h>
+#include "esp32_driver_nextion/decimate.h"
+#include "assertion.h"
+
+static size_t nextion_decimate_push_min_max(nextion_decimator_t *decimator, uint8_t sample, uint8_t *output);
+static size_t nextion_decimate_push_lttb(nextion_decimator_t *decimator, uint8_t sample, uint8_t *output);
+static size_t nextion_decimate_write_min_max(nextion_decimator_t *decimator, uint8_t *output);
+static size_t nextion_decimate_select(nextion_decimator_t *decimator, float next_x, float next_y);
+static void nextion_decimate_reset(nextion_decimator_t *decimator);
+
+nex_err_t nextion_decimate_init(nextion_decimator_t *decimator,
+                                nextion_decimate_mode_t mode,
+                                size_t window_length,
+                                uint16_t width,
+                                uint8_t *buffer,
+                                size_t buffer_length)
+{
+    CMP_CHECK((decimator != NULL), "decimator error(NULL)", NEX_FAIL)
+    CMP_CHECK((mode == NEXTION_DECIMATE_MIN_MAX || mode == NEXTION_DECIMATE_LTTB), "mode error", NEX_FAIL)
+    CMP_CHECK((width > 1), "width error(<2)", NEX_FAIL)
+    CMP_CHECK((window_length >= 2U * width), "window_length error(<2*width)", NEX_FAIL)
+
+    decimator->mode = mode;
+
+    if (mode == NEXTION_DECIMATE_MIN_MAX)
+    {
+        // Every bucket takes two pixels: its minimum and maximum.
+        decimator->bucket_length = window_length / (width / 2U);
+        decimator->filling = NULL;
+        decimator->pending = NULL;
+    }
+    else
+    {
+        CMP_CHECK((buffer != NULL), "buffer error(NULL)", NEX_FAIL)
+        CMP_CHECK((buffer_length >= NEXTION_DECIMATE_LTTB_BUFFER_LENGTH(window_length, width)), "buffer_length error(<NEXTION_DECIMATE_LTTB_BUFFER_LENGTH)", NEX_FAIL)
+
+        // A bucket is reduced only once the next one is filled.
+        decimator->bucket_length = window_length / width;
+        decimator->filling = buffer;
+        decimator->pending = buffer + decimator->bucket_length;
+    }
+
+    nextion_decimate_reset(decimator);
+
+    return NEX_OK;
+}
+
+size_t nextion_decimate_max_output(const nextion_decimator_t *decimator, size_t sample_count)
+{
+    CMP_CHECK((decimator != NULL), "decimator error(NULL)", 0)
+
+    // Buckets completed, plus the one partially filled before
+    // and, on LTTB, the first sample or the last on a flush.
+    const size_t bucket_count = sample_count / decimator->bucket_length + 2U;
+
+    return decimator->mode == NEXTION_DECIMATE_MIN_MAX ? 2U * bucket_count : bucket_count;
+}
+
+size_t nextion_decimate_push(nextion_decimator_t *decimator,
+                             const uint8_t *samples,
+                             size_t sample_count,
+                             uint8_t *output)
+{
+    CMP_CHECK((decimator != NULL), "decimator error(NULL)", 0)
+    CMP_CHECK((samples != NULL), "samples error(NULL)", 0)
+    CMP_CHECK((output != NULL), "output error(NULL)", 0)
+
+    size_t output_length = 0;
+
+    if (decimator->mode == NEXTION_DECIMATE_MIN_MAX)
+    {
+        for (size_t i = 0; i < sample_count; i++)
+        {
+            output_length += nextion_decimate_push_min_max(decimator, samples[i], output + output_length);
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < sample_count; i++)
+        {
+            output_length += nextion_decimate_push_lttb(decimator, samples[i], output + output_length);
+        }
+    }
+
+    return output_length;
+}
+
+size_t nextion_decimate_flush(nextion_decimator_t *decimator, uint8_t *output)
+{
+    CMP_CHECK((decimator != NULL), "decimator error(NULL)", 0)
+    CMP_CHECK((output != NULL), "output error(NULL)", 0)
+
+    size_t output_length = 0;
+
+    if (decimator->mode == NEXTION_DECIMATE_MIN_MAX)
+    {
+        output_length = decimator->count > 0 ? nextion_decimate_write_min_max(decimator, output) : 0;
+    }
+    else
+    {
+        if (decimator->has_pending)
+        {
+            // Without a next bucket, the triangle closes on the last sample.
+            const bool has_next = decimator->count > 0;
+            const float next_x = has_next ? decimator->bucket_length + (decimator->count - 1U) / 2.0f : decimator->bucket_length - 1.0f;
+            const float next_y = has_next ? (float)decimator->sum / decimator->count : decimator->pending[decimator->bucket_length - 1U];
+
+            output[output_length++] = decimator->pending[nextion_decimate_select(decimator, next_x, next_y)];
+        }
+
+        // The last sample is always kept.
+        if (decimator->count > 0)
+        {
+            output[output_length++] = decimator->filling[decimator->count - 1U];
+        }
+    }
+
+    nextion_decimate_reset(decimator);
+
+    return output_length;
+}
+
+static size_t nextion_decimate_push_min_max(nextion_decimator_t *decimator, uint8_t sample, uint8_t *output)
+{
+    if (decimator->count == 0)
+    {
+        decimator->min = sample;
+        decimator->max = sample;
+        decimator->is_min_first = true;
+    }
+    else if (sample < decimator->min)
+    {
+        decimator->min = sample;
+        decimator->is_min_first = false;
+    }
+    else if (sample > decimator->max)
+    {
+        decimator->max = sample;
+        decimator->is_min_first = true;
+    }
+
+    if (++decimator->count < decimator->bucket_length)
+    {
+        return 0;
+    }
+
+    const size_t output_length = nextion_decimate_write_min_max(decimator, output);
+
+    decimator->count = 0;
+
+    return output_length;
+}
+
+static size_t nextion_decimate_push_lttb(nextion_decimator_t *decimator, uint8_t sample, uint8_t *output)
+{
+    size_t output_length = 0;
+
+    // The first sample is always kept.
+    if (!decimator->has_anchor)
+    {
+        decimator->has_anchor = true;
+        decimator->anchor_x = -1.0f;
+        decimator->anchor_y = sample;
+
+        output[0] = sample;
+
+        return 1;
+    }
+
+    decimator->filling[decimator->count++] = sample;
+    decimator->sum += sample;
+
+    if (decimator->count < decimator->bucket_length)
+    {
+        return 0;
+    }
+
+    if (decimator->has_pending)
+    {
+        // The triangle closes on the average of the bucket just filled.
+        const float next_x = decimator->bucket_length + (decimator->bucket_length - 1U) / 2.0f;
+        const float next_y = (float)decimator->sum / decimator->bucket_length;
+        const size_t selected = nextion_decimate_select(decimator, next_x, next_y);
+
+        output[output_length++] = decimator->pending[selected];
+
+        // Positions are relative to the waiting bucket, which is about to move a bucket forward.
+        decimator->anchor_x = (float)selected - decimator->bucket_length;
+        decimator->anchor_y = decimator->pending[selected];
+    }
+
+    uint8_t *filled = decimator->filling;
+
+    decimator->filling = decimator->pending;
+    decimator->pending = filled;
+    decimator->has_pending = true;
+    decimator->count = 0;
+    decimator->sum = 0;
+
+    return output_length;
+}
+
+static size_t nextion_decimate_write_min_max(nextion_decimator_t *decimator, uint8_t *output)
+{
+    // Kept in the order they came, so the trace shape is not mirrored.
+    output[0] = decimator->is_min_first ? decimator->min : decimator->max;
+    output[1] = decimator->is_min_first ? decimator->max : decimator->min;
+
+    return 2;
+}
+
+static size_t nextion_decimate_select(nextion_decimator_t *decimator, float next_x, float next_y)
+{
+    const float anchor_x = decimator->anchor_x;
+    const float anchor_y = decimator->anchor_y;
+    size_t selected = 0;
+    float selected_area = -1.0f;
+
+    // Twice the area of the triangle formed with the last sample selected and
+    // the next bucket; the largest keeps the most visible change, like peaks.
+    for (size_t i = 0; i < decimator->bucket_length; i++)
+    {
+        const float area = fabsf((anchor_x - next_x) * (decimator->pending[i] - anchor_y) - (anchor_x - (float)i) * (next_y - anchor_y));
+
+        if (area > selected_area)
+        {
+            selected = i;
+            selected_area = area;
+        }
+    }
+
+    return selected;
+}
+
+static void nextion_decimate_reset(nextion_decimator_t *decimator)
+{
+    decimator->count = 0;
+    decimator->min = 0;
+    decimator->max = 0;
+    decimator->is_min_first = true;
+    decimator->sum = 0;
+    decimator->has_pending = false;
+    decimator->has_anchor = false;
+    decimator->anchor_x = 0.0f;
+    decimator->anchor_y = 0;
+}
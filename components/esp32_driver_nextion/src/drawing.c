@@ -2,11 +2,24 @@
 #include "protocol/protocol.h"
 #include "assertion.h"
 
+/**
+ * @brief Send a drawing instruction: a command followed by its numeric parameters.
+ */
+#define DRAW_SEND(handle, command, parameters) nextion_draw_send(handle, command, sizeof(command) - 1, parameters, sizeof(parameters) / sizeof(parameters[0]))
+
+static nex_err_t nextion_draw_send(nextion_t *handle,
+                                   const char *command,
+                                   size_t command_length,
+                                   const int32_t *parameters,
+                                   size_t parameter_count);
+
 nex_err_t nextion_draw_fill_screen(nextion_t *handle, rgb565_t color)
 {
     CMP_CHECK_HANDLE(handle, NEX_FAIL)
 
-    return nextion_protocol_send_instruction_ack(handle, "cls %d", color);
+    const int32_t parameters[] = {color};
+
+    return DRAW_SEND(handle, "cls ", parameters);
 }
 
 nex_err_t nextion_draw_fill_area(nextion_t *handle,
@@ -15,13 +28,13 @@ nex_err_t nextion_draw_fill_area(nextion_t *handle,
 {
     CMP_CHECK_HANDLE(handle, NEX_FAIL)
 
-    return nextion_protocol_send_instruction_ack(handle,
-                                                 "fill %d,%d,%d,%d,%d",
-                                                 area.upper_left.x,
-                                                 area.upper_left.y,
-                                                 area.bottom_right.x - area.upper_left.x,
-                                                 area.bottom_right.y - area.upper_left.y,
-                                                 color);
+    const int32_t parameters[] = {area.upper_left.x,
+                                  area.upper_left.y,
+                                  area.bottom_right.x - area.upper_left.x,
+                                  area.bottom_right.y - area.upper_left.y,
+                                  color};
+
+    return DRAW_SEND(handle, "fill ", parameters);
 }
 
 nex_err_t nextion_draw_fill_circle(nextion_t *handle,
@@ -31,12 +44,12 @@ nex_err_t nextion_draw_fill_circle(nextion_t *handle,
 {
     CMP_CHECK_HANDLE(handle, NEX_FAIL)
 
-    return nextion_protocol_send_instruction_ack(handle,
-                                                 "cirs %d,%d,%d,%d",
-                                                 center.x,
-                                                 center.y,
-                                                 radius,
-                                                 color);
+    const int32_t parameters[] = {center.x,
+                                  center.y,
+                                  radius,
+                                  color};
+
+    return DRAW_SEND(handle, "cirs ", parameters);
 }
 
 nex_err_t nextion_draw_line(nextion_t *handle,
@@ -45,13 +58,13 @@ nex_err_t nextion_draw_line(nextion_t *handle,
 {
     CMP_CHECK_HANDLE(handle, NEX_FAIL)
 
-    return nextion_protocol_send_instruction_ack(handle,
-                                                 "line %d,%d,%d,%d,%d",
-                                                 area.upper_left.x,
-                                                 area.upper_left.y,
-                                                 area.bottom_right.x - area.upper_left.x,
-                                                 area.bottom_right.y - area.upper_left.y,
-                                                 color);
+    const int32_t parameters[] = {area.upper_left.x,
+                                  area.upper_left.y,
+                                  area.bottom_right.x - area.upper_left.x,
+                                  area.bottom_right.y - area.upper_left.y,
+                                  color};
+
+    return DRAW_SEND(handle, "line ", parameters);
 }
 
 nex_err_t nextion_draw_rectangle(nextion_t *handle,
@@ -60,13 +73,13 @@ nex_err_t nextion_draw_rectangle(nextion_t *handle,
 {
     CMP_CHECK_HANDLE(handle, NEX_FAIL)
 
-    return nextion_protocol_send_instruction_ack(handle,
-                                                 "draw %d,%d,%d,%d,%d",
-                                                 area.upper_left.x,
-                                                 area.upper_left.y,
-                                                 area.bottom_right.x - area.upper_left.x,
-                                                 area.bottom_right.y - area.upper_left.y,
-                                                 color);
+    const int32_t parameters[] = {area.upper_left.x,
+                                  area.upper_left.y,
+                                  area.bottom_right.x - area.upper_left.x,
+                                  area.bottom_right.y - area.upper_left.y,
+                                  color};
+
+    return DRAW_SEND(handle, "draw ", parameters);
 }
 
 nex_err_t nextion_draw_circle(nextion_t *handle,
@@ -76,12 +89,12 @@ nex_err_t nextion_draw_circle(nextion_t *handle,
 {
     CMP_CHECK_HANDLE(handle, NEX_FAIL)
 
-    return nextion_protocol_send_instruction_ack(handle,
-                                                 "cir %d,%d,%d,%d",
-                                                 center.x,
-                                                 center.y,
-                                                 radius,
-                                                 color);
+    const int32_t parameters[] = {center.x,
+                                  center.y,
+                                  radius,
+                                  color};
+
+    return DRAW_SEND(handle, "cir ", parameters);
 }
 
 nex_err_t nextion_draw_picture(nextion_t *handle,
@@ -91,11 +104,11 @@ nex_err_t nextion_draw_picture(nextion_t *handle,
 {
     CMP_CHECK_HANDLE(handle, NEX_FAIL)
 
-    return nextion_protocol_send_instruction_ack(handle,
-                                                 "pic %d,%d,%d",
-                                                 origin.x,
-                                                 origin.y,
-                                                 picture_id);
+    const int32_t parameters[] = {origin.x,
+                                  origin.y,
+                                  picture_id};
+
+    return DRAW_SEND(handle, "pic ", parameters);
 }
 
 nex_err_t nextion_draw_crop_picture(nextion_t *handle,
@@ -105,15 +118,15 @@ nex_err_t nextion_draw_crop_picture(nextion_t *handle,
 {
     CMP_CHECK_HANDLE(handle, NEX_FAIL)
 
-    return nextion_protocol_send_instruction_ack(handle,
-                                                 "xpic %d,%d,%d,%d,%d,%d,%d",
-                                                 crop_area.upper_left.x,
-                                                 crop_area.upper_left.y,
-                                                 crop_area.bottom_right.x - crop_area.upper_left.x,
-                                                 crop_area.bottom_right.y - crop_area.upper_left.y,
-                                                 destination.x,
-                                                 destination.y,
-                                                 picture_id);
+    const int32_t parameters[] = {crop_area.upper_left.x,
+                                  crop_area.upper_left.y,
+                                  crop_area.bottom_right.x - crop_area.upper_left.x,
+                                  crop_area.bottom_right.y - crop_area.upper_left.y,
+                                  destination.x,
+                                  destination.y,
+                                  picture_id};
+
+    return DRAW_SEND(handle, "xpic ", parameters);
 }
 
 nex_err_t nextion_draw_text(nextion_t *handle,
@@ -134,17 +147,40 @@ nex_err_t nextion_draw_text(nextion_t *handle,
         background_value = background.color;
     }
 
-    return nextion_protocol_send_instruction_ack(handle,
-                                                 "xstr %d,%d,%d,%d,%d,%d,%d,%d,%d,%d,\"%s\"",
-                                                 area.upper_left.x,
-                                                 area.upper_left.y,
-                                                 area.bottom_right.x - area.upper_left.x,
-                                                 area.upper_left.y,
-                                                 font.id,
-                                                 font.color,
-                                                 background_value,
-                                                 alignment.horizontal,
-                                                 alignment.vertical,
-                                                 background.fill_mode,
-                                                 text);
+    const int32_t parameters[] = {area.upper_left.x,
+                                  area.upper_left.y,
+                                  area.bottom_right.x - area.upper_left.x,
+                                  area.upper_left.y,
+                                  font.id,
+                                  font.color,
+                                  background_value,
+                                  alignment.horizontal,
+                                  alignment.vertical,
+                                  background.fill_mode};
+    formated_instruction_t instruction;
+    encoder_t encoder;
+
+    nextion_protocol_encoder_begin(&instruction, &encoder);
+    ENCODER_APPEND_LITERAL(&encoder, "xstr ");
+    encoder_append_numbers(&encoder, parameters, sizeof(parameters) / sizeof(parameters[0]));
+    encoder_append_char(&encoder, ',');
+    encoder_append_quoted(&encoder, text);
+
+    return nextion_protocol_send_encoded_ack(handle, &encoder);
+}
+
+static nex_err_t nextion_draw_send(nextion_t *handle,
+                                   const char *command,
+                                   size_t command_length,
+                                   const int32_t *parameters,
+                                   size_t parameter_count)
+{
+    formated_instruction_t instruction;
+    encoder_t encoder;
+
+    nextion_protocol_encoder_begin(&instruction, &encoder);
+    encoder_append(&encoder, command, command_length);
+    encoder_append_numbers(&encoder, parameters, parameter_count);
+
+    return nextion_protocol_send_encoded_ack(handle, &encoder);
 }
\ No newline at end of file
@@ -29,7 +29,15 @@ nex_err_t nextion_eeprom_write_number(nextion_t *handle,
     CMP_CHECK_EEPROM_ADDRESS(address)
     CMP_CHECK_EEPROM_END_ADDRESS(address + 4)
 
-    return nextion_protocol_send_instruction_ack(handle, "wepo %ld,%d", value, address);
+    const int32_t parameters[] = {value, address};
+    formated_instruction_t instruction;
+    encoder_t encoder;
+
+    nextion_protocol_encoder_begin(&instruction, &encoder);
+    ENCODER_APPEND_LITERAL(&encoder, "wepo ");
+    encoder_append_numbers(&encoder, parameters, 2);
+
+    return nextion_protocol_send_encoded_ack(handle, &encoder);
 }
 
 nex_err_t nextion_eeprom_read_text(nextion_t *handle,
@@ -83,16 +91,22 @@ nex_err_t nextion_eeprom_read_bytes(nextion_t *handle,
     // It will always read exactly what it is asked,
     // adding zeros if no more data is available.
     // No return code sent.
+    const int32_t parameters[] = {address, (int32_t)buffer_length};
     formated_instruction_t instruction;
+    encoder_t encoder;
 
-    if (!nextion_protocol_format_instruction(handle, &instruction, "rept %d,%d", address, buffer_length))
+    nextion_protocol_encoder_begin(&instruction, &encoder);
+    ENCODER_APPEND_LITERAL(&encoder, "rept ");
+    encoder_append_numbers(&encoder, parameters, 2);
+
+    if (!encoder_end(&encoder))
     {
         return NEX_FAIL;
     }
 
     parser_t parser = PARSER_REPT(buffer, buffer_length);
 
-    nextion_protocol_send_instruction(handle, instruction.text, instruction.length, &parser);
+    nextion_protocol_send_instruction(handle, encoder.buffer, encoder.length, &parser);
 
     return NEX_OK;
 }
@@ -104,12 +118,26 @@ nex_err_t nextion_eeprom_stream_begin(nextion_t *handle, uint16_t address, size_
     CMP_CHECK_EEPROM_END_ADDRESS(address + value_count)
     CMP_CHECK((value_count < (NEX_DVC_TRANSPARENT_DATA_MAX_DATA_SIZE - 20)), "value_count error(>=NEX_DVC_TRANSPARENT_DATA_MAX_DATA_SIZE-20)", NEX_FAIL)
 
-    return nextion_protocol_send_instruction_tdm_start(handle, "wept %d,%d", address, value_count);
+    const int32_t parameters[] = {address, (int32_t)value_count};
+    formated_instruction_t instruction;
+    encoder_t encoder;
+
+    nextion_protocol_encoder_begin(&instruction, &encoder);
+    ENCODER_APPEND_LITERAL(&encoder, "wept ");
+    encoder_append_numbers(&encoder, parameters, 2);
+
+    return nextion_protocol_send_encoded_tdm_start(handle, &encoder, value_count);
+}
+
+nex_err_t nextion_eeprom_stream_write(nextion_t *handle, uint8_t value)
+{
+    return nextion_eeprom_stream_write_buffer(handle, &value, 1);
 }
 
-nex_err_t nextion_eeprom_stream_write(const nextion_t *handle, uint8_t value)
+nex_err_t nextion_eeprom_stream_write_buffer(nextion_t *handle, const uint8_t *values, size_t value_count)
 {
     CMP_CHECK_HANDLE(handle, NEX_FAIL)
+    CMP_CHECK((values != NULL), "values error(NULL)", NEX_FAIL)
 
-    return nextion_protocol_send_raw_byte(handle, value);
+    return nextion_protocol_send_tdm_data(handle, values, value_count);
 }
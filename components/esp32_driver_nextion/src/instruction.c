@@ -0,0 +1,66 @@
+#include "esp32_driver_nextion/instruction.h"
+#include "protocol/parsers/responses/ack.h"
+#include "protocol/parsers/responses/number.h"
+#include "protocol/parsers/responses/text.h"
+#include "protocol/protocol.h"
+#include "shadow_cache.h"
+#include "assertion.h"
+
+nex_err_t nextion_instruction_send(nextion_t *handle, const char *instruction, size_t instruction_length)
+{
+    CMP_CHECK_HANDLE(handle, NEX_FAIL)
+    CMP_CHECK((instruction != NULL), "instruction error(NULL)", NEX_FAIL)
+
+    parser_t parser = PARSER_ACK();
+
+    nex_err_t code = nextion_protocol_send_instruction(handle, instruction, instruction_length, &parser);
+
+    // Written as is, so it may have changed a value remembered; even failing, part may have run.
+    SHADOW_FORGET_ASSIGNMENT(handle, instruction, instruction_length);
+
+    return code;
+}
+
+nex_err_t nextion_instruction_send_get_number(nextion_t *handle,
+                                              const char *instruction,
+                                              size_t instruction_length,
+                                              int32_t *number)
+{
+    CMP_CHECK_HANDLE(handle, NEX_FAIL)
+    CMP_CHECK((instruction != NULL), "instruction error(NULL)", NEX_FAIL)
+    CMP_CHECK((number != NULL), "number error(NULL)", NEX_FAIL)
+
+    parser_t parser = PARSER_NUMBER(number, sizeof(int32_t));
+
+    nex_err_t code = nextion_protocol_send_instruction(handle, instruction, instruction_length, &parser);
+
+    if (code == NEX_DVC_RSP_GET_NUMBER)
+    {
+        return NEX_OK;
+    }
+
+    return code;
+}
+
+nex_err_t nextion_instruction_send_get_text(nextion_t *handle,
+                                            const char *instruction,
+                                            size_t instruction_length,
+                                            char *buffer,
+                                            size_t buffer_length)
+{
+    CMP_CHECK_HANDLE(handle, NEX_FAIL)
+    CMP_CHECK((instruction != NULL), "instruction error(NULL)", NEX_FAIL)
+    CMP_CHECK((buffer != NULL), "buffer error(NULL)", NEX_FAIL)
+    CMP_CHECK((buffer_length > 0), "buffer_length error(0)", NEX_FAIL)
+
+    parser_t parser = PARSER_TEXT(buffer, buffer_length);
+
+    nex_err_t code = nextion_protocol_send_instruction(handle, instruction, instruction_length, &parser);
+
+    if (code == NEX_DVC_RSP_GET_TEXT)
+    {
+        return NEX_OK;
+    }
+
+    return code;
+}
\ No newline at end of file
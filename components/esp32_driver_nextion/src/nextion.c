@@ -1,11 +1,18 @@
 #include <malloc.h>
 #include <stdarg.h>
+#include <string.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
+#include "esp32_driver_nextion/base/constants.h"
 #include "esp32_driver_nextion/base/events.h"
+#include "esp32_driver_nextion/async.h"
 #include "esp32_driver_nextion/nextion.h"
 #include "esp32_driver_nextion/system.h"
+#include "protocol/parsers/events/tdm_stop.h"
 #include "protocol/parsers/responses/ack.h"
+#include "protocol/parsers/responses/numbers.h"
+#include "protocol/parsers/responses/tdm_start.h"
+#include "protocol/frame_assembler.h"
 #include "protocol/protocol.h"
 #include "protocol/event.h"
 #include "assertion.h"
@@ -13,9 +20,75 @@
 
 #define PROCESS_SYNC_TAKE(handle, timeout) (xSemaphoreTake(handle->send_instruction_sync, timeout) == pdTRUE)
 #define PROCESS_SYNC_GIVE(handle) xSemaphoreGive(handle->send_instruction_sync)
+#ifdef CONFIG_NEX_STATS
+// Try without waiting first, so contention can be counted.
+#define PROCESS_SYNC_TAKE_TIMED(handle, timeout, timer) (PROCESS_SYNC_TAKE(handle, 0) || (STATS_TIMER_CONTENDED(timer), PROCESS_SYNC_TAKE(handle, timeout)))
+#else
+#define PROCESS_SYNC_TAKE_TIMED(handle, timeout, timer) PROCESS_SYNC_TAKE(handle, timeout)
+#endif
+#define UNCONFIRMED_INSTRUCTION_LENGTH 32
+#define IS_FIRE_AND_FORGET(handle, parser) (PARSER_IS_ACK(parser) && ((handle)->response_mode == NEXTION_RESPONSE_NONE || (handle)->response_mode == NEXTION_RESPONSE_FAILURE))
 
+/**
+ * @typedef pending_instruction_t
+ * @brief An asynchronous instruction waiting for its response.
+ */
+typedef struct
+{
+    parser_t parser;                   /*!< Parser responsible for parsing the response. */
+    nextion_async_callback_t callback; /*!< Function called on completion. */
+    void *context;                     /*!< User context passed to the callback. */
+    uint8_t success_code;              /*!< Response code that means success. */
+} pending_instruction_t;
+
+/**
+ * @typedef unconfirmed_instruction_t
+ * @brief An instruction not waited on, that may still fail.
+ */
+typedef struct
+{
+    char instruction[UNCONFIRMED_INSTRUCTION_LENGTH]; /*!< Beginning of the instruction, null-terminated. */
+    TickType_t sent_at;                               /*!< When the instruction was written. */
+} unconfirmed_instruction_t;
+
+static const nextion_baud_rate_t BAUD_RATES[] = {NEXTION_BAUD_RATE_2400,
+                                                  NEXTION_BAUD_RATE_4800,
+                                                  NEXTION_BAUD_RATE_9600,
+                                                  NEXTION_BAUD_RATE_19200,
+                                                  NEXTION_BAUD_RATE_31250,
+                                                  NEXTION_BAUD_RATE_38400,
+                                                  NEXTION_BAUD_RATE_57600,
+                                                  NEXTION_BAUD_RATE_115200,
+                                                  NEXTION_BAUD_RATE_230400,
+                                                  NEXTION_BAUD_RATE_250000,
+                                                  NEXTION_BAUD_RATE_256000,
+                                                  NEXTION_BAUD_RATE_512000,
+                                                  NEXTION_BAUD_RATE_921600};
+
+static void nextion_core_start(nextion_t *handle);
+static void nextion_core_stop(nextion_t *handle);
+static uint32_t nextion_core_detect_baud_rate(nextion_t *handle);
+static bool nextion_core_probe_baud_rate(nextion_t *handle, uint32_t baud_rate);
+static bool nextion_core_set_uart_baud_rate(nextion_t *handle, uint32_t baud_rate);
 static nex_err_t nextion_core_process_response(nextion_t *handle, const parser_t *parser);
+static void nextion_core_wait_pending(nextion_t *handle, size_t max_pending);
+static void nextion_core_complete_pending(nextion_t *handle, nex_err_t code);
+static void nextion_core_expire_pending(nextion_t *handle);
+static TickType_t nextion_core_pending_wait_time(const nextion_t *handle);
+static void nextion_core_track_unconfirmed(nextion_t *handle, const char *instruction, size_t instruction_length);
+static void nextion_core_prune_unconfirmed(nextion_t *handle);
+static void nextion_core_settle_unconfirmed(nextion_t *handle);
+static bool nextion_core_is_late_failure(nextion_t *handle);
+static void nextion_core_report_failure(nextion_t *handle, nex_err_t code);
 static void nextion_core_process_events(nextion_t *handle);
+static void nextion_core_add_batch_failure(nextion_batch_failure_t *failures,
+                                           size_t failures_length,
+                                           size_t *failure_count,
+                                           size_t index,
+                                           nex_err_t code);
+static bool nextion_core_write_instruction(nextion_t *handle, const char *instruction, size_t instruction_length);
+static int nextion_core_receive(nextion_t *handle, TickType_t timeout);
+static void nextion_core_discard_input(nextion_t *handle);
 static void nextion_core_uart_task(void *pvParameters);
 
 /**
@@ -24,50 +97,87 @@ static void nextion_core_uart_task(void *pvParameters);
  */
 struct nextion_t
 {
-    uint8_t uart_buffer[64];                                                 /*!< Buffer to process received UART data. */
-    uint8_t format_buffer[CONFIG_NEX_UART_TRANS_COMMAND_FORMAT_BUFFER_SIZE]; /*!< Buffer to format instructions. */
+    frame_assembler_t rx_assembler;                                          /*!< Assembles frames from received UART data. */
+    uint8_t write_buffer[CONFIG_NEX_UART_TRANS_COMMAND_FORMAT_BUFFER_SIZE
+                         + NEX_DVC_CMD_END_LENGTH];                          /*!< Buffer to join an instruction and its end sequence. */
     uint8_t event_buffer[EVENT_PARSE_BUFFER_SIZE];                           /*!< Buffer to parse events. */
     SemaphoreHandle_t send_instruction_sync;                                 /*!< Mutex used for sending instruction. */
-    QueueHandle_t uart_queue;                                                /*!< Queue used for UART event. */
-    TaskHandle_t uart_task;                                                  /*!< Task used for UART queue handling. */
-    uart_port_t uart_num;                                                    /*!< UART port number. */
+    nextion_transport_t *transport;                                          /*!< Byte stream connected to the display. */
+    TaskHandle_t uart_task;                                                  /*!< Task used for transport event handling. */
+    pending_instruction_t pending[CONFIG_NEX_ASYNC_QUEUE_SIZE];              /*!< Asynchronous instructions waiting for a response, oldest first. */
+    size_t pending_head;                                                     /*!< Index of the oldest pending instruction. */
+    size_t pending_count;                                                    /*!< Number of pending instructions. */
+    TickType_t pending_deadline;                                             /*!< When the oldest pending instruction times out. */
+    unconfirmed_instruction_t unconfirmed[CONFIG_NEX_ASYNC_QUEUE_SIZE];      /*!< Instructions not waited on that may still fail, oldest first. */
+    size_t unconfirmed_head;                                                 /*!< Index of the oldest unconfirmed instruction. */
+    size_t unconfirmed_count;                                                /*!< Number of unconfirmed instructions. */
+    nextion_response_mode_t response_mode;                                   /*!< Which instruction results the device returns. */
+    nextion_failure_callback_t failure_callback;                             /*!< Function called on late failures. */
+    void *failure_context;                                                   /*!< User context passed to the failure callback. */
+    uint32_t baud_rate;                                                      /*!< UART baud rate. */
+    size_t tdm_remaining;                                                    /*!< Bytes the device still expects on the Transparent Data Mode. */
+#ifdef CONFIG_NEX_STATS
+    stats_collector_t stats;                                                 /*!< Instruction statistics. */
+#endif
+#ifdef CONFIG_NEX_SHADOW_CACHE
+    shadow_cache_t shadow;                                                   /*!< Component property values acknowledged. */
+#endif
+#ifdef CONFIG_NEX_COALESCE
+    coalescer_t coalescer;                                                   /*!< Component property writes waiting for the next frame. */
+#endif
+#ifdef CONFIG_NEX_WAVEFORM_PUMP
+    waveform_pump_t pump;                                                    /*!< Waveform samples waiting to be streamed. */
+#endif
     bool is_installed;                                                       /*!< If the driver was installed. */
     bool is_initialized;                                                     /*!< If the driver was initialized. */
 };
 
+#ifndef CONFIG_IDF_TARGET_LINUX
 nextion_t *nextion_driver_install(uart_port_t uart_num, uint32_t baud_rate, gpio_num_t tx_io_num, gpio_num_t rx_io_num)
 {
-    CMP_CHECK((baud_rate >= NEX_SERIAL_BAUD_RATE_MIN || baud_rate <= NEX_SERIAL_BAUD_RATE_MAX), "baud_rate error", NULL)
+    CMP_CHECK((baud_rate >= NEX_SERIAL_BAUD_RATE_MIN && baud_rate <= NEX_SERIAL_BAUD_RATE_MAX), "baud_rate error", NULL)
 
     CMP_LOGI("installing driver on uart %d with baud rate %lu", uart_num, baud_rate);
 
-    const uart_config_t uart_config = {
-        .baud_rate = (int)baud_rate,
-        .data_bits = UART_DATA_8_BITS,
-        .parity = UART_PARITY_DISABLE,
-        .stop_bits = UART_STOP_BITS_1,
-        .flow_ctrl = UART_HW_FLOWCTRL_DISABLE};
+    nextion_transport_t *transport = nextion_transport_uart_create(uart_num, baud_rate, tx_io_num, rx_io_num);
+
+    CMP_CHECK((transport != NULL), "transport error(NULL)", NULL)
 
-    // Do not change the UART initialization order.
-    // This order was gotten from: https://docs.espressif.com/projects/esp-idf/en/latest/esp32/api-reference/peripherals/uart.html
-    // Trying to follow the examples on the github site (https://github.com/espressif/esp-idf/tree/master/examples/peripherals/uart)
-    // will lead to error.
+    nextion_t *driver = nextion_driver_install_transport(transport, baud_rate);
 
-    ESP_ERROR_CHECK(uart_param_config(uart_num, &uart_config));
-    ESP_ERROR_CHECK(uart_set_pin(uart_num, tx_io_num, rx_io_num, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE));
+    // Nobody else holds the transport.
+    if (driver == NULL)
+    {
+        transport->destroy(transport);
+    }
+
+    return driver;
+}
+#endif
+
+nextion_t *nextion_driver_install_transport(nextion_transport_t *transport, uint32_t baud_rate)
+{
+    CMP_CHECK((transport != NULL), "transport error(NULL)", NULL)
+    CMP_CHECK((baud_rate >= NEX_SERIAL_BAUD_RATE_MIN && baud_rate <= NEX_SERIAL_BAUD_RATE_MAX), "baud_rate error", NULL)
 
     nextion_t *driver = (nextion_t *)calloc(1, sizeof(nextion_t));
-    driver->uart_num = uart_num;
+
+    CMP_CHECK((driver != NULL), "calloc error(driver)", NULL)
+
+    driver->transport = transport;
+    driver->baud_rate = baud_rate;
     driver->is_installed = true;
     driver->is_initialized = false;
+    driver->response_mode = NEXTION_RESPONSE_ALL;
     driver->send_instruction_sync = xSemaphoreCreateBinary();
 
-    ESP_ERROR_CHECK(uart_driver_install(uart_num,
-                                        CONFIG_NEX_UART_RECV_BUFFER_SIZE, // Receive buffer size.
-                                        0,                                // Transmit buffer size.
-                                        10,                               // Queue size.
-                                        &driver->uart_queue,              // Queue pointer.
-                                        0));                              // Allocation flags.
+#ifdef CONFIG_NEX_STATS
+    nextion_stats_collector_init(&driver->stats);
+#endif
+
+#ifdef CONFIG_NEX_SHADOW_CACHE
+    nextion_shadow_init(&driver->shadow);
+#endif
 
     if (xTaskCreate(&nextion_core_uart_task,
                     "nextion",
@@ -81,6 +191,24 @@ nextion_t *nextion_driver_install(uart_port_t uart_num, uint32_t baud_rate, gpio
         abort();
     }
 
+#ifdef CONFIG_NEX_COALESCE
+    if (!nextion_coalesce_init(&driver->coalescer, driver))
+    {
+        CMP_LOGE("failed creating frame task");
+
+        abort();
+    }
+#endif
+
+#ifdef CONFIG_NEX_WAVEFORM_PUMP
+    if (!nextion_pump_init(&driver->pump, driver))
+    {
+        CMP_LOGE("failed creating pump task");
+
+        abort();
+    }
+#endif
+
     CMP_LOGI("driver installed");
 
     return driver;
@@ -90,23 +218,13 @@ nex_err_t nextion_init(nextion_t *handle)
 {
     CMP_CHECK_HANDLE(handle, NEX_FAIL)
 
-    // As "nextion_protocol_send_instruction" validates
-    // if the driver is initialized, we need to cheat here.
-    handle->is_initialized = true;
-
-    // Set up the semaphore.
-    PROCESS_SYNC_GIVE(handle);
-
-    // Resume the UART task.
-    vTaskResume(handle->uart_task);
+    nextion_core_start(handle);
 
     // Just try to wake up, as the device cannot
     // receive instructions when sleeping.
     if (nextion_system_wakeup(handle) != NEX_OK)
     {
-        handle->is_initialized = false;
-
-        vTaskSuspend(handle->uart_task);
+        nextion_core_stop(handle);
 
         CMP_LOGE("failed waking up device");
 
@@ -118,6 +236,58 @@ nex_err_t nextion_init(nextion_t *handle)
     return NEX_OK;
 }
 
+nex_err_t nextion_init_auto_baud(nextion_t *handle, nextion_baud_rate_t max_baud_rate)
+{
+    CMP_CHECK_HANDLE(handle, NEX_FAIL)
+    CMP_CHECK((max_baud_rate >= NEX_SERIAL_BAUD_RATE_MIN && max_baud_rate <= NEX_SERIAL_BAUD_RATE_MAX), "max_baud_rate error", NEX_FAIL)
+
+    nextion_core_start(handle);
+
+    uint32_t baud_rate = nextion_core_detect_baud_rate(handle);
+
+    if (baud_rate == 0 || nextion_system_wakeup(handle) != NEX_OK)
+    {
+        nextion_core_stop(handle);
+
+        CMP_LOGE("failed finding device baud rate");
+
+        return NEX_FAIL;
+    }
+
+    // Try the highest rate first, stepping down
+    // until the device answers correctly on one.
+    for (size_t i = sizeof(BAUD_RATES) / sizeof(BAUD_RATES[0]); i-- > 0 && BAUD_RATES[i] > baud_rate;)
+    {
+        if (BAUD_RATES[i] > max_baud_rate)
+        {
+            continue;
+        }
+
+        if (nextion_system_set_baud_rate(handle, BAUD_RATES[i], false) == NEX_OK)
+        {
+            baud_rate = BAUD_RATES[i];
+
+            break;
+        }
+
+        // Either side may have switched; find the device again.
+        baud_rate = nextion_core_detect_baud_rate(handle);
+
+        if (baud_rate == 0)
+        {
+            nextion_core_stop(handle);
+
+            CMP_LOGE("device lost changing baud rate");
+
+            return NEX_FAIL;
+        }
+    }
+
+    CMP_LOGI("driver initialized with baud rate %lu", (unsigned long)baud_rate);
+
+    return NEX_OK;
+}
+
 bool nextion_driver_delete(nextion_t *handle)
 {
     CMP_CHECK((handle != NULL), "handle error(NULL)", false)
@@ -131,10 +301,17 @@ bool nextion_driver_delete(nextion_t *handle)
 
     CMP_LOGI("deleting driver");
 
+#ifdef CONFIG_NEX_COALESCE
+    nextion_coalesce_deinit(&handle->coalescer);
+#endif
+
+#ifdef CONFIG_NEX_WAVEFORM_PUMP
+    nextion_pump_deinit(&handle->pump);
+#endif
+
     vTaskDelete(handle->uart_task);
 
-    // Will also free the queue.
-    ESP_ERROR_CHECK(uart_driver_delete(handle->uart_num));
+    handle->transport->destroy(handle->transport);
 
     vSemaphoreDelete(handle->send_instruction_sync);
 
@@ -151,81 +328,89 @@ bool nextion_driver_delete(nextion_t *handle)
 // Protocol
 //
 
-bool nextion_protocol_format_instruction(nextion_t *handle, formated_instruction_t *formated_instruction, const char *instruction, ...)
+nex_err_t nextion_protocol_send_instruction(nextion_t *handle, const char *instruction, size_t instruction_length, const parser_t *parser)
 {
-    va_list args;
-    va_start(args, instruction);
+    CMP_CHECK_HANDLE(handle, NEX_FAIL)
+    CMP_CHECK((handle->is_installed), "driver error(not installed)", NEX_FAIL)
+    CMP_CHECK((handle->is_initialized), "driver error(not initialized)", NEX_FAIL)
+    CMP_CHECK((instruction != NULL), "instruction error(NULL)", NEX_FAIL)
 
-    bool result = nextion_protocol_format_instruction_variadic(handle, formated_instruction, instruction, args);
+    STATS_TIMER_START(timer);
 
-    va_end(args);
+    CMP_CHECK((PROCESS_SYNC_TAKE_TIMED(handle, pdMS_TO_TICKS(CONFIG_NEX_UART_MUTEX_WAIT_TIME_MS), timer)), "sync error(not acquired)", NEX_FAIL)
 
-    return result;
-}
+    STATS_TIMER_LAP(timer, NEXTION_STATS_PHASE_LOCK);
 
-bool nextion_protocol_format_instruction_variadic(nextion_t *handle,
-                                                  formated_instruction_t *formated_instruction,
-                                                  const char *instruction,
-                                                  va_list args)
-{
-    int result = vsnprintf((char *)handle->format_buffer, sizeof(handle->format_buffer), instruction, args);
+    // Responses arrive in order; the ones for asynchronous
+    // instructions must be received before this one's.
+    nextion_core_wait_pending(handle, 0);
 
-    if (result > sizeof(handle->format_buffer))
-    {
-        CMP_LOGE("format buffer insufficient: needed %d, has %d", result, sizeof(handle->format_buffer));
+    const bool is_fire_and_forget = parser != NULL && IS_FIRE_AND_FORGET(handle, parser);
 
-        return false;
+    // Failures of instructions not waited on
+    // would be taken as this one's response.
+    if (parser != NULL && !is_fire_and_forget)
+    {
+        nextion_core_settle_unconfirmed(handle);
     }
 
-    formated_instruction->text = (char *)handle->format_buffer;
-    formated_instruction->length = result;
-
-    return true;
-}
-
-nex_err_t nextion_protocol_send_instruction(nextion_t *handle, const char *instruction, size_t instruction_length, const parser_t *parser)
-{
-    CMP_CHECK_HANDLE(handle, NEX_FAIL)
-    CMP_CHECK((handle->is_installed), "driver error(not installed)", NEX_FAIL)
-    CMP_CHECK((handle->is_initialized), "driver error(not initialized)", NEX_FAIL)
-    CMP_CHECK((instruction != NULL), "instruction error(NULL)", NEX_FAIL)
-    CMP_CHECK((PROCESS_SYNC_TAKE(handle, pdMS_TO_TICKS(CONFIG_NEX_UART_MUTEX_WAIT_TIME_MS))), "sync error(not acquired)", NEX_FAIL)
-
     // Process any event remaining in the buffer
     // before sending an instruction, so we can be sure
     // that the data received is a instruction response.
     nextion_core_process_events(handle);
 
-    const char END_SEQUENCE[NEX_DVC_CMD_END_LENGTH] = {NEX_DVC_CMD_END_SEQUENCE};
+    STATS_TIMER_LAP(timer, NEXTION_STATS_PHASE_DRAIN);
 
     nex_err_t code = NEX_DVC_INS_FAIL;
 
-    if (uart_write_bytes(handle->uart_num, instruction, instruction_length) < 1 || uart_write_bytes(handle->uart_num, END_SEQUENCE, NEX_DVC_CMD_END_LENGTH) < 1)
+    if (!nextion_core_write_instruction(handle, instruction, instruction_length))
     {
         CMP_LOGE("failed writing instruction");
 
         goto END;
     }
 
-    if (uart_wait_tx_done(handle->uart_num, pdMS_TO_TICKS(CONFIG_NEX_UART_TRANS_WAIT_TIME_MS)) != ESP_OK)
+    // Without a response to wait for, the UART
+    // drains the transmit buffer on its own.
+    if (parser == NULL || is_fire_and_forget)
     {
-        CMP_LOGE("failed waiting transmission");
+        if (is_fire_and_forget && handle->response_mode == NEXTION_RESPONSE_FAILURE)
+        {
+            nextion_core_track_unconfirmed(handle, instruction, instruction_length);
+        }
+
+        code = NEX_DVC_INS_OK;
+
+        STATS_TIMER_LAP(timer, NEXTION_STATS_PHASE_TRANSMIT);
 
         goto END;
     }
 
-    if (parser != NULL)
+    if (!handle->transport->wait_tx_done(handle->transport, pdMS_TO_TICKS(CONFIG_NEX_UART_TRANS_WAIT_TIME_MS)))
     {
-        code = nextion_core_process_response(handle, parser);
+        CMP_LOGE("failed waiting transmission");
+
+        goto END;
     }
-    else
+
+    STATS_TIMER_LAP(timer, NEXTION_STATS_PHASE_TRANSMIT);
+
+    code = nextion_core_process_response(handle, parser);
+
+    STATS_TIMER_LAP(timer, NEXTION_STATS_PHASE_RESPONSE);
+
+    if (code == NEX_TIMEOUT && PARSER_IS_ACK(parser))
     {
-        code = NEX_DVC_INS_OK;
+        // Silence means failure when only successes are returned. Otherwise
+        // it is taken as success, as the device may not return successes.
+        code = handle->response_mode == NEXTION_RESPONSE_SUCCESS ? NEX_DVC_INS_FAIL : NEX_DVC_INS_OK;
     }
 
 END:
     PROCESS_SYNC_GIVE(handle);
 
+    STATS_RECORD(&handle->stats, nextion_stats_classify(parser), timer, code);
+
     if (code == NEX_DVC_INS_FAIL)
     {
         CMP_LOGW("device returned failure");
@@ -241,195 +426,1194 @@ END:
     return code;
 }
 
-nex_err_t nextion_protocol_send_raw_byte(const nextion_t *handle, uint8_t value)
+nex_err_t nextion_protocol_send_instruction_async(nextion_t *handle,
+                                                  const char *instruction,
+                                                  size_t instruction_length,
+                                                  const parser_t *parser,
+                                                  uint8_t success_code,
+                                                  nextion_async_callback_t callback,
+                                                  void *context)
 {
-    uart_port_t uart = handle->uart_num;
+    CMP_CHECK_HANDLE(handle, NEX_FAIL)
+    CMP_CHECK((handle->is_installed), "driver error(not installed)", NEX_FAIL)
+    CMP_CHECK((handle->is_initialized), "driver error(not initialized)", NEX_FAIL)
+    CMP_CHECK((instruction != NULL), "instruction error(NULL)", NEX_FAIL)
+    CMP_CHECK((parser != NULL), "parser error(NULL)", NEX_FAIL)
+    CMP_CHECK((PROCESS_SYNC_TAKE(handle, pdMS_TO_TICKS(CONFIG_NEX_UART_MUTEX_WAIT_TIME_MS))), "sync error(not acquired)", NEX_FAIL)
+
+    const bool is_fire_and_forget = IS_FIRE_AND_FORGET(handle, parser);
+
+    if (!is_fire_and_forget)
+    {
+        nextion_core_settle_unconfirmed(handle);
+    }
 
-    if (uart_write_bytes(uart, (const void *)&value, 1) < 1)
+    // Make room for one more instruction, processing
+    // whatever responses and events already arrived.
+    nextion_core_process_events(handle);
+    nextion_core_wait_pending(handle, CONFIG_NEX_ASYNC_QUEUE_SIZE - 1);
+
+    if (!nextion_core_write_instruction(handle, instruction, instruction_length))
     {
+        PROCESS_SYNC_GIVE(handle);
+
         CMP_LOGE("failed writing instruction");
 
         return NEX_FAIL;
     }
 
-    if (uart_wait_tx_done(uart, pdMS_TO_TICKS(CONFIG_NEX_UART_TRANS_WAIT_TIME_MS)) != ESP_OK)
+    // No response will come; complete it right away.
+    if (is_fire_and_forget)
     {
-        CMP_LOGE("failed waiting transmission");
+        if (handle->response_mode == NEXTION_RESPONSE_FAILURE)
+        {
+            nextion_core_track_unconfirmed(handle, instruction, instruction_length);
+        }
 
-        return NEX_FAIL;
-    }
+        PROCESS_SYNC_GIVE(handle);
 
-    return NEX_OK;
-}
+        if (callback != NULL)
+        {
+            callback(handle, NEX_OK, context);
+        }
 
-//
-// Core
-//
+        return NEX_OK;
+    }
 
-static nex_err_t nextion_core_process_response(nextion_t *handle, const parser_t *parser)
-{
-    if (parser == NULL)
+    const bool was_idle = handle->pending_count == 0;
+
+    if (was_idle)
     {
-        return NEX_DVC_INS_OK;
+        handle->pending_deadline = xTaskGetTickCount() + pdMS_TO_TICKS(CONFIG_NEX_UART_RECV_WAIT_TIME_MS);
     }
 
-    uint8_t *buffer = handle->uart_buffer;
+    pending_instruction_t *pending = &handle->pending[(handle->pending_head + handle->pending_count) % CONFIG_NEX_ASYNC_QUEUE_SIZE];
 
-    int total_bytes_read = 0;
-    int bytes_read = uart_read_bytes(handle->uart_num, buffer + total_bytes_read, 1, pdMS_TO_TICKS(CONFIG_NEX_UART_RECV_WAIT_TIME_MS));
+    pending->parser = *parser;
+    pending->callback = callback;
+    pending->context = context;
+    pending->success_code = success_code;
 
-    total_bytes_read += bytes_read;
+    handle->pending_count++;
 
-    if (bytes_read == 0)
-    {
-        return NEX_DVC_INS_OK;
-    }
+    PROCESS_SYNC_GIVE(handle);
 
-    if (bytes_read == -1)
+    if (was_idle)
     {
-        return NEX_TIMEOUT;
+        // Wake the UART task so it starts timing the response.
+        handle->transport->wake(handle->transport);
     }
 
-    const uint8_t data_id = buffer[0];
+    return NEX_OK;
+}
 
-    if (!parser->can_parse(parser, data_id))
-    {
-        CMP_LOGE("parser cannot parser response: %d", data_id);
+nex_err_t nextion_protocol_wait_async(nextion_t *handle)
+{
+    CMP_CHECK_HANDLE(handle, NEX_FAIL)
+    CMP_CHECK((handle->is_initialized), "driver error(not initialized)", NEX_FAIL)
+    CMP_CHECK((PROCESS_SYNC_TAKE(handle, pdMS_TO_TICKS(CONFIG_NEX_UART_MUTEX_WAIT_TIME_MS))), "sync error(not acquired)", NEX_FAIL)
 
-        uart_flush(handle->uart_num);
+    nextion_core_wait_pending(handle, 0);
 
-        return NEX_DVC_INS_FAIL;
-    }
+    PROCESS_SYNC_GIVE(handle);
+
+    return NEX_OK;
+}
+
+nex_err_t nextion_protocol_send_batch(nextion_t *handle,
+                                      const uint8_t *data,
+                                      size_t data_length,
+                                      size_t instruction_count,
+                                      nextion_batch_failure_t *failures,
+                                      size_t failures_length,
+                                      size_t *failure_count)
+{
+    CMP_CHECK_HANDLE(handle, NEX_FAIL)
+    CMP_CHECK((handle->is_installed), "driver error(not installed)", NEX_FAIL)
+    CMP_CHECK((handle->is_initialized), "driver error(not initialized)", NEX_FAIL)
+    CMP_CHECK((data != NULL), "data error(NULL)", NEX_FAIL)
+    CMP_CHECK((PROCESS_SYNC_TAKE(handle, pdMS_TO_TICKS(CONFIG_NEX_UART_MUTEX_WAIT_TIME_MS))), "sync error(not acquired)", NEX_FAIL)
+
+    static const char RETURN_ALL_INSTRUCTION[] = "bkcmd=3";
 
-    while (parser->need_more_bytes(parser, buffer, total_bytes_read) > 0)
+    const parser_t parser = PARSER_ACK();
+    const nextion_response_mode_t mode = handle->response_mode;
+    bool is_discarded = false;
+    size_t failed = 0;
+
+    // Results are read in order; nothing else can be waiting for one.
+    nextion_core_wait_pending(handle, 0);
+    nextion_core_settle_unconfirmed(handle);
+    nextion_core_process_events(handle);
+
+    // Every result is needed to tell which instruction failed,
+    // so the device is asked to return all of them meanwhile.
+    if (mode != NEXTION_RESPONSE_ALL && !nextion_core_write_instruction(handle, RETURN_ALL_INSTRUCTION, sizeof(RETURN_ALL_INSTRUCTION) - 1))
     {
-        total_bytes_read += uart_read_bytes(handle->uart_num, buffer + total_bytes_read, 1, pdMS_TO_TICKS(CONFIG_NEX_UART_RECV_WAIT_TIME_MS));
+        PROCESS_SYNC_GIVE(handle);
+
+        CMP_LOGE("failed writing instruction");
+
+        return NEX_FAIL;
     }
 
-    if (!parser->parse(parser, buffer, total_bytes_read))
+    if (handle->transport->write(handle->transport, data, data_length) != (int)data_length)
     {
-        CMP_LOGE("parser cannot parser response: %d", data_id);
+        PROCESS_SYNC_GIVE(handle);
 
-        uart_flush(handle->uart_num);
+        CMP_LOGE("failed writing batch");
 
-        return NEX_DVC_INS_FAIL;
+        return NEX_FAIL;
     }
 
-    return data_id;
-}
+    if (mode != NEXTION_RESPONSE_ALL)
+    {
+        formated_instruction_t restore_instruction;
 
-static void nextion_core_process_events(nextion_t *handle)
-{
-    uint8_t *buffer = handle->uart_buffer;
+        nextion_protocol_format_instruction(&restore_instruction, "bkcmd=%d", mode);
+        nextion_core_write_instruction(handle, restore_instruction.text, restore_instruction.length);
+    }
 
-    do
+    // The device returns the result of "bkcmd" as the new mode says: always for "bkcmd=3".
+    if (mode != NEXTION_RESPONSE_ALL)
     {
-        int total_bytes_read = 0;
-        int bytes_read = uart_read_bytes(handle->uart_num, buffer + total_bytes_read, 1, pdMS_TO_TICKS(CONFIG_NEX_UART_RECV_WAIT_TIME_MS));
+        nextion_core_process_response(handle, &parser);
+    }
 
-        total_bytes_read += bytes_read;
+    for (size_t i = 0; i < instruction_count; i++)
+    {
+        nex_err_t code = nextion_core_process_response(handle, &parser);
 
-        if (bytes_read < 1)
+        if (code == NEX_DVC_INS_OK)
         {
-            return;
+            continue;
         }
 
-        const uint8_t data_id = buffer[0];
-        event_parser_t event_parser;
-
-        if (!try_get_event_parser(data_id, handle->event_buffer, sizeof(handle->event_buffer), &event_parser))
+        if (code == NEX_TIMEOUT)
         {
-            CMP_LOGE("parser not found for event: %d", data_id);
-
-            uart_flush(handle->uart_num);
-
-            return;
-        }
+            // Results can no longer be told apart.
+            for (; i < instruction_count; i++)
+            {
+                nextion_core_add_batch_failure(failures, failures_length, &failed, i, NEX_TIMEOUT);
+            }
 
-        if (!event_parser.base.can_parse(&event_parser.base, data_id))
-        {
-            CMP_LOGE("parser found cannot parse event: %d", data_id);
+            nextion_core_discard_input(handle);
 
-            uart_flush(handle->uart_num);
+            is_discarded = true;
 
-            return;
+            break;
         }
 
-        while (event_parser.base.need_more_bytes(&event_parser.base, buffer, total_bytes_read) > 0)
-        {
-            total_bytes_read += uart_read_bytes(handle->uart_num, buffer + total_bytes_read, 1, pdMS_TO_TICKS(CONFIG_NEX_UART_RECV_WAIT_TIME_MS));
-        }
+        nextion_core_add_batch_failure(failures, failures_length, &failed, i, code == NEX_DVC_INS_FAIL ? NEX_FAIL : code);
+    }
 
-        if (!event_parser.base.parse(&event_parser.base, buffer, total_bytes_read))
-        {
-            CMP_LOGE("parser cannot parser event: %d", data_id);
+    // Of the modes restored, only this one returns the success of "bkcmd";
+    // after a timeout, the input was discarded with it.
+    if (mode == NEXTION_RESPONSE_SUCCESS && !is_discarded)
+    {
+        nextion_core_process_response(handle, &parser);
+    }
 
-            uart_flush(handle->uart_num);
+    PROCESS_SYNC_GIVE(handle);
 
-            return;
-        }
+    if (failure_count != NULL)
+    {
+        *failure_count = failed;
+    }
 
-        esp_event_post(NEXTION_EVENT, event_parser.event_id, handle->event_buffer, event_parser.required_buffer_size, portMAX_DELAY);
-    } while (true);
+    return failed == 0 ? NEX_OK : NEX_FAIL;
 }
 
-static void nextion_core_uart_task(void *pvParameters)
+nex_err_t nextion_protocol_send_get_numbers(nextion_t *handle,
+                                            const uint8_t *data,
+                                            size_t data_length,
+                                            int32_t *numbers,
+                                            size_t count)
 {
-    vTaskSuspend(NULL);
+    CMP_CHECK_HANDLE(handle, NEX_FAIL)
+    CMP_CHECK((handle->is_installed), "driver error(not installed)", NEX_FAIL)
+    CMP_CHECK((handle->is_initialized), "driver error(not initialized)", NEX_FAIL)
+    CMP_CHECK((data != NULL), "data error(NULL)", NEX_FAIL)
+    CMP_CHECK((numbers != NULL), "numbers error(NULL)", NEX_FAIL)
+    CMP_CHECK((PROCESS_SYNC_TAKE(handle, pdMS_TO_TICKS(CONFIG_NEX_UART_MUTEX_WAIT_TIME_MS))), "sync error(not acquired)", NEX_FAIL)
 
-    nextion_t *handle = (nextion_t *)pvParameters;
-    QueueHandle_t queue = handle->uart_queue;
-    uart_port_t uart = handle->uart_num;
+    static const char RETURN_NONE_INSTRUCTION[] = "bkcmd=0";
 
-    CMP_LOGI("installed queue for UART %d", uart);
+    const parser_t parser = PARSER_NUMBERS(numbers, count * sizeof(int32_t));
+    const parser_t ack_parser = PARSER_ACK();
+    const nextion_response_mode_t mode = handle->response_mode;
+    nex_err_t code = NEX_FAIL;
 
-    uart_event_t event;
+    // The response is read right after the write; nothing else can be waiting for one.
+    nextion_core_wait_pending(handle, 0);
+    nextion_core_settle_unconfirmed(handle);
+    nextion_core_process_events(handle);
 
-    for (;;)
+    // Results of the printing instructions would be mixed
+    // with the numbers, so none is returned meanwhile.
+    if (mode != NEXTION_RESPONSE_NONE && !nextion_core_write_instruction(handle, RETURN_NONE_INSTRUCTION, sizeof(RETURN_NONE_INSTRUCTION) - 1))
     {
-        if (xQueueReceive(queue, (void *)&event, portMAX_DELAY) == pdFALSE)
-        {
-            CMP_LOGE("failed receiving from UART queue");
-            break;
-        }
+        PROCESS_SYNC_GIVE(handle);
 
-        switch (event.type)
-        {
-        case UART_DATA:
-            CMP_LOGD("UART data size: %d", event.size);
+        CMP_LOGE("failed writing instruction");
 
-            // If we can acquire a semaphore it means the event
-            // was sent by the device automatically. It will
-            // only fail to acquire the semaphore when an
-            // instruction is being sent.
-            if (PROCESS_SYNC_TAKE(handle, portMAX_DELAY))
-            {
-                CMP_LOGD("processing events");
+        return NEX_FAIL;
+    }
 
-                nextion_core_process_events(handle);
+    if (handle->transport->write(handle->transport, data, data_length) != (int)data_length)
+    {
+        PROCESS_SYNC_GIVE(handle);
 
-                PROCESS_SYNC_GIVE(handle);
-            }
-            break;
+        CMP_LOGE("failed writing instructions");
 
-        case UART_FIFO_OVF:
-            CMP_LOGW("UART hw fifo overflow");
+        return NEX_FAIL;
+    }
 
-            uart_flush_input(uart);
+    if (mode != NEXTION_RESPONSE_NONE)
+    {
+        formated_instruction_t restore_instruction;
 
-            xQueueReset(queue);
-            break;
+        nextion_protocol_format_instruction(&restore_instruction, "bkcmd=%d", mode);
+        nextion_core_write_instruction(handle, restore_instruction.text, restore_instruction.length);
+    }
 
-        case UART_BUFFER_FULL:
-            CMP_LOGW("UART buffer full");
+    // The device returns the result of "bkcmd" as the new mode says:
+    // nothing for "bkcmd=0", so the numbers come first.
+    code = nextion_core_process_response(handle, &parser);
 
-            uart_flush_input(uart);
+    // Nothing is printed for a value that does not exist,
+    // so the response comes short and is never completed.
+    if (code == NEX_TIMEOUT)
+    {
+        nextion_core_discard_input(handle);
+    }
+    else if (mode == NEXTION_RESPONSE_ALL || mode == NEXTION_RESPONSE_SUCCESS)
+    {
+        // Otherwise taken as an event, which drops the input.
+        nextion_core_process_response(handle, &ack_parser);
+    }
 
-            xQueueReset(queue);
-            break;
+    PROCESS_SYNC_GIVE(handle);
 
-        default:
-            break;
-        }
+    if (code == PARSER_NUMBERS_HEADER)
+    {
+        return NEX_OK;
     }
-}
\ No newline at end of file
+
+    return code == NEX_DVC_INS_FAIL ? NEX_FAIL : code;
+}
+
+nex_err_t nextion_protocol_set_response_mode(nextion_t *handle,
+                                             nextion_response_mode_t mode,
+                                             nextion_failure_callback_t on_failure,
+                                             void *context)
+{
+    CMP_CHECK_HANDLE(handle, NEX_FAIL)
+    CMP_CHECK((handle->is_installed), "driver error(not installed)", NEX_FAIL)
+    CMP_CHECK((handle->is_initialized), "driver error(not initialized)", NEX_FAIL)
+    CMP_CHECK((PROCESS_SYNC_TAKE(handle, pdMS_TO_TICKS(CONFIG_NEX_UART_MUTEX_WAIT_TIME_MS))), "sync error(not acquired)", NEX_FAIL)
+
+    const parser_t parser = PARSER_ACK();
+    formated_instruction_t instruction;
+    nex_err_t code = NEX_DVC_INS_FAIL;
+
+    // Every result returned under the old mode must be received first.
+    nextion_core_wait_pending(handle, 0);
+    nextion_core_settle_unconfirmed(handle);
+    nextion_core_process_events(handle);
+
+    nextion_protocol_format_instruction(&instruction, "bkcmd=%d", mode);
+
+    if (!nextion_core_write_instruction(handle, instruction.text, instruction.length))
+    {
+        CMP_LOGE("failed writing instruction");
+
+        goto END;
+    }
+
+    // The device returns the result of "bkcmd" as the new mode says.
+    if (mode == NEXTION_RESPONSE_ALL || mode == NEXTION_RESPONSE_SUCCESS)
+    {
+        code = nextion_core_process_response(handle, &parser);
+
+        if (code == NEX_TIMEOUT)
+        {
+            code = mode == NEXTION_RESPONSE_SUCCESS ? NEX_DVC_INS_FAIL : NEX_DVC_INS_OK;
+        }
+    }
+    else
+    {
+        code = NEX_DVC_INS_OK;
+    }
+
+    if (code == NEX_DVC_INS_OK)
+    {
+        handle->response_mode = mode;
+        handle->failure_callback = on_failure;
+        handle->failure_context = context;
+    }
+
+END:
+    PROCESS_SYNC_GIVE(handle);
+
+    if (code == NEX_DVC_INS_FAIL)
+    {
+        CMP_LOGW("device returned failure");
+
+        return NEX_FAIL;
+    }
+
+    return code == NEX_DVC_INS_OK ? NEX_OK : code;
+}
+
+nex_err_t nextion_protocol_set_baud_rate(nextion_t *handle, uint32_t baud_rate, bool persist)
+{
+    CMP_CHECK_HANDLE(handle, NEX_FAIL)
+    CMP_CHECK((handle->is_installed), "driver error(not installed)", NEX_FAIL)
+    CMP_CHECK((handle->is_initialized), "driver error(not initialized)", NEX_FAIL)
+    CMP_CHECK((PROCESS_SYNC_TAKE(handle, pdMS_TO_TICKS(CONFIG_NEX_UART_MUTEX_WAIT_TIME_MS))), "sync error(not acquired)", NEX_FAIL)
+
+    nex_err_t code = NEX_FAIL;
+    formated_instruction_t formated_instruction;
+
+    // Nothing can be in flight at the old rate.
+    nextion_core_wait_pending(handle, 0);
+    nextion_core_settle_unconfirmed(handle);
+    nextion_core_process_events(handle);
+
+    if (!nextion_protocol_format_instruction(&formated_instruction, persist ? "bauds=%lu" : "baud=%lu", (unsigned long)baud_rate))
+    {
+        goto END;
+    }
+
+    if (!nextion_core_write_instruction(handle, formated_instruction.text, formated_instruction.length))
+    {
+        CMP_LOGE("failed writing instruction");
+
+        goto END;
+    }
+
+    // The device switches only after receiving the whole
+    // instruction; switching earlier would corrupt its end.
+    if (!handle->transport->wait_tx_done(handle->transport, pdMS_TO_TICKS(CONFIG_NEX_UART_TRANS_WAIT_TIME_MS)))
+    {
+        CMP_LOGE("failed waiting transmission");
+
+        goto END;
+    }
+
+    vTaskDelay(pdMS_TO_TICKS(NEX_DVC_BAUD_RATE_WAIT_TIME_MS));
+
+    if (!nextion_core_set_uart_baud_rate(handle, baud_rate))
+    {
+        goto END;
+    }
+
+    // A response sent while switching cannot be trusted.
+    nextion_core_discard_input(handle);
+
+    code = NEX_OK;
+
+END:
+    PROCESS_SYNC_GIVE(handle);
+
+    return code;
+}
+
+uint32_t nextion_protocol_get_baud_rate(const nextion_t *handle)
+{
+    return handle->baud_rate;
+}
+
+void nextion_protocol_set_tdm_length(nextion_t *handle, size_t data_length)
+{
+    handle->tdm_remaining = data_length;
+}
+
+nex_err_t nextion_protocol_send_tdm_data(nextion_t *handle, const uint8_t *data, size_t length)
+{
+    CMP_CHECK_HANDLE(handle, NEX_FAIL)
+    CMP_CHECK((handle->is_installed), "driver error(not installed)", NEX_FAIL)
+    CMP_CHECK((data != NULL), "data error(NULL)", NEX_FAIL)
+    CMP_CHECK((length > 0), "length error(0)", NEX_FAIL)
+    CMP_CHECK((length <= handle->tdm_remaining), "length error(more than the device expects)", NEX_FAIL)
+    CMP_CHECK((PROCESS_SYNC_TAKE(handle, pdMS_TO_TICKS(CONFIG_NEX_UART_MUTEX_WAIT_TIME_MS))), "sync error(not acquired)", NEX_FAIL)
+
+    const parser_t parser = PARSER_TDM_STOP();
+    nex_err_t code = nextion_protocol_send_raw(handle, data, length);
+
+    if (code == NEX_OK)
+    {
+        handle->tdm_remaining -= length;
+    }
+
+    // Nothing else is parsed by the device until it leaves the mode.
+    if (code == NEX_OK && handle->tdm_remaining == 0)
+    {
+        code = nextion_core_process_response(handle, &parser);
+        code = code == NEX_DVC_EVT_TRANSPARENT_DATA_FINISHED ? NEX_OK : code;
+    }
+
+    PROCESS_SYNC_GIVE(handle);
+
+    return code == NEX_DVC_INS_FAIL ? NEX_FAIL : code;
+}
+
+nex_err_t nextion_protocol_send_tdm_streams(nextion_t *handle, const tdm_stream_t *streams, size_t stream_count)
+{
+    CMP_CHECK_HANDLE(handle, NEX_FAIL)
+    CMP_CHECK((handle->is_installed), "driver error(not installed)", NEX_FAIL)
+    CMP_CHECK((handle->is_initialized), "driver error(not initialized)", NEX_FAIL)
+    CMP_CHECK((streams != NULL), "streams error(NULL)", NEX_FAIL)
+    CMP_CHECK((PROCESS_SYNC_TAKE(handle, pdMS_TO_TICKS(CONFIG_NEX_UART_MUTEX_WAIT_TIME_MS))), "sync error(not acquired)", NEX_FAIL)
+
+    const parser_t start_parser = PARSER_TDM_START();
+    const parser_t stop_parser = PARSER_TDM_STOP();
+    nex_err_t code = NEX_OK;
+
+    // Responses are read right after each write; nothing else can be waiting for one.
+    nextion_core_wait_pending(handle, 0);
+    nextion_core_settle_unconfirmed(handle);
+    nextion_core_process_events(handle);
+
+    for (size_t i = 0; i < stream_count && code == NEX_OK; i++)
+    {
+        const tdm_stream_t *stream = &streams[i];
+
+        if (!nextion_core_write_instruction(handle, stream->instruction, stream->instruction_length) ||
+            !handle->transport->wait_tx_done(handle->transport, pdMS_TO_TICKS(CONFIG_NEX_UART_TRANS_WAIT_TIME_MS)))
+        {
+            CMP_LOGE("failed writing instruction");
+
+            code = NEX_FAIL;
+
+            break;
+        }
+
+        code = nextion_core_process_response(handle, &start_parser);
+
+        if (code != NEX_DVC_RSP_TRANSPARENT_DATA_READY)
+        {
+            break;
+        }
+
+        code = nextion_protocol_send_raw(handle, stream->data, stream->data_length);
+
+        if (code == NEX_OK && stream->tail_length > 0)
+        {
+            code = nextion_protocol_send_raw(handle, stream->tail_data, stream->tail_length);
+        }
+
+        // The next instruction would be taken as data until the device leaves the mode.
+        if (code == NEX_OK)
+        {
+            code = nextion_core_process_response(handle, &stop_parser);
+            code = code == NEX_DVC_EVT_TRANSPARENT_DATA_FINISHED ? NEX_OK : code;
+        }
+    }
+
+    // A late response would be taken as the next instruction's.
+    if (code == NEX_TIMEOUT)
+    {
+        nextion_core_discard_input(handle);
+    }
+
+    PROCESS_SYNC_GIVE(handle);
+
+    return code == NEX_DVC_INS_FAIL ? NEX_FAIL : code;
+}
+
+nex_err_t nextion_protocol_send_raw(const nextion_t *handle, const uint8_t *data, size_t length)
+{
+    nextion_transport_t *transport = handle->transport;
+    nex_err_t code = NEX_FAIL;
+
+    STATS_TIMER_START(timer);
+
+    if (transport->write(transport, data, length) != (int)length)
+    {
+        CMP_LOGE("failed writing instruction");
+    }
+    else if (!transport->wait_tx_done(transport, pdMS_TO_TICKS(CONFIG_NEX_UART_TRANS_WAIT_TIME_MS)))
+    {
+        CMP_LOGE("failed waiting transmission");
+    }
+    else
+    {
+        STATS_TIMER_LAP(timer, NEXTION_STATS_PHASE_TRANSMIT);
+
+        code = NEX_OK;
+    }
+
+    // The statistics are not part of the handle state the caller sees.
+    STATS_RECORD((stats_collector_t *)&handle->stats, NEXTION_STATS_CLASS_RAW, timer, code);
+
+    return code;
+}
+
+#ifdef CONFIG_NEX_STATS
+stats_collector_t *nextion_protocol_get_stats(nextion_t *handle)
+{
+    return &handle->stats;
+}
+#endif
+
+#ifdef CONFIG_NEX_SHADOW_CACHE
+shadow_cache_t *nextion_protocol_get_shadow(nextion_t *handle)
+{
+    return &handle->shadow;
+}
+#endif
+
+#ifdef CONFIG_NEX_COALESCE
+coalescer_t *nextion_protocol_get_coalescer(nextion_t *handle)
+{
+    return &handle->coalescer;
+}
+#endif
+
+#ifdef CONFIG_NEX_WAVEFORM_PUMP
+waveform_pump_t *nextion_protocol_get_pump(nextion_t *handle)
+{
+    return &handle->pump;
+}
+#endif
+
+//
+// Core
+//
+
+static void nextion_core_start(nextion_t *handle)
+{
+    // As "nextion_protocol_send_instruction" validates
+    // if the driver is initialized, we need to cheat here.
+    handle->is_initialized = true;
+
+    // Set up the semaphore.
+    PROCESS_SYNC_GIVE(handle);
+
+    // Resume the UART task.
+    vTaskResume(handle->uart_task);
+}
+
+static void nextion_core_stop(nextion_t *handle)
+{
+    handle->is_initialized = false;
+
+    vTaskSuspend(handle->uart_task);
+}
+
+static uint32_t nextion_core_detect_baud_rate(nextion_t *handle)
+{
+    const uint32_t installed_baud_rate = handle->baud_rate;
+
+    if (nextion_core_probe_baud_rate(handle, installed_baud_rate))
+    {
+        return installed_baud_rate;
+    }
+
+    for (size_t i = 0; i < sizeof(BAUD_RATES) / sizeof(BAUD_RATES[0]); i++)
+    {
+        if (BAUD_RATES[i] != installed_baud_rate && nextion_core_probe_baud_rate(handle, BAUD_RATES[i]))
+        {
+            return BAUD_RATES[i];
+        }
+    }
+
+    return 0;
+}
+
+static bool nextion_core_probe_baud_rate(nextion_t *handle, uint32_t baud_rate)
+{
+    if (!PROCESS_SYNC_TAKE(handle, pdMS_TO_TICKS(CONFIG_NEX_UART_MUTEX_WAIT_TIME_MS)))
+    {
+        return false;
+    }
+
+    bool is_set = nextion_core_set_uart_baud_rate(handle, baud_rate);
+
+    if (is_set)
+    {
+        // The end sequence terminates whatever the device received at
+        // a wrong rate; the wake up lets the next instruction through.
+        nextion_core_write_instruction(handle, "", 0);
+        nextion_core_write_instruction(handle, "sleep=0", 7);
+        handle->transport->wait_tx_done(handle->transport, pdMS_TO_TICKS(CONFIG_NEX_UART_TRANS_WAIT_TIME_MS));
+        vTaskDelay(pdMS_TO_TICKS(NEX_DVC_BAUD_RATE_WAIT_TIME_MS));
+        nextion_core_discard_input(handle);
+    }
+
+    PROCESS_SYNC_GIVE(handle);
+
+    uint32_t device_baud_rate = 0;
+
+    return is_set &&
+           nextion_system_get_baud_rate(handle, &device_baud_rate) == NEX_OK &&
+           device_baud_rate == baud_rate;
+}
+
+static bool nextion_core_set_uart_baud_rate(nextion_t *handle, uint32_t baud_rate)
+{
+    if (!handle->transport->set_baud_rate(handle->transport, baud_rate))
+    {
+        CMP_LOGE("failed setting UART baud rate: %lu", (unsigned long)baud_rate);
+
+        return false;
+    }
+
+    handle->baud_rate = baud_rate;
+
+    return true;
+}
+
+static nex_err_t nextion_core_process_response(nextion_t *handle, const parser_t *parser)
+{
+    if (parser == NULL)
+    {
+        return NEX_DVC_INS_OK;
+    }
+
+    frame_assembler_t *assembler = &handle->rx_assembler;
+    size_t frame_length = 0;
+
+    while (true)
+    {
+        if (assembler->length > 0)
+        {
+            if (!parser->can_parse(parser, assembler->buffer[0]))
+            {
+                CMP_LOGE("parser cannot parser response: %d", assembler->buffer[0]);
+
+                nextion_core_discard_input(handle);
+
+                return NEX_DVC_INS_FAIL;
+            }
+
+            frame_length = frame_assembler_find_frame(assembler, parser);
+
+            if (frame_length > 0)
+            {
+                break;
+            }
+
+            if (frame_assembler_free_space(assembler) == 0)
+            {
+                CMP_LOGE("response bigger than the frame buffer");
+
+                nextion_core_discard_input(handle);
+
+                return NEX_DVC_INS_FAIL;
+            }
+        }
+
+        int bytes_read = nextion_core_receive(handle, pdMS_TO_TICKS(CONFIG_NEX_UART_RECV_WAIT_TIME_MS));
+
+        if (bytes_read == -1)
+        {
+            return NEX_TIMEOUT;
+        }
+
+        if (bytes_read == 0)
+        {
+            if (assembler->length == 0)
+            {
+                return NEX_TIMEOUT;
+            }
+
+            CMP_LOGE("response incomplete: %d", assembler->buffer[0]);
+
+            nextion_core_discard_input(handle);
+
+            return NEX_TIMEOUT;
+        }
+    }
+
+    const uint8_t data_id = assembler->buffer[0];
+
+    if (!parser->parse(parser, assembler->buffer, frame_length))
+    {
+        CMP_LOGE("parser cannot parser response: %d", data_id);
+
+        nextion_core_discard_input(handle);
+
+        return NEX_DVC_INS_FAIL;
+    }
+
+    frame_assembler_consume(assembler, frame_length);
+
+    return data_id;
+}
+
+static void nextion_core_process_events(nextion_t *handle)
+{
+    frame_assembler_t *assembler = &handle->rx_assembler;
+    const parser_t failure_parser = PARSER_ACK();
+    const parser_t tdm_stop_parser = PARSER_TDM_STOP();
+    event_parser_t event_parser;
+
+    do
+    {
+        // Only frames already started are waited on; when nothing
+        // is buffered there is no event to process.
+        if (assembler->length == 0 && nextion_core_receive(handle, 0) < 1)
+        {
+            return;
+        }
+
+        const uint8_t data_id = assembler->buffer[0];
+        const parser_t *parser = NULL;
+
+        // Responses to asynchronous instructions arrive in the
+        // order they were sent, mixed with events.
+        if (handle->pending_count > 0)
+        {
+            const parser_t *pending_parser = &handle->pending[handle->pending_head].parser;
+
+            if (pending_parser->can_parse(pending_parser, data_id))
+            {
+                parser = pending_parser;
+            }
+        }
+
+        // Failures of instructions not waited on arrive
+        // in order, after any asynchronous response.
+        if (parser == NULL && handle->unconfirmed_count > 0 && nextion_core_is_late_failure(handle))
+        {
+            parser = &failure_parser;
+        }
+
+        // Only when the end of a Transparent Data Mode was not waited on.
+        if (parser == NULL && data_id == NEX_DVC_EVT_TRANSPARENT_DATA_FINISHED)
+        {
+            parser = &tdm_stop_parser;
+        }
+
+        if (parser == NULL)
+        {
+            if (!try_get_event_parser(data_id, handle->event_buffer, sizeof(handle->event_buffer), &event_parser))
+            {
+                CMP_LOGE("parser not found for event: %d", data_id);
+
+                nextion_core_discard_input(handle);
+
+                return;
+            }
+
+            if (!event_parser.base.can_parse(&event_parser.base, data_id))
+            {
+                CMP_LOGE("parser found cannot parse event: %d", data_id);
+
+                nextion_core_discard_input(handle);
+
+                return;
+            }
+
+            parser = &event_parser.base;
+        }
+
+        size_t frame_length = frame_assembler_find_frame(assembler, parser);
+
+        if (frame_length == 0)
+        {
+            // Partial frame: keep it and read whatever arrived since.
+            if (frame_assembler_free_space(assembler) == 0 || nextion_core_receive(handle, pdMS_TO_TICKS(CONFIG_NEX_UART_RECV_WAIT_TIME_MS)) < 1)
+            {
+                CMP_LOGE("frame incomplete: %d", data_id);
+
+                nextion_core_discard_input(handle);
+
+                return;
+            }
+
+            continue;
+        }
+
+        if (!parser->parse(parser, assembler->buffer, frame_length))
+        {
+            CMP_LOGE("parser cannot parser frame: %d", data_id);
+
+            nextion_core_discard_input(handle);
+
+            return;
+        }
+
+        frame_assembler_consume(assembler, frame_length);
+
+        if (parser == &event_parser.base)
+        {
+#ifdef CONFIG_NEX_SHADOW_CACHE
+            const nextion_on_touch_event_t *touch_event = (const nextion_on_touch_event_t *)handle->event_buffer;
+            const nextion_on_device_event_t *device_event = (const nextion_on_device_event_t *)handle->event_buffer;
+
+            // Handlers run on a task of higher priority, and may read the values changed.
+            if (event_parser.event_id == NEXTION_EVENT_TOUCHED)
+            {
+                // Other pages' components were forgotten when the page changed.
+                SHADOW_TOUCH(&handle->shadow, touch_event->component_id);
+            }
+            else if (event_parser.event_id != NEXTION_EVENT_STATE_CHANGED
+                     || (device_event->state != NEXTION_DEVICE_AUTO_SLEEP && device_event->state != NEXTION_DEVICE_AUTO_WAKE))
+            {
+                // The device may have changed or lost values on its own; sleeping keeps them.
+                SHADOW_CLEAR(&handle->shadow);
+            }
+#endif
+
+            esp_event_post(NEXTION_EVENT, event_parser.event_id, handle->event_buffer, event_parser.required_buffer_size, portMAX_DELAY);
+        }
+        else if (parser == &failure_parser)
+        {
+            nextion_core_report_failure(handle, data_id);
+        }
+        else if (parser == &tdm_stop_parser)
+        {
+            handle->tdm_remaining = 0;
+        }
+        else
+        {
+            nextion_core_complete_pending(handle, data_id);
+        }
+    } while (true);
+}
+
+static void nextion_core_track_unconfirmed(nextion_t *handle, const char *instruction, size_t instruction_length)
+{
+    // When full, the oldest is the most likely to have succeeded.
+    if (handle->unconfirmed_count == CONFIG_NEX_ASYNC_QUEUE_SIZE)
+    {
+        handle->unconfirmed_head = (handle->unconfirmed_head + 1) % CONFIG_NEX_ASYNC_QUEUE_SIZE;
+        handle->unconfirmed_count--;
+    }
+
+    unconfirmed_instruction_t *unconfirmed = &handle->unconfirmed[(handle->unconfirmed_head + handle->unconfirmed_count) % CONFIG_NEX_ASYNC_QUEUE_SIZE];
+
+    if (instruction_length >= UNCONFIRMED_INSTRUCTION_LENGTH)
+    {
+        instruction_length = UNCONFIRMED_INSTRUCTION_LENGTH - 1;
+    }
+
+    memcpy(unconfirmed->instruction, instruction, instruction_length);
+
+    unconfirmed->instruction[instruction_length] = '\0';
+    unconfirmed->sent_at = xTaskGetTickCount();
+
+    handle->unconfirmed_count++;
+}
+
+static void nextion_core_prune_unconfirmed(nextion_t *handle)
+{
+    const TickType_t now = xTaskGetTickCount();
+
+    while (handle->unconfirmed_count > 0)
+    {
+        const unconfirmed_instruction_t *oldest = &handle->unconfirmed[handle->unconfirmed_head];
+
+        if (now - oldest->sent_at <= pdMS_TO_TICKS(CONFIG_NEX_UART_FAILURE_WAIT_TIME_MS))
+        {
+            return;
+        }
+
+        handle->unconfirmed_head = (handle->unconfirmed_head + 1) % CONFIG_NEX_ASYNC_QUEUE_SIZE;
+        handle->unconfirmed_count--;
+    }
+}
+
+static void nextion_core_settle_unconfirmed(nextion_t *handle)
+{
+    nextion_core_prune_unconfirmed(handle);
+
+    while (handle->unconfirmed_count > 0)
+    {
+        const unconfirmed_instruction_t *newest = &handle->unconfirmed[(handle->unconfirmed_head + handle->unconfirmed_count - 1) % CONFIG_NEX_ASYNC_QUEUE_SIZE];
+        const TickType_t settle_time = newest->sent_at + pdMS_TO_TICKS(CONFIG_NEX_UART_FAILURE_WAIT_TIME_MS) + 1;
+        const int32_t remaining = (int32_t)(settle_time - xTaskGetTickCount());
+
+        if (remaining <= 0 || nextion_core_receive(handle, (TickType_t)remaining) < 1)
+        {
+            // Nothing else arrived: every one of them succeeded.
+            handle->unconfirmed_count = 0;
+
+            return;
+        }
+
+        nextion_core_process_events(handle);
+        nextion_core_prune_unconfirmed(handle);
+    }
+}
+
+static bool nextion_core_is_late_failure(nextion_t *handle)
+{
+    frame_assembler_t *assembler = &handle->rx_assembler;
+    const uint8_t data_id = assembler->buffer[0];
+
+    if (!NEX_DVC_CODE_IS_ACK_RESPONSE(data_id) || data_id == NEX_DVC_INS_OK)
+    {
+        return false;
+    }
+
+    if (data_id != NEX_DVC_EVT_HARDWARE_START_RESET)
+    {
+        return true;
+    }
+
+    // A failure (0x00 0xFF...) shares its id with
+    // the device start event (0x00 0x00...).
+    if (assembler->length < 2 && nextion_core_receive(handle, pdMS_TO_TICKS(CONFIG_NEX_UART_RECV_WAIT_TIME_MS)) < 1)
+    {
+        return false;
+    }
+
+    return assembler->buffer[1] == NEX_DVC_CMD_END_VALUE;
+}
+
+static void nextion_core_report_failure(nextion_t *handle, nex_err_t code)
+{
+    // Which value was refused is not known for sure.
+    SHADOW_CLEAR(&handle->shadow);
+
+    nextion_core_prune_unconfirmed(handle);
+
+    if (handle->unconfirmed_count == 0)
+    {
+        CMP_LOGW("failure without instruction: %d", code);
+
+        return;
+    }
+
+    // Instructions are processed in order, so the failure
+    // belongs to the oldest one that may still fail.
+    const unconfirmed_instruction_t *unconfirmed = &handle->unconfirmed[handle->unconfirmed_head];
+
+    handle->unconfirmed_head = (handle->unconfirmed_head + 1) % CONFIG_NEX_ASYNC_QUEUE_SIZE;
+    handle->unconfirmed_count--;
+
+    if (code == NEX_DVC_INS_FAIL)
+    {
+        code = NEX_FAIL;
+    }
+
+    CMP_LOGW("instruction failed: %s", unconfirmed->instruction);
+
+    if (handle->failure_callback != NULL)
+    {
+        handle->failure_callback(handle, code, unconfirmed->instruction, handle->failure_context);
+    }
+}
+
+static void nextion_core_add_batch_failure(nextion_batch_failure_t *failures,
+                                           size_t failures_length,
+                                           size_t *failure_count,
+                                           size_t index,
+                                           nex_err_t code)
+{
+    if (failures != NULL && *failure_count < failures_length)
+    {
+        failures[*failure_count].index = index;
+        failures[*failure_count].code = code;
+    }
+
+    (*failure_count)++;
+}
+
+static void nextion_core_wait_pending(nextion_t *handle, size_t max_pending)
+{
+    while (handle->pending_count > max_pending)
+    {
+        nextion_core_process_events(handle);
+
+        if (handle->pending_count <= max_pending)
+        {
+            return;
+        }
+
+        TickType_t wait_time = nextion_core_pending_wait_time(handle);
+
+        if (wait_time == 0 || nextion_core_receive(handle, wait_time) < 1)
+        {
+            nextion_core_expire_pending(handle);
+        }
+    }
+}
+
+static void nextion_core_complete_pending(nextion_t *handle, nex_err_t code)
+{
+    pending_instruction_t pending = handle->pending[handle->pending_head];
+
+    handle->pending_head = (handle->pending_head + 1) % CONFIG_NEX_ASYNC_QUEUE_SIZE;
+    handle->pending_count--;
+    handle->pending_deadline = xTaskGetTickCount() + pdMS_TO_TICKS(CONFIG_NEX_UART_RECV_WAIT_TIME_MS);
+
+    if (code == pending.success_code || code == NEX_DVC_INS_OK)
+    {
+        code = NEX_OK;
+    }
+    else if (code == NEX_DVC_INS_FAIL)
+    {
+        code = NEX_FAIL;
+    }
+
+    if (pending.callback != NULL)
+    {
+        pending.callback(handle, code, pending.context);
+    }
+}
+
+static void nextion_core_expire_pending(nextion_t *handle)
+{
+    if (handle->pending_count > 0 && nextion_core_pending_wait_time(handle) == 0)
+    {
+        CMP_LOGW("asynchronous instruction timed out");
+
+        nextion_core_complete_pending(handle, NEX_TIMEOUT);
+    }
+}
+
+static TickType_t nextion_core_pending_wait_time(const nextion_t *handle)
+{
+    if (handle->pending_count == 0)
+    {
+        return portMAX_DELAY;
+    }
+
+    int32_t remaining = (int32_t)(handle->pending_deadline - xTaskGetTickCount());
+
+    return remaining > 0 ? (TickType_t)remaining : 0;
+}
+
+static bool nextion_core_write_instruction(nextion_t *handle, const char *instruction, size_t instruction_length)
+{
+    const uint8_t END_SEQUENCE[NEX_DVC_CMD_END_LENGTH] = {NEX_DVC_CMD_END_SEQUENCE};
+    nextion_transport_t *transport = handle->transport;
+
+    if (instruction_length > sizeof(handle->write_buffer) - NEX_DVC_CMD_END_LENGTH)
+    {
+        return transport->write(transport, (const uint8_t *)instruction, instruction_length) > 0 && transport->write(transport, END_SEQUENCE, NEX_DVC_CMD_END_LENGTH) > 0;
+    }
+
+    // One write per instruction: the end sequence
+    // goes together with the instruction.
+    memcpy(handle->write_buffer, instruction, instruction_length);
+    memcpy(handle->write_buffer + instruction_length, END_SEQUENCE, NEX_DVC_CMD_END_LENGTH);
+
+    return transport->write(transport, handle->write_buffer, instruction_length + NEX_DVC_CMD_END_LENGTH) > 0;
+}
+
+static int nextion_core_receive(nextion_t *handle, TickType_t timeout)
+{
+    frame_assembler_t *assembler = &handle->rx_assembler;
+    nextion_transport_t *transport = handle->transport;
+    int total_bytes_read = 0;
+
+    if (frame_assembler_free_space(assembler) == 0)
+    {
+        return 0;
+    }
+
+    // Without waiting, take bytes only once a frame end was detected; a
+    // partial frame taken with them is completed by the caller waiting.
+    // Waiting reads (responses) do not depend on the frame end,
+    // so fixed-length "rept" responses are read as before.
+    size_t buffered_length = transport->buffered_length(transport, timeout == 0);
+
+    if (buffered_length == 0 && timeout == 0)
+    {
+        return 0;
+    }
+
+    if (buffered_length == 0)
+    {
+        // Nothing buffered yet: wait for the first byte only,
+        // then take whatever arrived with it.
+        total_bytes_read = transport->read(transport, frame_assembler_tail(assembler), 1, timeout);
+
+        if (total_bytes_read < 1)
+        {
+            return total_bytes_read;
+        }
+
+        frame_assembler_commit(assembler, total_bytes_read);
+
+        buffered_length = transport->buffered_length(transport, false);
+    }
+
+    size_t free_space = frame_assembler_free_space(assembler);
+    size_t bytes_to_read = buffered_length < free_space ? buffered_length : free_space;
+
+    if (bytes_to_read > 0)
+    {
+        int bytes_read = transport->read(transport, frame_assembler_tail(assembler), bytes_to_read, 0);
+
+        if (bytes_read > 0)
+        {
+            frame_assembler_commit(assembler, bytes_read);
+
+            total_bytes_read += bytes_read;
+        }
+    }
+
+    return total_bytes_read;
+}
+
+static void nextion_core_discard_input(nextion_t *handle)
+{
+    frame_assembler_reset(&handle->rx_assembler);
+
+    handle->transport->flush_input(handle->transport);
+}
+
+static void nextion_core_uart_task(void *pvParameters)
+{
+    vTaskSuspend(NULL);
+
+    nextion_t *handle = (nextion_t *)pvParameters;
+    nextion_transport_t *transport = handle->transport;
+
+    CMP_LOGI("waiting transport events");
+
+    for (;;)
+    {
+        // Only times out while asynchronous instructions are
+        // pending, to fail those whose response never came.
+        switch (transport->wait_event(transport, nextion_core_pending_wait_time(handle)))
+        {
+        case NEXTION_TRANSPORT_EVENT_TIMEOUT:
+            if (PROCESS_SYNC_TAKE(handle, portMAX_DELAY))
+            {
+                nextion_core_process_events(handle);
+                nextion_core_expire_pending(handle);
+
+                PROCESS_SYNC_GIVE(handle);
+            }
+            break;
+
+        case NEXTION_TRANSPORT_EVENT_DATA:
+            // If we can acquire a semaphore it means the event
+            // was sent by the device automatically. It will
+            // only fail to acquire the semaphore when an
+            // instruction is being sent.
+            if (PROCESS_SYNC_TAKE(handle, portMAX_DELAY))
+            {
+                CMP_LOGD("processing events");
+
+                nextion_core_process_events(handle);
+
+                PROCESS_SYNC_GIVE(handle);
+            }
+            break;
+
+        case NEXTION_TRANSPORT_EVENT_OVERFLOW:
+            // Any partial frame kept is now out of sync
+            // with the data remaining on the transport.
+            if (PROCESS_SYNC_TAKE(handle, portMAX_DELAY))
+            {
+                nextion_core_discard_input(handle);
+
+                PROCESS_SYNC_GIVE(handle);
+            }
+            break;
+
+        default:
+            break;
+        }
+    }
+}
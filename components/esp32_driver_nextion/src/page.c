@@ -24,6 +24,12 @@ nex_err_t nextion_page_set(nextion_t *handle, const char *page_name_or_id)
 {
     CMP_CHECK_HANDLE(handle, NEX_FAIL)
 
+    // Values written before changing page go to the current one.
+    COALESCE_FLUSH(handle);
+
+    // Components of the new page start with their initial values.
+    SHADOW_CLEAR(nextion_protocol_get_shadow(handle));
+
     return nextion_protocol_send_instruction_ack(handle, "page %s", page_name_or_id);
 }
 
@@ -0,0 +1,90 @@
+#include <string.h>
+#include "esp32_driver_nextion/instruction.h"
+#include "esp32_driver_nextion/property.h"
+#include "protocol/protocol.h"
+#include "assertion.h"
+#include "config.h"
+
+#define PROPERTY_QUERY(property) ((property)->instruction)
+#define PROPERTY_QUERY_LENGTH(property) (NEXTION_PROPERTY_QUERY_PREFIX_LENGTH + (property)->path_length)
+#define PROPERTY_ASSIGNMENT(property) ((property)->instruction + NEXTION_PROPERTY_QUERY_PREFIX_LENGTH)
+#define PROPERTY_ASSIGNMENT_LENGTH(property) ((property)->path_length + 1U)
+
+nex_err_t nextion_property_prepare(nextion_t *handle,
+                                   const char *component_name,
+                                   const char *property_name,
+                                   nextion_property_t *property)
+{
+    CMP_CHECK_HANDLE(handle, NEX_FAIL)
+    CMP_CHECK((component_name != NULL), "component_name error(NULL)", NEX_FAIL)
+    CMP_CHECK((property_name != NULL), "property_name error(NULL)", NEX_FAIL)
+    CMP_CHECK((property != NULL), "property error(NULL)", NEX_FAIL)
+
+    encoder_t encoder;
+
+    encoder_begin(&encoder, property->instruction, sizeof(property->instruction));
+    ENCODER_APPEND_LITERAL(&encoder, "get ");
+    encoder_append_property(&encoder, component_name, property_name);
+    encoder_append_char(&encoder, '=');
+
+    CMP_CHECK((encoder_end(&encoder)), "property error(name too long)", NEX_FAIL)
+
+    property->handle = handle;
+    property->path_length = (uint8_t)(encoder.length - NEXTION_PROPERTY_QUERY_PREFIX_LENGTH - 1);
+    property->read_ttl_ms = CONFIG_NEX_SHADOW_CACHE_READ_TTL_MS;
+
+    return NEX_OK;
+}
+
+nex_err_t nextion_property_get_number(const nextion_property_t *property, int32_t *number)
+{
+    CMP_CHECK((property != NULL), "property error(NULL)", NEX_FAIL)
+
+    return SHADOW_GET_NUMBER(property->handle,
+                             PROPERTY_QUERY(property),
+                             PROPERTY_QUERY_LENGTH(property),
+                             property->read_ttl_ms,
+                             number);
+}
+
+nex_err_t nextion_property_get_text(const nextion_property_t *property, char *buffer, size_t buffer_length)
+{
+    CMP_CHECK((property != NULL), "property error(NULL)", NEX_FAIL)
+
+    return SHADOW_GET_TEXT(property->handle,
+                           PROPERTY_QUERY(property),
+                           PROPERTY_QUERY_LENGTH(property),
+                           property->read_ttl_ms,
+                           buffer,
+                           buffer_length);
+}
+
+nex_err_t nextion_property_set_number(const nextion_property_t *property, int32_t number)
+{
+    CMP_CHECK((property != NULL), "property error(NULL)", NEX_FAIL)
+
+    formated_instruction_t instruction;
+    encoder_t encoder;
+
+    // Only the number is encoded; the prefix is copied as is.
+    nextion_protocol_encoder_begin(&instruction, &encoder);
+    encoder_append(&encoder, PROPERTY_ASSIGNMENT(property), PROPERTY_ASSIGNMENT_LENGTH(property));
+    encoder_append_number(&encoder, number);
+
+    return SHADOW_SEND_NUMBER(property->handle, &encoder, property->path_length, number);
+}
+
+nex_err_t nextion_property_set_text(const nextion_property_t *property, const char *text)
+{
+    CMP_CHECK((property != NULL), "property error(NULL)", NEX_FAIL)
+    CMP_CHECK((text != NULL), "text error(NULL)", NEX_FAIL)
+
+    formated_instruction_t instruction;
+    encoder_t encoder;
+
+    nextion_protocol_encoder_begin(&instruction, &encoder);
+    encoder_append(&encoder, PROPERTY_ASSIGNMENT(property), PROPERTY_ASSIGNMENT_LENGTH(property));
+    encoder_append_quoted(&encoder, text);
+
+    return SHADOW_SEND_TEXT(property->handle, &encoder, property->path_length, text);
+}
\ No newline at end of file
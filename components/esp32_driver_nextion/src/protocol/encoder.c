@@ -0,0 +1,127 @@
+#include <string.h>
+#include "protocol/encoder.h"
+
+// Longest int32_t in decimal: "-2147483648".
+#define NUMBER_MAX_LENGTH 11
+
+// Two digits per lookup halves the divisions.
+static const char DIGIT_PAIRS[] = "00010203040506070809"
+                                  "10111213141516171819"
+                                  "20212223242526272829"
+                                  "30313233343536373839"
+                                  "40414243444546474849"
+                                  "50515253545556575859"
+                                  "60616263646566676869"
+                                  "70717273747576777879"
+                                  "80818283848586878889"
+                                  "90919293949596979899";
+
+void encoder_begin(encoder_t *encoder, char *buffer, size_t capacity)
+{
+    encoder->buffer = buffer;
+    encoder->capacity = capacity;
+    encoder->length = 0;
+    encoder->is_overflowed = capacity == 0;
+}
+
+void encoder_append(encoder_t *encoder, const char *data, size_t length)
+{
+    // One position is kept for the null terminator.
+    if (encoder->is_overflowed || length >= encoder->capacity - encoder->length)
+    {
+        encoder->is_overflowed = true;
+
+        return;
+    }
+
+    memcpy(encoder->buffer + encoder->length, data, length);
+
+    encoder->length += length;
+}
+
+void encoder_append_text(encoder_t *encoder, const char *text)
+{
+    encoder_append(encoder, text, strlen(text));
+}
+
+void encoder_append_quoted(encoder_t *encoder, const char *text)
+{
+    encoder_append_char(encoder, '"');
+    encoder_append_text(encoder, text);
+    encoder_append_char(encoder, '"');
+}
+
+void encoder_append_property(encoder_t *encoder, const char *component_name, const char *property_name)
+{
+    encoder_append_text(encoder, component_name);
+    encoder_append_char(encoder, '.');
+    encoder_append_text(encoder, property_name);
+}
+
+void encoder_append_char(encoder_t *encoder, char character)
+{
+    encoder_append(encoder, &character, 1);
+}
+
+void encoder_append_number(encoder_t *encoder, int32_t number)
+{
+    char digits[NUMBER_MAX_LENGTH];
+    char *position = digits + sizeof(digits);
+
+    // Negating INT32_MIN overflows; do it as unsigned.
+    uint32_t value = number < 0 ? 0U - (uint32_t)number : (uint32_t)number;
+
+    // Digits are written backwards, from the least significant.
+    while (value >= 100)
+    {
+        const uint32_t pair = (value % 100) * 2;
+
+        value /= 100;
+        position -= 2;
+        position[0] = DIGIT_PAIRS[pair];
+        position[1] = DIGIT_PAIRS[pair + 1];
+    }
+
+    if (value >= 10)
+    {
+        position -= 2;
+        position[0] = DIGIT_PAIRS[value * 2];
+        position[1] = DIGIT_PAIRS[(value * 2) + 1];
+    }
+    else
+    {
+        *--position = (char)('0' + value);
+    }
+
+    if (number < 0)
+    {
+        *--position = '-';
+    }
+
+    encoder_append(encoder, position, (size_t)(digits + sizeof(digits) - position));
+}
+
+void encoder_append_numbers(encoder_t *encoder, const int32_t *numbers, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        if (i > 0)
+        {
+            encoder_append_char(encoder, ',');
+        }
+
+        encoder_append_number(encoder, numbers[i]);
+    }
+}
+
+bool encoder_end(encoder_t *encoder)
+{
+    if (encoder->is_overflowed)
+    {
+        return false;
+    }
+
+    encoder->buffer[encoder->length] = '\0';
+
+    return true;
+}
@@ -0,0 +1,80 @@
+#include <string.h>
+#include "protocol/frame_assembler.h"
+
+size_t frame_assembler_free_space(const frame_assembler_t *assembler)
+{
+    return sizeof(assembler->buffer) - assembler->length;
+}
+
+uint8_t *frame_assembler_tail(frame_assembler_t *assembler)
+{
+    return assembler->buffer + assembler->length;
+}
+
+void frame_assembler_commit(frame_assembler_t *assembler, size_t length)
+{
+    assembler->length += length;
+}
+
+size_t frame_assembler_push(frame_assembler_t *assembler, const uint8_t *data, size_t length)
+{
+    size_t free_space = frame_assembler_free_space(assembler);
+
+    if (length > free_space)
+    {
+        length = free_space;
+    }
+
+    memcpy(frame_assembler_tail(assembler), data, length);
+
+    frame_assembler_commit(assembler, length);
+
+    return length;
+}
+
+size_t frame_assembler_find_frame(const frame_assembler_t *assembler, const parser_t *parser)
+{
+    size_t frame_length = 1; // First byte is the id.
+
+    if (assembler->length < frame_length)
+    {
+        return 0;
+    }
+
+    // Jump straight to the length the parser asks for instead
+    // of testing byte by byte; fixed-size frames need one call.
+    int needed = parser->need_more_bytes(parser, assembler->buffer, frame_length);
+
+    while (needed > 0)
+    {
+        frame_length += needed;
+
+        if (frame_length > assembler->length)
+        {
+            return 0;
+        }
+
+        needed = parser->need_more_bytes(parser, assembler->buffer, frame_length);
+    }
+
+    return frame_length;
+}
+
+void frame_assembler_consume(frame_assembler_t *assembler, size_t length)
+{
+    if (length >= assembler->length)
+    {
+        assembler->length = 0;
+
+        return;
+    }
+
+    assembler->length -= length;
+
+    memmove(assembler->buffer, assembler->buffer + length, assembler->length);
+}
+
+void frame_assembler_reset(frame_assembler_t *assembler)
+{
+    assembler->length = 0;
+}
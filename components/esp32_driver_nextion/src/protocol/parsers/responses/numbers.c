@@ -0,0 +1,46 @@
+#include "esp32_driver_nextion/base/codes.h"
+#include "esp32_driver_nextion/base/constants.h"
+#include "protocol/parsers/responses/number.h"
+#include "protocol/parsers/responses/numbers.h"
+
+bool parser_rsp_numbers_can_parse(const parser_t *, const uint8_t data_id)
+{
+    return data_id == PARSER_NUMBERS_HEADER || NEX_DVC_CODE_IS_ACK_RESPONSE(data_id);
+}
+
+int parser_rsp_numbers_need_more_bytes(const parser_t *parser, const uint8_t *data, size_t length)
+{
+    if (data[0] == PARSER_NUMBERS_HEADER)
+    {
+        return (int)(NEX_DVC_CMD_START_LENGTH + parser->result_buffer_length + NEX_DVC_CMD_END_LENGTH) - (int)length;
+    }
+
+    return NEX_DVC_CMD_ACK_LENGTH - length;
+}
+
+bool parser_rsp_numbers_parse(const parser_t *parser, const uint8_t *data, size_t length)
+{
+    if (data[0] != PARSER_NUMBERS_HEADER)
+    {
+        return true;
+    }
+
+    // A value missing would shift the end sequence.
+    for (size_t i = length - NEX_DVC_CMD_END_LENGTH; i < length; i++)
+    {
+        if (data[i] != NEX_DVC_CMD_END_VALUE)
+        {
+            return false;
+        }
+    }
+
+    int32_t *numbers = (int32_t *)parser->result_buffer;
+    const size_t count = parser->result_buffer_length / sizeof(int32_t);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        numbers[i] = parser_rsp_number_convert(data + NEX_DVC_CMD_START_LENGTH + i * sizeof(int32_t));
+    }
+
+    return true;
+}
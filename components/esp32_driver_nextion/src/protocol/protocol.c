@@ -1,10 +1,60 @@
 #include <stdarg.h>
+#include <stdio.h>
 #include "esp32_driver_nextion/base/codes.h"
 #include "protocol/parsers/responses/ack.h"
 #include "protocol/parsers/responses/number.h"
 #include "protocol/parsers/responses/text.h"
 #include "protocol/parsers/responses/tdm_start.h"
 #include "protocol/protocol.h"
+#include "assertion.h"
+
+bool nextion_protocol_format_instruction(formated_instruction_t *formated_instruction, const char *instruction, ...)
+{
+    va_list args;
+    va_start(args, instruction);
+
+    bool result = nextion_protocol_format_instruction_variadic(formated_instruction, instruction, args);
+
+    va_end(args);
+
+    return result;
+}
+
+bool nextion_protocol_format_instruction_variadic(formated_instruction_t *formated_instruction,
+                                                  const char *instruction,
+                                                  va_list args)
+{
+    int result = vsnprintf(formated_instruction->text, sizeof(formated_instruction->text), instruction, args);
+
+    // The null terminator needs a position too.
+    if (result < 0 || (size_t)result >= sizeof(formated_instruction->text))
+    {
+        CMP_LOGE("format buffer insufficient: needed %d, has %lu", result + 1, (unsigned long)sizeof(formated_instruction->text));
+
+        return false;
+    }
+
+    formated_instruction->length = (size_t)result;
+
+    return true;
+}
+
+void nextion_protocol_encoder_begin(formated_instruction_t *formated_instruction, encoder_t *encoder)
+{
+    encoder_begin(encoder, formated_instruction->text, sizeof(formated_instruction->text));
+}
+
+bool nextion_protocol_end_encoding(encoder_t *encoder)
+{
+    if (!encoder_end(encoder))
+    {
+        CMP_LOGE("format buffer insufficient: has %lu", (unsigned long)encoder->capacity);
+
+        return false;
+    }
+
+    return true;
+}
 
 nex_err_t nextion_protocol_send_instruction_ack(nextion_t *handle, const char *instruction, ...)
 {
@@ -13,8 +63,10 @@ nex_err_t nextion_protocol_send_instruction_ack(nextion_t *handle, const char *i
 
     formated_instruction_t formated_instruction;
 
-    if (!nextion_protocol_format_instruction_variadic(handle, &formated_instruction, instruction, args))
+    if (!nextion_protocol_format_instruction_variadic(&formated_instruction, instruction, args))
     {
+        va_end(args);
+
         return NEX_FAIL;
     }
 
@@ -36,8 +88,10 @@ nex_err_t nextion_protocol_send_instruction_get_text(nextion_t *handle,
 
     formated_instruction_t formated_instruction;
 
-    if (!nextion_protocol_format_instruction_variadic(handle, &formated_instruction, instruction, args))
+    if (!nextion_protocol_format_instruction_variadic(&formated_instruction, instruction, args))
     {
+        va_end(args);
+
         return NEX_FAIL;
     }
 
@@ -65,8 +119,10 @@ nex_err_t nextion_protocol_send_instruction_get_number(nextion_t *handle,
 
     formated_instruction_t formated_instruction;
 
-    if (!nextion_protocol_format_instruction_variadic(handle, &formated_instruction, instruction, args))
+    if (!nextion_protocol_format_instruction_variadic(&formated_instruction, instruction, args))
     {
+        va_end(args);
+
         return NEX_FAIL;
     }
 
@@ -84,15 +140,17 @@ nex_err_t nextion_protocol_send_instruction_get_number(nextion_t *handle,
     return code;
 }
 
-nex_err_t nextion_protocol_send_instruction_tdm_start(nextion_t *handle, const char *instruction, ...)
+nex_err_t nextion_protocol_send_instruction_tdm_start(nextion_t *handle, size_t data_length, const char *instruction, ...)
 {
     va_list args;
     va_start(args, instruction);
 
     formated_instruction_t formated_instruction;
 
-    if (!nextion_protocol_format_instruction_variadic(handle, &formated_instruction, instruction, args))
+    if (!nextion_protocol_format_instruction_variadic(&formated_instruction, instruction, args))
     {
+        va_end(args);
+
         return NEX_FAIL;
     }
 
@@ -103,9 +161,180 @@ nex_err_t nextion_protocol_send_instruction_tdm_start(nextion_t *handle, const c
     nex_err_t code = nextion_protocol_send_instruction(handle, formated_instruction.text, formated_instruction.length, &parser);
 
     if (code == NEX_DVC_RSP_TRANSPARENT_DATA_READY)
+    {
+        nextion_protocol_set_tdm_length(handle, data_length);
+
+        return NEX_OK;
+    }
+
+    return code;
+}
+
+nex_err_t nextion_protocol_send_encoded_ack(nextion_t *handle, encoder_t *encoder)
+{
+    if (!nextion_protocol_end_encoding(encoder))
+    {
+        return NEX_FAIL;
+    }
+
+    parser_t parser = PARSER_ACK();
+
+    return nextion_protocol_send_instruction(handle, encoder->buffer, encoder->length, &parser);
+}
+
+nex_err_t nextion_protocol_send_encoded_get_number(nextion_t *handle, int32_t *number, encoder_t *encoder)
+{
+    if (!nextion_protocol_end_encoding(encoder))
+    {
+        return NEX_FAIL;
+    }
+
+    parser_t parser = PARSER_NUMBER(number, sizeof(int32_t));
+
+    nex_err_t code = nextion_protocol_send_instruction(handle, encoder->buffer, encoder->length, &parser);
+
+    if (code == NEX_DVC_RSP_GET_NUMBER)
     {
         return NEX_OK;
     }
 
     return code;
+}
+
+nex_err_t nextion_protocol_send_encoded_tdm_start(nextion_t *handle, encoder_t *encoder, size_t data_length)
+{
+    if (!nextion_protocol_end_encoding(encoder))
+    {
+        return NEX_FAIL;
+    }
+
+    parser_t parser = PARSER_TDM_START();
+
+    nex_err_t code = nextion_protocol_send_instruction(handle, encoder->buffer, encoder->length, &parser);
+
+    if (code == NEX_DVC_RSP_TRANSPARENT_DATA_READY)
+    {
+        nextion_protocol_set_tdm_length(handle, data_length);
+
+        return NEX_OK;
+    }
+
+    return code;
+}
+
+nex_err_t nextion_protocol_send_instruction_ack_async(nextion_t *handle,
+                                                      nextion_async_callback_t callback,
+                                                      void *context,
+                                                      const char *instruction,
+                                                      ...)
+{
+    va_list args;
+    va_start(args, instruction);
+
+    formated_instruction_t formated_instruction;
+
+    if (!nextion_protocol_format_instruction_variadic(&formated_instruction, instruction, args))
+    {
+        va_end(args);
+
+        return NEX_FAIL;
+    }
+
+    va_end(args);
+
+    parser_t parser = PARSER_ACK();
+
+    return nextion_protocol_send_instruction_async(handle,
+                                                   formated_instruction.text,
+                                                   formated_instruction.length,
+                                                   &parser,
+                                                   NEX_DVC_INS_OK,
+                                                   callback,
+                                                   context);
+}
+
+nex_err_t nextion_protocol_send_instruction_get_text_async(nextion_t *handle,
+                                                           char *buffer,
+                                                           size_t buffer_length,
+                                                           nextion_async_callback_t callback,
+                                                           void *context,
+                                                           const char *instruction,
+                                                           ...)
+{
+    va_list args;
+    va_start(args, instruction);
+
+    formated_instruction_t formated_instruction;
+
+    if (!nextion_protocol_format_instruction_variadic(&formated_instruction, instruction, args))
+    {
+        va_end(args);
+
+        return NEX_FAIL;
+    }
+
+    va_end(args);
+
+    parser_t parser = PARSER_TEXT(buffer, buffer_length);
+
+    return nextion_protocol_send_instruction_async(handle,
+                                                   formated_instruction.text,
+                                                   formated_instruction.length,
+                                                   &parser,
+                                                   NEX_DVC_RSP_GET_TEXT,
+                                                   callback,
+                                                   context);
+}
+
+nex_err_t nextion_protocol_send_instruction_get_number_async(nextion_t *handle,
+                                                             int32_t *number,
+                                                             nextion_async_callback_t callback,
+                                                             void *context,
+                                                             const char *instruction,
+                                                             ...)
+{
+    va_list args;
+    va_start(args, instruction);
+
+    formated_instruction_t formated_instruction;
+
+    if (!nextion_protocol_format_instruction_variadic(&formated_instruction, instruction, args))
+    {
+        va_end(args);
+
+        return NEX_FAIL;
+    }
+
+    va_end(args);
+
+    parser_t parser = PARSER_NUMBER(number, sizeof(int32_t));
+
+    return nextion_protocol_send_instruction_async(handle,
+                                                   formated_instruction.text,
+                                                   formated_instruction.length,
+                                                   &parser,
+                                                   NEX_DVC_RSP_GET_NUMBER,
+                                                   callback,
+                                                   context);
+}
+
+nex_err_t nextion_protocol_send_encoded_ack_async(nextion_t *handle,
+                                                  nextion_async_callback_t callback,
+                                                  void *context,
+                                                  encoder_t *encoder)
+{
+    if (!nextion_protocol_end_encoding(encoder))
+    {
+        return NEX_FAIL;
+    }
+
+    parser_t parser = PARSER_ACK();
+
+    return nextion_protocol_send_instruction_async(handle,
+                                                   encoder->buffer,
+                                                   encoder->length,
+                                                   &parser,
+                                                   NEX_DVC_INS_OK,
+                                                   callback,
+                                                   context);
 }
\ No newline at end of file
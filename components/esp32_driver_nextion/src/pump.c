@@ -0,0 +1,354 @@
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp32_driver_nextion/base/constants.h"
+#include "esp32_driver_nextion/pump.h"
+#include "protocol/protocol.h"
+#include "waveform_pump.h"
+#include "assertion.h"
+#include "config.h"
+
+#ifdef CONFIG_NEX_WAVEFORM_PUMP
+/**
+ * @brief Most samples streamed at once; "addt" takes less than NEX_DVC_TRANSPARENT_DATA_MAX_DATA_SIZE - 20.
+ */
+#define PUMP_CHUNK_MAX_LENGTH (NEX_DVC_TRANSPARENT_DATA_MAX_DATA_SIZE - 21U)
+
+/**
+ * @brief Longest "addt" instruction: "addt 255,255,1002", plus the null terminator.
+ */
+#define PUMP_INSTRUCTION_MAX_LENGTH 18U
+
+/**
+ * @brief Bits the UART sends per byte: start, eight data and stop.
+ */
+#define PUMP_BITS_PER_BYTE 10U
+
+/**
+ * @brief Index following another on a ring.
+ */
+#define PUMP_NEXT_INDEX(index) (((index) + 1U) % CONFIG_NEX_WAVEFORM_PUMP_RING_SIZE)
+
+static nex_err_t nextion_pump_drain(nextion_t *handle);
+static size_t nextion_pump_chunk_length(const nextion_t *handle, uint32_t period_ms);
+static nex_err_t nextion_pump_stream(nextion_t *handle, nextion_pump_channel_t *channel, size_t chunk_length);
+static void nextion_pump_task(void *pv);
+#endif
+
+nextion_pump_channel_t *nextion_pump_open(nextion_t *handle, uint8_t waveform_id, uint8_t channel_id)
+{
+    CMP_CHECK_HANDLE(handle, NULL)
+
+#ifdef CONFIG_NEX_WAVEFORM_PUMP
+    waveform_pump_t *pump = nextion_protocol_get_pump(handle);
+    nextion_pump_channel_t *channel = NULL;
+
+    xSemaphoreTake(pump->drain_sync, portMAX_DELAY);
+
+    for (size_t i = 0; i < CONFIG_NEX_WAVEFORM_PUMP_CHANNELS; i++)
+    {
+        nextion_pump_channel_t *current = &pump->channels[i];
+
+        if (!current->is_open)
+        {
+            channel = channel == NULL ? current : channel;
+        }
+        else if (current->waveform_id == waveform_id && current->channel_id == channel_id)
+        {
+            // Two producers on the same channel would break the ring.
+            xSemaphoreGive(pump->drain_sync);
+
+            CMP_LOGE("channel error(already open)");
+
+            return NULL;
+        }
+    }
+
+    if (channel != NULL)
+    {
+        atomic_store_explicit(&channel->head, 0, memory_order_relaxed);
+        atomic_store_explicit(&channel->tail, 0, memory_order_relaxed);
+        atomic_store_explicit(&channel->dropped, 0, memory_order_relaxed);
+
+        channel->waveform_id = waveform_id;
+        channel->channel_id = channel_id;
+        channel->is_open = true;
+    }
+
+    xSemaphoreGive(pump->drain_sync);
+
+    CMP_CHECK((channel != NULL), "channel error(all open)", NULL)
+
+    return channel;
+#else
+    CMP_LOGW("waveform pump disabled: enable CONFIG_NEX_WAVEFORM_PUMP");
+
+    return NULL;
+#endif
+}
+
+nex_err_t nextion_pump_close(nextion_t *handle, nextion_pump_channel_t *channel)
+{
+    CMP_CHECK_HANDLE(handle, NEX_FAIL)
+    CMP_CHECK((channel != NULL), "channel error(NULL)", NEX_FAIL)
+
+#ifdef CONFIG_NEX_WAVEFORM_PUMP
+    waveform_pump_t *pump = nextion_protocol_get_pump(handle);
+
+    // Never close a channel while it is streamed.
+    xSemaphoreTake(pump->drain_sync, portMAX_DELAY);
+
+    const bool was_open = channel->is_open;
+
+    channel->is_open = false;
+
+    xSemaphoreGive(pump->drain_sync);
+
+    CMP_CHECK((was_open), "channel error(not open)", NEX_FAIL)
+
+    return NEX_OK;
+#else
+    CMP_LOGW("waveform pump disabled: enable CONFIG_NEX_WAVEFORM_PUMP");
+
+    return NEX_FAIL;
+#endif
+}
+
+bool nextion_pump_push(nextion_pump_channel_t *channel, uint8_t value)
+{
+    // No checks nor logs: may run on an interrupt.
+#ifdef CONFIG_NEX_WAVEFORM_PUMP
+    const size_t head = atomic_load_explicit(&channel->head, memory_order_relaxed);
+    const size_t next = PUMP_NEXT_INDEX(head);
+
+    if (next == atomic_load_explicit(&channel->tail, memory_order_acquire))
+    {
+        const size_t dropped = atomic_load_explicit(&channel->dropped, memory_order_relaxed);
+
+        atomic_store_explicit(&channel->dropped, dropped + 1U, memory_order_relaxed);
+
+        return false;
+    }
+
+    channel->samples[head] = value;
+
+    // Publishes the sample only after it is stored.
+    atomic_store_explicit(&channel->head, next, memory_order_release);
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+size_t nextion_pump_push_buffer(nextion_pump_channel_t *channel, const uint8_t *values, size_t value_count)
+{
+    // No checks nor logs: may run on an interrupt.
+#ifdef CONFIG_NEX_WAVEFORM_PUMP
+    const size_t head = atomic_load_explicit(&channel->head, memory_order_relaxed);
+    const size_t tail = atomic_load_explicit(&channel->tail, memory_order_acquire);
+    const size_t free_count = (tail + CONFIG_NEX_WAVEFORM_PUMP_RING_SIZE - head - 1U) % CONFIG_NEX_WAVEFORM_PUMP_RING_SIZE;
+    const size_t count = value_count < free_count ? value_count : free_count;
+    const size_t until_end = CONFIG_NEX_WAVEFORM_PUMP_RING_SIZE - head;
+    const size_t first_count = count < until_end ? count : until_end;
+
+    // At most two copies: up to the end of the ring, then from its start.
+    memcpy(channel->samples + head, values, first_count);
+    memcpy(channel->samples, values + first_count, count - first_count);
+
+    atomic_store_explicit(&channel->head, (head + count) % CONFIG_NEX_WAVEFORM_PUMP_RING_SIZE, memory_order_release);
+
+    if (count < value_count)
+    {
+        const size_t dropped = atomic_load_explicit(&channel->dropped, memory_order_relaxed);
+
+        atomic_store_explicit(&channel->dropped, dropped + (value_count - count), memory_order_relaxed);
+    }
+
+    return count;
+#else
+    return 0;
+#endif
+}
+
+size_t nextion_pump_get_dropped(const nextion_pump_channel_t *channel)
+{
+    CMP_CHECK((channel != NULL), "channel error(NULL)", 0)
+
+#ifdef CONFIG_NEX_WAVEFORM_PUMP
+    return atomic_load_explicit(&channel->dropped, memory_order_relaxed);
+#else
+    return 0;
+#endif
+}
+
+nex_err_t nextion_pump_flush(nextion_t *handle)
+{
+    CMP_CHECK_HANDLE(handle, NEX_FAIL)
+
+#ifdef CONFIG_NEX_WAVEFORM_PUMP
+    return nextion_pump_drain(handle);
+#else
+    CMP_LOGW("waveform pump disabled: enable CONFIG_NEX_WAVEFORM_PUMP");
+
+    return NEX_FAIL;
+#endif
+}
+
+nex_err_t nextion_pump_set_period(nextion_t *handle, uint32_t period_ms)
+{
+    CMP_CHECK_HANDLE(handle, NEX_FAIL)
+    CMP_CHECK((pdMS_TO_TICKS(period_ms) > 0), "period_ms error(less than a tick)", NEX_FAIL)
+
+#ifdef CONFIG_NEX_WAVEFORM_PUMP
+    nextion_protocol_get_pump(handle)->period_ms = period_ms;
+
+    return NEX_OK;
+#else
+    CMP_LOGW("waveform pump disabled: enable CONFIG_NEX_WAVEFORM_PUMP");
+
+    return NEX_FAIL;
+#endif
+}
+
+#ifdef CONFIG_NEX_WAVEFORM_PUMP
+bool nextion_pump_init(waveform_pump_t *pump, nextion_t *handle)
+{
+    pump->period_ms = CONFIG_NEX_WAVEFORM_PUMP_PERIOD_MS;
+    pump->drain_sync = xSemaphoreCreateMutex();
+
+    for (size_t i = 0; i < CONFIG_NEX_WAVEFORM_PUMP_CHANNELS; i++)
+    {
+        pump->channels[i].is_open = false;
+    }
+
+    if (pump->drain_sync == NULL)
+    {
+        return false;
+    }
+
+    if (xTaskCreate(&nextion_pump_task,
+                    "nextion_pump",
+                    3072,
+                    (void *)handle,
+                    CONFIG_NEX_UART_TASK_PRIORITY,
+                    &pump->task) != pdPASS)
+    {
+        vSemaphoreDelete(pump->drain_sync);
+
+        return false;
+    }
+
+    return true;
+}
+
+void nextion_pump_deinit(waveform_pump_t *pump)
+{
+    // Never stop the task half way through a stream.
+    xSemaphoreTake(pump->drain_sync, portMAX_DELAY);
+
+    vTaskDelete(pump->task);
+    vSemaphoreDelete(pump->drain_sync);
+}
+
+static nex_err_t nextion_pump_drain(nextion_t *handle)
+{
+    waveform_pump_t *pump = nextion_protocol_get_pump(handle);
+    nex_err_t code = NEX_OK;
+
+    xSemaphoreTake(pump->drain_sync, portMAX_DELAY);
+
+    const size_t chunk_length = nextion_pump_chunk_length(handle, pump->period_ms);
+
+    for (size_t i = 0; i < CONFIG_NEX_WAVEFORM_PUMP_CHANNELS; i++)
+    {
+        if (pump->channels[i].is_open && nextion_pump_stream(handle, &pump->channels[i], chunk_length) != NEX_OK)
+        {
+            code = NEX_FAIL;
+        }
+    }
+
+    xSemaphoreGive(pump->drain_sync);
+
+    return code;
+}
+
+static size_t nextion_pump_chunk_length(const nextion_t *handle, uint32_t period_ms)
+{
+    // What the UART carries in a period: longer streams would hold
+    // the other instructions back for more than a period.
+    const uint64_t length = (uint64_t)nextion_protocol_get_baud_rate(handle) * period_ms / (PUMP_BITS_PER_BYTE * 1000U);
+
+    if (length == 0)
+    {
+        return 1;
+    }
+
+    return length < PUMP_CHUNK_MAX_LENGTH ? (size_t)length : PUMP_CHUNK_MAX_LENGTH;
+}
+
+static nex_err_t nextion_pump_stream(nextion_t *handle, nextion_pump_channel_t *channel, size_t chunk_length)
+{
+    // Only what was pushed until now; the rest goes on the next period.
+    const size_t head = atomic_load_explicit(&channel->head, memory_order_acquire);
+    size_t tail = atomic_load_explicit(&channel->tail, memory_order_relaxed);
+    char instruction[PUMP_INSTRUCTION_MAX_LENGTH];
+    nex_err_t code = NEX_OK;
+    encoder_t encoder;
+
+    while (tail != head && code == NEX_OK)
+    {
+        const size_t available = (head + CONFIG_NEX_WAVEFORM_PUMP_RING_SIZE - tail) % CONFIG_NEX_WAVEFORM_PUMP_RING_SIZE;
+        const size_t length = available < chunk_length ? available : chunk_length;
+        const size_t until_end = CONFIG_NEX_WAVEFORM_PUMP_RING_SIZE - tail;
+        const size_t first_length = length < until_end ? length : until_end;
+        const int32_t parameters[] = {channel->waveform_id, channel->channel_id, (int32_t)length};
+
+        encoder_begin(&encoder, instruction, sizeof(instruction));
+        ENCODER_APPEND_LITERAL(&encoder, "addt ");
+        encoder_append_numbers(&encoder, parameters, 3);
+        encoder_end(&encoder);
+
+        // Samples wrapping around the ring are sent in two writes of the same stream. It
+        // is sent holding the lock: other tasks' instructions would be taken as samples.
+        const tdm_stream_t stream = {.instruction = instruction,
+                                     .instruction_length = encoder.length,
+                                     .data = channel->samples + tail,
+                                     .data_length = first_length,
+                                     .tail_data = channel->samples,
+                                     .tail_length = length - first_length};
+
+        code = nextion_protocol_send_tdm_streams(handle, &stream, 1);
+
+        // Failed samples are dropped with the rest: retrying would stall the channel,
+        // as it fails the same way while the waveform is not on the current page.
+        tail = code == NEX_OK ? (tail + length) % CONFIG_NEX_WAVEFORM_PUMP_RING_SIZE : head;
+
+        // Frees the slots only after they were sent.
+        atomic_store_explicit(&channel->tail, tail, memory_order_release);
+    }
+
+    if (code != NEX_OK)
+    {
+        CMP_LOGW("failed streaming waveform %d channel %d", channel->waveform_id, channel->channel_id);
+    }
+
+    return code;
+}
+
+static void nextion_pump_task(void *pv)
+{
+    nextion_t *handle = (nextion_t *)pv;
+    waveform_pump_t *pump = nextion_protocol_get_pump(handle);
+    TickType_t period_start = xTaskGetTickCount();
+
+    while (true)
+    {
+        vTaskDelayUntil(&period_start, pdMS_TO_TICKS(pump->period_ms));
+
+        // Failures were logged; their samples are dropped.
+        nextion_pump_drain(handle);
+    }
+}
+#endif
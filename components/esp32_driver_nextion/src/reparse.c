@@ -0,0 +1,81 @@
+#include "esp32_driver_nextion/reparse.h"
+#include "protocol/protocol.h"
+#include "assertion.h"
+
+/**
+ * @brief Sent to leave the Protocol Reparse mode; the device parses nothing else meanwhile.
+ */
+#define REPARSE_EXIT_INSTRUCTION "DRAKJHSUYDGBNCJHGJKSHBDN"
+
+/**
+ * @brief Index of the checksum in a frame.
+ */
+#define REPARSE_CHECKSUM_INDEX (NEXTION_REPARSE_FRAME_LENGTH - 1U)
+
+nex_err_t nextion_reparse_begin(nextion_t *handle)
+{
+    CMP_CHECK_HANDLE(handle, NEX_FAIL)
+
+    // Still parsed as an instruction: its result is returned as usual.
+    return nextion_protocol_send_instruction_ack(handle, "recmod=1");
+}
+
+nex_err_t nextion_reparse_end(nextion_t *handle)
+{
+    CMP_CHECK_HANDLE(handle, NEX_FAIL)
+
+    // Nothing is returned for it.
+    return nextion_protocol_send_instruction(handle, REPARSE_EXIT_INSTRUCTION, sizeof(REPARSE_EXIT_INSTRUCTION) - 1, NULL);
+}
+
+void nextion_reparse_encode(uint8_t *frame,
+                            nextion_reparse_opcode_t opcode,
+                            uint8_t component_id,
+                            int32_t value)
+{
+    const uint32_t bits = (uint32_t)value;
+    uint8_t checksum = 0;
+
+    frame[0] = (uint8_t)opcode;
+    frame[1] = component_id;
+    frame[2] = (uint8_t)bits;
+    frame[3] = (uint8_t)(bits >> 8);
+    frame[4] = (uint8_t)(bits >> 16);
+    frame[5] = (uint8_t)(bits >> 24);
+
+    // Lets the script find the next frame after a byte is lost.
+    for (size_t i = 0; i < REPARSE_CHECKSUM_INDEX; i++)
+    {
+        checksum += frame[i];
+    }
+
+    frame[REPARSE_CHECKSUM_INDEX] = checksum;
+}
+
+nex_err_t nextion_reparse_send(const nextion_t *handle,
+                               nextion_reparse_opcode_t opcode,
+                               uint8_t component_id,
+                               int32_t value)
+{
+    CMP_CHECK_HANDLE(handle, NEX_FAIL)
+
+    uint8_t frame[NEXTION_REPARSE_FRAME_LENGTH];
+
+    nextion_reparse_encode(frame, opcode, component_id, value);
+
+    return nextion_protocol_send_raw(handle, frame, NEXTION_REPARSE_FRAME_LENGTH);
+}
+
+nex_err_t nextion_reparse_send_frames(const nextion_t *handle, const uint8_t *frames, size_t frame_count)
+{
+    CMP_CHECK_HANDLE(handle, NEX_FAIL)
+    CMP_CHECK((frames != NULL), "frames error(NULL)", NEX_FAIL)
+    CMP_CHECK((frame_count > 0), "frame_count error(0)", NEX_FAIL)
+
+    return nextion_protocol_send_raw(handle, frames, frame_count * NEXTION_REPARSE_FRAME_LENGTH);
+}
+
+nex_err_t nextion_reparse_set_value(const nextion_t *handle, uint8_t component_id, int32_t number)
+{
+    return nextion_reparse_send(handle, NEXTION_REPARSE_OPCODE_SET_VALUE, component_id, number);
+}
@@ -0,0 +1,230 @@
+#include <math.h>
+#include "esp32_driver_nextion/scale.h"
+#include "assertion.h"
+
+/**
+ * @brief Largest waveform sample.
+ */
+#define SCALE_SAMPLE_MAX 255.0f
+
+static inline uint8_t nextion_scale_quantize(float sample);
+static nex_err_t nextion_scale_autorange_update(nextion_scale_autorange_t *autorange, float min, float max, nextion_scale_t *scale);
+
+nex_err_t nextion_scale_init(nextion_scale_t *scale, float min, float max)
+{
+    CMP_CHECK((scale != NULL), "scale error(NULL)", NEX_FAIL)
+    CMP_CHECK((max > min), "max error(<=min)", NEX_FAIL)
+
+    // Divided once here, so converting takes only a multiplication.
+    scale->offset = min;
+    scale->gain = SCALE_SAMPLE_MAX / (max - min);
+
+    return NEX_OK;
+}
+
+nex_err_t nextion_scale_int16(const nextion_scale_t *scale, const int16_t *values, size_t count, uint8_t *output)
+{
+    CMP_CHECK((scale != NULL), "scale error(NULL)", NEX_FAIL)
+    CMP_CHECK((values != NULL), "values error(NULL)", NEX_FAIL)
+    CMP_CHECK((output != NULL), "output error(NULL)", NEX_FAIL)
+
+    const float offset = scale->offset;
+    const float gain = scale->gain;
+
+    // Every 16 bits integer is exact as a float.
+    for (size_t i = 0; i < count; i++)
+    {
+        output[i] = nextion_scale_quantize(((float)values[i] - offset) * gain);
+    }
+
+    return NEX_OK;
+}
+
+nex_err_t nextion_scale_int32(const nextion_scale_t *scale, const int32_t *values, size_t count, uint8_t *output)
+{
+    CMP_CHECK((scale != NULL), "scale error(NULL)", NEX_FAIL)
+    CMP_CHECK((values != NULL), "values error(NULL)", NEX_FAIL)
+    CMP_CHECK((output != NULL), "output error(NULL)", NEX_FAIL)
+
+    // Large values lose precision as floats; the integer part of the
+    // offset is subtracted before, so only the difference is converted.
+    const int64_t base = (int64_t)floorf(scale->offset);
+    const float fraction = scale->offset - (float)base;
+    const float gain = scale->gain;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        output[i] = nextion_scale_quantize(((float)((int64_t)values[i] - base) - fraction) * gain);
+    }
+
+    return NEX_OK;
+}
+
+nex_err_t nextion_scale_float(const nextion_scale_t *scale, const float *values, size_t count, uint8_t *output)
+{
+    CMP_CHECK((scale != NULL), "scale error(NULL)", NEX_FAIL)
+    CMP_CHECK((values != NULL), "values error(NULL)", NEX_FAIL)
+    CMP_CHECK((output != NULL), "output error(NULL)", NEX_FAIL)
+
+    const float offset = scale->offset;
+    const float gain = scale->gain;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        output[i] = nextion_scale_quantize((values[i] - offset) * gain);
+    }
+
+    return NEX_OK;
+}
+
+nex_err_t nextion_scale_autorange_init(nextion_scale_autorange_t *autorange, size_t batch_count)
+{
+    CMP_CHECK((autorange != NULL), "autorange error(NULL)", NEX_FAIL)
+    CMP_CHECK((batch_count > 0 && batch_count <= NEXTION_SCALE_AUTORANGE_MAX_BATCHES), "batch_count error(0 or >NEXTION_SCALE_AUTORANGE_MAX_BATCHES)", NEX_FAIL)
+
+    autorange->batch_count = batch_count;
+    autorange->head = 0;
+    autorange->used = 0;
+
+    return NEX_OK;
+}
+
+nex_err_t nextion_scale_autorange_int16(nextion_scale_autorange_t *autorange,
+                                        const int16_t *values,
+                                        size_t count,
+                                        uint8_t *output,
+                                        nextion_scale_t *scale)
+{
+    CMP_CHECK((autorange != NULL), "autorange error(NULL)", NEX_FAIL)
+    CMP_CHECK((values != NULL), "values error(NULL)", NEX_FAIL)
+    CMP_CHECK((count > 0), "count error(0)", NEX_FAIL)
+
+    nextion_scale_t used_scale;
+    int16_t min = values[0];
+    int16_t max = values[0];
+
+    for (size_t i = 1; i < count; i++)
+    {
+        min = values[i] < min ? values[i] : min;
+        max = values[i] > max ? values[i] : max;
+    }
+
+    if (nextion_scale_autorange_update(autorange, min, max, &used_scale) != NEX_OK)
+    {
+        return NEX_FAIL;
+    }
+
+    if (scale != NULL)
+    {
+        *scale = used_scale;
+    }
+
+    return nextion_scale_int16(&used_scale, values, count, output);
+}
+
+nex_err_t nextion_scale_autorange_int32(nextion_scale_autorange_t *autorange,
+                                        const int32_t *values,
+                                        size_t count,
+                                        uint8_t *output,
+                                        nextion_scale_t *scale)
+{
+    CMP_CHECK((autorange != NULL), "autorange error(NULL)", NEX_FAIL)
+    CMP_CHECK((values != NULL), "values error(NULL)", NEX_FAIL)
+    CMP_CHECK((count > 0), "count error(0)", NEX_FAIL)
+
+    nextion_scale_t used_scale;
+    int32_t min = values[0];
+    int32_t max = values[0];
+
+    for (size_t i = 1; i < count; i++)
+    {
+        min = values[i] < min ? values[i] : min;
+        max = values[i] > max ? values[i] : max;
+    }
+
+    if (nextion_scale_autorange_update(autorange, (float)min, (float)max, &used_scale) != NEX_OK)
+    {
+        return NEX_FAIL;
+    }
+
+    if (scale != NULL)
+    {
+        *scale = used_scale;
+    }
+
+    return nextion_scale_int32(&used_scale, values, count, output);
+}
+
+nex_err_t nextion_scale_autorange_float(nextion_scale_autorange_t *autorange,
+                                        const float *values,
+                                        size_t count,
+                                        uint8_t *output,
+                                        nextion_scale_t *scale)
+{
+    CMP_CHECK((autorange != NULL), "autorange error(NULL)", NEX_FAIL)
+    CMP_CHECK((values != NULL), "values error(NULL)", NEX_FAIL)
+    CMP_CHECK((count > 0), "count error(0)", NEX_FAIL)
+
+    nextion_scale_t used_scale;
+    float min = INFINITY;
+    float max = -INFINITY;
+
+    // Comparisons with NaN are false, so it never becomes the minimum nor the maximum.
+    for (size_t i = 0; i < count; i++)
+    {
+        min = values[i] < min ? values[i] : min;
+        max = values[i] > max ? values[i] : max;
+    }
+
+    if (nextion_scale_autorange_update(autorange, min, max, &used_scale) != NEX_OK)
+    {
+        return NEX_FAIL;
+    }
+
+    if (scale != NULL)
+    {
+        *scale = used_scale;
+    }
+
+    return nextion_scale_float(&used_scale, values, count, output);
+}
+
+static inline uint8_t nextion_scale_quantize(float sample)
+{
+    // Rounded, not truncated. Written without branches on the value,
+    // so the compiler can vectorize the loops; NaN fails both and is 0.
+    sample += 0.5f;
+    sample = sample > 0.0f ? sample : 0.0f;
+    sample = sample < SCALE_SAMPLE_MAX ? sample : SCALE_SAMPLE_MAX;
+
+    return (uint8_t)sample;
+}
+
+static nex_err_t nextion_scale_autorange_update(nextion_scale_autorange_t *autorange, float min, float max, nextion_scale_t *scale)
+{
+    // Batches with no number keep the window as it is.
+    if (min <= max)
+    {
+        autorange->mins[autorange->head] = min;
+        autorange->maxs[autorange->head] = max;
+        autorange->head = (autorange->head + 1U) % autorange->batch_count;
+        autorange->used = autorange->used < autorange->batch_count ? autorange->used + 1U : autorange->used;
+    }
+
+    float window_min = autorange->used > 0 ? autorange->mins[0] : 0.0f;
+    float window_max = autorange->used > 0 ? autorange->maxs[0] : 0.0f;
+
+    for (size_t i = 1; i < autorange->used; i++)
+    {
+        window_min = autorange->mins[i] < window_min ? autorange->mins[i] : window_min;
+        window_max = autorange->maxs[i] > window_max ? autorange->maxs[i] : window_max;
+    }
+
+    // A flat signal is drawn at the bottom.
+    if (window_max <= window_min)
+    {
+        window_max = window_min + 1.0f;
+    }
+
+    return nextion_scale_init(scale, window_min, window_max);
+}
@@ -0,0 +1,605 @@
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp32_driver_nextion/shadow.h"
+#include "protocol/protocol.h"
+#include "shadow_cache.h"
+#include "assertion.h"
+#include "config.h"
+
+#ifdef CONFIG_NEX_SHADOW_CACHE
+/**
+ * @typedef shadow_value_t
+ * @brief Value being set.
+ */
+typedef struct
+{
+    const char *text;   /*!< Text set, or NULL for numbers. */
+    size_t text_length; /*!< Text length. */
+    int32_t number;     /*!< Number set. */
+} shadow_value_t;
+
+static nex_err_t nextion_shadow_send(nextion_t *handle, encoder_t *encoder, size_t path_length, const shadow_value_t *value);
+static const shadow_entry_t *nextion_shadow_find_fresh(shadow_cache_t *cache,
+                                                       uint32_t hash,
+                                                       const char *path,
+                                                       size_t path_length,
+                                                       bool is_text);
+static void nextion_shadow_remember(nextion_t *handle,
+                                    uint32_t generation,
+                                    uint32_t hash,
+                                    const char *path,
+                                    size_t path_length,
+                                    uint32_t ttl_ms,
+                                    const shadow_value_t *value);
+static int16_t nextion_shadow_query_component_id(nextion_t *handle, const char *path, size_t component_length);
+static uint32_t nextion_shadow_hash(const char *path, size_t path_length);
+static size_t nextion_shadow_component_length(const char *path, size_t path_length);
+static shadow_entry_t *nextion_shadow_find(shadow_cache_t *cache, uint32_t hash, const char *path, size_t path_length);
+static int16_t nextion_shadow_find_component_id(const shadow_cache_t *cache, const char *path, size_t component_length);
+static bool nextion_shadow_equals(const shadow_entry_t *entry, const shadow_value_t *value);
+static void nextion_shadow_store(shadow_cache_t *cache,
+                                 shadow_entry_t *entry,
+                                 uint32_t hash,
+                                 const char *path,
+                                 size_t path_length,
+                                 const shadow_value_t *value,
+                                 uint32_t ttl_ms,
+                                 int16_t component_id);
+static void nextion_shadow_remove(shadow_cache_t *cache, shadow_entry_t *entry);
+static void nextion_shadow_forget_path(shadow_cache_t *cache, const char *path, size_t path_length);
+#endif
+
+nex_err_t nextion_shadow_clear(nextion_t *handle)
+{
+    CMP_CHECK_HANDLE(handle, NEX_FAIL)
+
+#ifdef CONFIG_NEX_SHADOW_CACHE
+    nextion_shadow_clear_all(nextion_protocol_get_shadow(handle));
+
+    return NEX_OK;
+#else
+    CMP_LOGW("shadow cache disabled: enable CONFIG_NEX_SHADOW_CACHE");
+
+    return NEX_FAIL;
+#endif
+}
+
+nex_err_t nextion_shadow_get_stats(nextion_t *handle, nextion_shadow_stats_t *stats)
+{
+    CMP_CHECK_HANDLE(handle, NEX_FAIL)
+    CMP_CHECK((stats != NULL), "stats error(NULL)", NEX_FAIL)
+
+#ifdef CONFIG_NEX_SHADOW_CACHE
+    shadow_cache_t *cache = nextion_protocol_get_shadow(handle);
+
+    portENTER_CRITICAL(&cache->lock);
+    memcpy(stats, &cache->stats, sizeof(nextion_shadow_stats_t));
+    portEXIT_CRITICAL(&cache->lock);
+
+    return NEX_OK;
+#else
+    CMP_LOGW("shadow cache disabled: enable CONFIG_NEX_SHADOW_CACHE");
+
+    return NEX_FAIL;
+#endif
+}
+
+nex_err_t nextion_shadow_reset_stats(nextion_t *handle)
+{
+    CMP_CHECK_HANDLE(handle, NEX_FAIL)
+
+#ifdef CONFIG_NEX_SHADOW_CACHE
+    shadow_cache_t *cache = nextion_protocol_get_shadow(handle);
+
+    portENTER_CRITICAL(&cache->lock);
+    memset(&cache->stats, 0, sizeof(nextion_shadow_stats_t));
+    portEXIT_CRITICAL(&cache->lock);
+
+    return NEX_OK;
+#else
+    CMP_LOGW("shadow cache disabled: enable CONFIG_NEX_SHADOW_CACHE");
+
+    return NEX_FAIL;
+#endif
+}
+
+#ifdef CONFIG_NEX_SHADOW_CACHE
+void nextion_shadow_init(shadow_cache_t *cache)
+{
+    portMUX_INITIALIZE(&cache->lock);
+
+    cache->generation = 0;
+    cache->clock = 0;
+    cache->count = 0;
+
+    memset(&cache->stats, 0, sizeof(nextion_shadow_stats_t));
+}
+
+void nextion_shadow_clear_all(shadow_cache_t *cache)
+{
+    portENTER_CRITICAL(&cache->lock);
+
+    cache->count = 0;
+    cache->generation++;
+
+    portEXIT_CRITICAL(&cache->lock);
+}
+
+void nextion_shadow_touch(shadow_cache_t *cache, uint8_t component_id)
+{
+    portENTER_CRITICAL(&cache->lock);
+
+    // Backwards, as removing moves the last entry into the gap.
+    for (size_t i = cache->count; i > 0; i--)
+    {
+        shadow_entry_t *entry = &cache->entries[i - 1];
+
+        if (entry->component_id == component_id || entry->component_id == SHADOW_COMPONENT_ID_UNKNOWN)
+        {
+            nextion_shadow_remove(cache, entry);
+        }
+    }
+
+    // Reads in flight may have got the value before the touch.
+    cache->generation++;
+
+    portEXIT_CRITICAL(&cache->lock);
+}
+
+void nextion_shadow_forget(nextion_t *handle, const char *component_name, const char *property_name)
+{
+    shadow_cache_t *cache = nextion_protocol_get_shadow(handle);
+    char path[NEXTION_PROPERTY_PATH_MAX_LENGTH + 1];
+    encoder_t encoder;
+
+    encoder_begin(&encoder, path, sizeof(path));
+    encoder_append_property(&encoder, component_name, property_name);
+
+    // Too long to have been remembered.
+    if (!encoder_end(&encoder))
+    {
+        return;
+    }
+
+    nextion_shadow_forget_path(cache, path, encoder.length);
+}
+
+void nextion_shadow_forget_assignment(nextion_t *handle, const char *instruction, size_t instruction_length)
+{
+    // Only "component.property=value" is recognized; a longer path was never remembered.
+    const size_t search_length = instruction_length <= NEXTION_PROPERTY_PATH_MAX_LENGTH ? instruction_length : NEXTION_PROPERTY_PATH_MAX_LENGTH + 1;
+    const char *assignment = (const char *)memchr(instruction, '=', search_length);
+
+    if (assignment == NULL)
+    {
+        return;
+    }
+
+    nextion_shadow_forget_path(nextion_protocol_get_shadow(handle), instruction, (size_t)(assignment - instruction));
+}
+
+nex_err_t nextion_shadow_send_number(nextion_t *handle, encoder_t *encoder, size_t path_length, int32_t number)
+{
+    const shadow_value_t value = {.text = NULL, .text_length = 0, .number = number};
+
+    return nextion_shadow_send(handle, encoder, path_length, &value);
+}
+
+nex_err_t nextion_shadow_send_text(nextion_t *handle, encoder_t *encoder, size_t path_length, const char *text)
+{
+    const shadow_value_t value = {.text = text, .text_length = strlen(text), .number = 0};
+
+    return nextion_shadow_send(handle, encoder, path_length, &value);
+}
+
+nex_err_t nextion_shadow_get_number(nextion_t *handle,
+                                    const char *query,
+                                    size_t query_length,
+                                    uint32_t ttl_ms,
+                                    int32_t *number)
+{
+    const char *path = query + NEXTION_PROPERTY_QUERY_PREFIX_LENGTH;
+    const size_t path_length = query_length - NEXTION_PROPERTY_QUERY_PREFIX_LENGTH;
+
+    if (ttl_ms == 0 || path_length > NEXTION_PROPERTY_PATH_MAX_LENGTH)
+    {
+        return nextion_instruction_send_get_number(handle, query, query_length, number);
+    }
+
+    shadow_cache_t *cache = nextion_protocol_get_shadow(handle);
+    const uint32_t hash = nextion_shadow_hash(path, path_length);
+
+    portENTER_CRITICAL(&cache->lock);
+
+    const shadow_entry_t *entry = nextion_shadow_find_fresh(cache, hash, path, path_length, false);
+    const uint32_t generation = cache->generation;
+    const bool is_hit = entry != NULL;
+
+    if (is_hit)
+    {
+        *number = entry->number;
+    }
+
+    portEXIT_CRITICAL(&cache->lock);
+
+    if (is_hit)
+    {
+        return NEX_OK;
+    }
+
+    nex_err_t code = nextion_instruction_send_get_number(handle, query, query_length, number);
+
+    if (code == NEX_OK)
+    {
+        const shadow_value_t value = {.text = NULL, .text_length = 0, .number = *number};
+
+        nextion_shadow_remember(handle, generation, hash, path, path_length, ttl_ms, &value);
+    }
+
+    return code;
+}
+
+nex_err_t nextion_shadow_get_text(nextion_t *handle,
+                                  const char *query,
+                                  size_t query_length,
+                                  uint32_t ttl_ms,
+                                  char *buffer,
+                                  size_t buffer_length)
+{
+    const char *path = query + NEXTION_PROPERTY_QUERY_PREFIX_LENGTH;
+    const size_t path_length = query_length - NEXTION_PROPERTY_QUERY_PREFIX_LENGTH;
+
+    if (ttl_ms == 0 || path_length > NEXTION_PROPERTY_PATH_MAX_LENGTH)
+    {
+        return nextion_instruction_send_get_text(handle, query, query_length, buffer, buffer_length);
+    }
+
+    shadow_cache_t *cache = nextion_protocol_get_shadow(handle);
+    const uint32_t hash = nextion_shadow_hash(path, path_length);
+
+    portENTER_CRITICAL(&cache->lock);
+
+    const shadow_entry_t *entry = nextion_shadow_find_fresh(cache, hash, path, path_length, true);
+    const uint32_t generation = cache->generation;
+
+    // Too small a buffer is left for the device to report.
+    const bool is_hit = entry != NULL && entry->text_length < buffer_length;
+
+    if (is_hit)
+    {
+        memcpy(buffer, entry->text, entry->text_length);
+        buffer[entry->text_length] = '\0';
+    }
+
+    portEXIT_CRITICAL(&cache->lock);
+
+    if (is_hit)
+    {
+        return NEX_OK;
+    }
+
+    nex_err_t code = nextion_instruction_send_get_text(handle, query, query_length, buffer, buffer_length);
+
+    if (code == NEX_OK)
+    {
+        const shadow_value_t value = {.text = buffer, .text_length = strlen(buffer), .number = 0};
+
+        nextion_shadow_remember(handle, generation, hash, path, path_length, ttl_ms, &value);
+    }
+
+    return code;
+}
+
+static nex_err_t nextion_shadow_send(nextion_t *handle, encoder_t *encoder, size_t path_length, const shadow_value_t *value)
+{
+    const bool is_cacheable = !encoder->is_overflowed
+                              && path_length <= NEXTION_PROPERTY_PATH_MAX_LENGTH
+                              && value->text_length <= CONFIG_NEX_SHADOW_CACHE_TEXT_LENGTH;
+
+    if (!is_cacheable)
+    {
+        return nextion_protocol_send_encoded_ack(handle, encoder);
+    }
+
+    shadow_cache_t *cache = nextion_protocol_get_shadow(handle);
+    const char *path = encoder->buffer;
+    const uint32_t hash = nextion_shadow_hash(path, path_length);
+
+    portENTER_CRITICAL(&cache->lock);
+
+    shadow_entry_t *entry = nextion_shadow_find(cache, hash, path, path_length);
+    const bool is_unchanged = entry != NULL && nextion_shadow_equals(entry, value);
+    const uint32_t generation = cache->generation;
+
+    if (entry != NULL)
+    {
+        entry->last_used = ++cache->clock;
+    }
+
+    if (is_unchanged)
+    {
+        cache->stats.writes_skipped++;
+    }
+
+    portEXIT_CRITICAL(&cache->lock);
+
+    if (is_unchanged)
+    {
+        return NEX_OK;
+    }
+
+    nex_err_t code = nextion_protocol_send_encoded_ack(handle, encoder);
+
+    portENTER_CRITICAL(&cache->lock);
+
+    entry = nextion_shadow_find(cache, hash, path, path_length);
+
+    // Something else was stored or cleared while sending; the
+    // order the device got the values in is unknown.
+    if (code == NEX_OK && generation == cache->generation)
+    {
+        nextion_shadow_store(cache,
+                             entry,
+                             hash,
+                             path,
+                             path_length,
+                             value,
+                             CONFIG_NEX_SHADOW_CACHE_READ_TTL_MS,
+                             SHADOW_COMPONENT_ID_UNKNOWN);
+    }
+    else if (entry != NULL)
+    {
+        nextion_shadow_remove(cache, entry);
+    }
+
+    portEXIT_CRITICAL(&cache->lock);
+
+    return code;
+}
+
+static const shadow_entry_t *nextion_shadow_find_fresh(shadow_cache_t *cache,
+                                                       uint32_t hash,
+                                                       const char *path,
+                                                       size_t path_length,
+                                                       bool is_text)
+{
+    shadow_entry_t *entry = nextion_shadow_find(cache, hash, path, path_length);
+    const bool is_fresh = entry != NULL
+                          && entry->is_text == is_text
+                          && (int32_t)(entry->expires_at - xTaskGetTickCount()) > 0;
+
+    if (!is_fresh)
+    {
+        cache->stats.read_misses++;
+
+        return NULL;
+    }
+
+    entry->last_used = ++cache->clock;
+    cache->stats.read_hits++;
+
+    return entry;
+}
+
+static void nextion_shadow_remember(nextion_t *handle,
+                                    uint32_t generation,
+                                    uint32_t hash,
+                                    const char *path,
+                                    size_t path_length,
+                                    uint32_t ttl_ms,
+                                    const shadow_value_t *value)
+{
+    if (value->text_length > CONFIG_NEX_SHADOW_CACHE_TEXT_LENGTH)
+    {
+        return;
+    }
+
+    shadow_cache_t *cache = nextion_protocol_get_shadow(handle);
+    const size_t component_length = nextion_shadow_component_length(path, path_length);
+
+    portENTER_CRITICAL(&cache->lock);
+
+    int16_t component_id = nextion_shadow_find_component_id(cache, path, component_length);
+
+    portEXIT_CRITICAL(&cache->lock);
+
+    // Touches are matched by component id; the device
+    // is asked for it once per component remembered.
+    if (component_id == SHADOW_COMPONENT_ID_UNKNOWN)
+    {
+        component_id = nextion_shadow_query_component_id(handle, path, component_length);
+    }
+
+    portENTER_CRITICAL(&cache->lock);
+
+    shadow_entry_t *entry = nextion_shadow_find(cache, hash, path, path_length);
+
+    // Something was stored, touched or cleared while reading.
+    if (generation == cache->generation)
+    {
+        nextion_shadow_store(cache, entry, hash, path, path_length, value, ttl_ms, component_id);
+    }
+    else if (entry != NULL)
+    {
+        nextion_shadow_remove(cache, entry);
+    }
+
+    portEXIT_CRITICAL(&cache->lock);
+}
+
+static int16_t nextion_shadow_query_component_id(nextion_t *handle, const char *path, size_t component_length)
+{
+    char query[NEXTION_PROPERTY_QUERY_PREFIX_LENGTH + NEXTION_PROPERTY_PATH_MAX_LENGTH + sizeof(".id")];
+    encoder_t encoder;
+    int32_t component_id = 0;
+
+    encoder_begin(&encoder, query, sizeof(query));
+    ENCODER_APPEND_LITERAL(&encoder, "get ");
+    encoder_append(&encoder, path, component_length);
+    ENCODER_APPEND_LITERAL(&encoder, ".id");
+
+    // Entries without id are forgotten on every touch.
+    if (!encoder_end(&encoder)
+        || nextion_instruction_send_get_number(handle, query, encoder.length, &component_id) != NEX_OK
+        || component_id < 0
+        || component_id > UINT8_MAX)
+    {
+        return SHADOW_COMPONENT_ID_UNKNOWN;
+    }
+
+    return (int16_t)component_id;
+}
+
+static uint32_t nextion_shadow_hash(const char *path, size_t path_length)
+{
+    // FNV-1a: cheap, and good enough for short names.
+    uint32_t hash = 2166136261UL;
+
+    for (size_t i = 0; i < path_length; i++)
+    {
+        hash ^= (uint8_t)path[i];
+        hash *= 16777619UL;
+    }
+
+    return hash;
+}
+
+static size_t nextion_shadow_component_length(const char *path, size_t path_length)
+{
+    // Components may be qualified by their page: "page.component.property".
+    for (size_t i = path_length; i > 0; i--)
+    {
+        if (path[i - 1] == '.')
+        {
+            return i - 1;
+        }
+    }
+
+    return path_length;
+}
+
+static shadow_entry_t *nextion_shadow_find(shadow_cache_t *cache, uint32_t hash, const char *path, size_t path_length)
+{
+    for (size_t i = 0; i < cache->count; i++)
+    {
+        shadow_entry_t *entry = &cache->entries[i];
+
+        if (entry->hash == hash && entry->path_length == path_length && memcmp(entry->path, path, path_length) == 0)
+        {
+            return entry;
+        }
+    }
+
+    return NULL;
+}
+
+static int16_t nextion_shadow_find_component_id(const shadow_cache_t *cache, const char *path, size_t component_length)
+{
+    for (size_t i = 0; i < cache->count; i++)
+    {
+        const shadow_entry_t *entry = &cache->entries[i];
+
+        if (entry->component_id != SHADOW_COMPONENT_ID_UNKNOWN
+            && entry->component_length == component_length
+            && memcmp(entry->path, path, component_length) == 0)
+        {
+            return entry->component_id;
+        }
+    }
+
+    return SHADOW_COMPONENT_ID_UNKNOWN;
+}
+
+static bool nextion_shadow_equals(const shadow_entry_t *entry, const shadow_value_t *value)
+{
+    if (value->text == NULL)
+    {
+        return !entry->is_text && entry->number == value->number;
+    }
+
+    return entry->is_text && entry->text_length == value->text_length && memcmp(entry->text, value->text, value->text_length) == 0;
+}
+
+static void nextion_shadow_store(shadow_cache_t *cache,
+                                 shadow_entry_t *entry,
+                                 uint32_t hash,
+                                 const char *path,
+                                 size_t path_length,
+                                 const shadow_value_t *value,
+                                 uint32_t ttl_ms,
+                                 int16_t component_id)
+{
+    const size_t component_length = nextion_shadow_component_length(path, path_length);
+
+    // Values set carry no id; it is known if any sibling property was read.
+    if (component_id == SHADOW_COMPONENT_ID_UNKNOWN)
+    {
+        component_id = nextion_shadow_find_component_id(cache, path, component_length);
+    }
+
+    if (entry == NULL && cache->count < CONFIG_NEX_SHADOW_CACHE_SIZE)
+    {
+        entry = &cache->entries[cache->count++];
+    }
+    else if (entry == NULL)
+    {
+        // Full: reuse the least recently used.
+        entry = &cache->entries[0];
+        cache->stats.evictions++;
+
+        for (size_t i = 1; i < cache->count; i++)
+        {
+            if (cache->entries[i].last_used < entry->last_used)
+            {
+                entry = &cache->entries[i];
+            }
+        }
+    }
+
+    entry->hash = hash;
+    entry->last_used = ++cache->clock;
+    entry->expires_at = xTaskGetTickCount() + pdMS_TO_TICKS(ttl_ms);
+    entry->component_id = component_id;
+    entry->component_length = (uint8_t)component_length;
+    entry->path_length = (uint8_t)path_length;
+    entry->is_text = value->text != NULL;
+    entry->number = value->number;
+    entry->text_length = (uint8_t)value->text_length;
+
+    memcpy(entry->path, path, path_length);
+
+    if (value->text != NULL)
+    {
+        memcpy(entry->text, value->text, value->text_length);
+    }
+
+    cache->generation++;
+}
+
+static void nextion_shadow_remove(shadow_cache_t *cache, shadow_entry_t *entry)
+{
+    // Entries are not ordered; the last one fills the gap.
+    *entry = cache->entries[--cache->count];
+    cache->generation++;
+}
+
+static void nextion_shadow_forget_path(shadow_cache_t *cache, const char *path, size_t path_length)
+{
+    const uint32_t hash = nextion_shadow_hash(path, path_length);
+
+    portENTER_CRITICAL(&cache->lock);
+
+    shadow_entry_t *entry = nextion_shadow_find(cache, hash, path, path_length);
+
+    if (entry != NULL)
+    {
+        nextion_shadow_remove(cache, entry);
+    }
+
+    // Reads in flight may get the value before it is changed.
+    cache->generation++;
+
+    portEXIT_CRITICAL(&cache->lock);
+}
+#endif
\ No newline at end of file
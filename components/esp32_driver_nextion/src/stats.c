@@ -0,0 +1,215 @@
+#include <string.h>
+#include "esp32_driver_nextion/stats.h"
+#include "protocol/protocol.h"
+#include "instrumentation.h"
+#include "assertion.h"
+#include "config.h"
+
+#ifdef CONFIG_NEX_STATS
+#ifdef CONFIG_IDF_TARGET_LINUX
+#include <time.h>
+#else
+#include "esp_timer.h"
+#endif
+#include "protocol/parsers/responses/number.h"
+#include "protocol/parsers/responses/rept.h"
+#include "protocol/parsers/responses/sendme.h"
+#include "protocol/parsers/responses/tdm_start.h"
+#include "protocol/parsers/responses/text.h"
+
+static int64_t nextion_stats_now_us(void);
+static void nextion_stats_add(nextion_stats_histogram_t *histogram, uint32_t duration_us);
+#endif
+
+nex_err_t nextion_stats_get(nextion_t *handle, nextion_stats_t *stats)
+{
+    CMP_CHECK_HANDLE(handle, NEX_FAIL)
+    CMP_CHECK((stats != NULL), "stats error(NULL)", NEX_FAIL)
+
+#ifdef CONFIG_NEX_STATS
+    stats_collector_t *collector = nextion_protocol_get_stats(handle);
+
+    portENTER_CRITICAL(&collector->lock);
+
+    memcpy(stats, &collector->stats, sizeof(nextion_stats_t));
+
+    portEXIT_CRITICAL(&collector->lock);
+
+    return NEX_OK;
+#else
+    CMP_LOGW("statistics disabled: enable CONFIG_NEX_STATS");
+
+    return NEX_FAIL;
+#endif
+}
+
+nex_err_t nextion_stats_reset(nextion_t *handle)
+{
+    CMP_CHECK_HANDLE(handle, NEX_FAIL)
+
+#ifdef CONFIG_NEX_STATS
+    stats_collector_t *collector = nextion_protocol_get_stats(handle);
+
+    portENTER_CRITICAL(&collector->lock);
+
+    memset(&collector->stats, 0, sizeof(nextion_stats_t));
+
+    portEXIT_CRITICAL(&collector->lock);
+
+    return NEX_OK;
+#else
+    CMP_LOGW("statistics disabled: enable CONFIG_NEX_STATS");
+
+    return NEX_FAIL;
+#endif
+}
+
+uint32_t nextion_stats_percentile(const nextion_stats_histogram_t *histogram, uint8_t percentile)
+{
+    CMP_CHECK((histogram != NULL), "histogram error(NULL)", 0)
+    CMP_CHECK((percentile <= 100), "percentile error(>100)", 0)
+
+    if (histogram->count == 0)
+    {
+        return 0;
+    }
+
+    // Rank of the duration wanted, starting at 1.
+    const uint64_t rank = (((uint64_t)histogram->count * percentile) + 99) / 100;
+    uint64_t seen = 0;
+
+    for (size_t i = 0; i < NEXTION_STATS_BUCKET_COUNT - 1; i++)
+    {
+        seen += histogram->buckets[i];
+
+        if (seen >= rank && seen > 0)
+        {
+            const uint32_t upper_bound = 1UL << i;
+
+            return upper_bound < histogram->max_us ? upper_bound : histogram->max_us;
+        }
+    }
+
+    // The last bucket has no upper bound.
+    return histogram->max_us;
+}
+
+#ifdef CONFIG_NEX_STATS
+void nextion_stats_collector_init(stats_collector_t *collector)
+{
+    portMUX_INITIALIZE(&collector->lock);
+
+    memset(&collector->stats, 0, sizeof(nextion_stats_t));
+}
+
+void nextion_stats_timer_start(stats_timer_t *timer)
+{
+    memset(timer, 0, sizeof(stats_timer_t));
+
+    timer->start = nextion_stats_now_us();
+    timer->last = timer->start;
+}
+
+void nextion_stats_timer_lap(stats_timer_t *timer, nextion_stats_phase_t phase)
+{
+    const int64_t now = nextion_stats_now_us();
+
+    timer->phases[phase] += (uint32_t)(now - timer->last);
+    timer->measured |= 1U << phase;
+    timer->last = now;
+}
+
+nextion_stats_class_t nextion_stats_classify(const parser_t *parser)
+{
+    if (parser == NULL)
+    {
+        return NEXTION_STATS_CLASS_ACK;
+    }
+
+    if (parser->can_parse == parser_rsp_text_can_parse)
+    {
+        return NEXTION_STATS_CLASS_GET_TEXT;
+    }
+
+    if (parser->can_parse == parser_rsp_number_can_parse || parser->can_parse == parser_rsp_sendme_can_parse)
+    {
+        return NEXTION_STATS_CLASS_GET_NUMBER;
+    }
+
+    if (parser->can_parse == parser_rsp_tdm_start_can_parse)
+    {
+        return NEXTION_STATS_CLASS_TDM_START;
+    }
+
+    if (parser->can_parse == parser_rsp_rept_can_parse)
+    {
+        return NEXTION_STATS_CLASS_RAW;
+    }
+
+    return NEXTION_STATS_CLASS_ACK;
+}
+
+void nextion_stats_record(stats_collector_t *collector,
+                          nextion_stats_class_t instruction_class,
+                          const stats_timer_t *timer,
+                          nex_err_t code)
+{
+    // Responses with data mean success; a timeout only
+    // gets here when a response was required.
+    const bool failed = code == NEX_FAIL || code == NEX_TIMEOUT || (code != NEX_DVC_INS_OK && NEX_DVC_CODE_IS_ACK_RESPONSE(code));
+    const uint32_t total_us = (uint32_t)(nextion_stats_now_us() - timer->start);
+
+    portENTER_CRITICAL(&collector->lock);
+
+    nextion_stats_instruction_t *stats = &collector->stats.classes[instruction_class];
+
+    stats->count++;
+    stats->failures += failed ? 1 : 0;
+    stats->contentions += timer->contended ? 1 : 0;
+
+    for (size_t i = 0; i < NEXTION_STATS_PHASE_TOTAL; i++)
+    {
+        if (timer->measured & (1U << i))
+        {
+            nextion_stats_add(&stats->phases[i], timer->phases[i]);
+        }
+    }
+
+    nextion_stats_add(&stats->phases[NEXTION_STATS_PHASE_TOTAL], total_us);
+
+    portEXIT_CRITICAL(&collector->lock);
+}
+
+static int64_t nextion_stats_now_us(void)
+{
+#ifdef CONFIG_IDF_TARGET_LINUX
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((int64_t)now.tv_sec * 1000000) + (now.tv_nsec / 1000);
+#else
+    return esp_timer_get_time();
+#endif
+}
+
+static void nextion_stats_add(nextion_stats_histogram_t *histogram, uint32_t duration_us)
+{
+    // Bucket "n" holds [2^(n-1), 2^n): the position of the highest bit set.
+    size_t bucket = duration_us == 0 ? 0 : (size_t)(32 - __builtin_clz(duration_us));
+
+    if (bucket >= NEXTION_STATS_BUCKET_COUNT)
+    {
+        bucket = NEXTION_STATS_BUCKET_COUNT - 1;
+    }
+
+    histogram->count++;
+    histogram->total_us += duration_us;
+    histogram->buckets[bucket]++;
+
+    if (duration_us > histogram->max_us)
+    {
+        histogram->max_us = duration_us;
+    }
+}
+#endif
@@ -1,4 +1,5 @@
 #include "esp32_driver_nextion/system.h"
+#include "esp32_driver_nextion/base/constants.h"
 #include "protocol/protocol.h"
 #include "assertion.h"
 
@@ -6,6 +7,8 @@ nex_err_t nextion_system_reset(nextion_t *handle)
 {
     CMP_CHECK_HANDLE(handle, NEX_FAIL)
 
+    SHADOW_CLEAR(nextion_protocol_get_shadow(handle));
+
     return nextion_protocol_send_instruction(handle, "rest", 4, NULL);
 }
 
@@ -23,6 +26,43 @@ nex_err_t nextion_system_wakeup(nextion_t *handle)
     return nextion_protocol_send_instruction_ack(handle, "sleep=0");
 }
 
+nex_err_t nextion_system_get_baud_rate(nextion_t *handle, uint32_t *baud_rate)
+{
+    CMP_CHECK_HANDLE(handle, NEX_FAIL)
+    CMP_CHECK((baud_rate != NULL), "baud_rate error(NULL)", NEX_FAIL)
+
+    int32_t value = 0;
+    nex_err_t code = nextion_system_get_variable_number(handle, "baud", &value);
+
+    *baud_rate = (uint32_t)value;
+
+    return code;
+}
+
+nex_err_t nextion_system_set_baud_rate(nextion_t *handle, nextion_baud_rate_t baud_rate, bool persist)
+{
+    CMP_CHECK_HANDLE(handle, NEX_FAIL)
+    CMP_CHECK((baud_rate >= NEX_SERIAL_BAUD_RATE_MIN && baud_rate <= NEX_SERIAL_BAUD_RATE_MAX), "baud_rate error", NEX_FAIL)
+
+    if (nextion_protocol_set_baud_rate(handle, baud_rate, persist) != NEX_OK)
+    {
+        return NEX_FAIL;
+    }
+
+    // Whatever the device replied was sent while switching;
+    // only reading the rate back proves the link works.
+    uint32_t device_baud_rate = 0;
+
+    if (nextion_system_get_baud_rate(handle, &device_baud_rate) != NEX_OK || device_baud_rate != baud_rate)
+    {
+        CMP_LOGE("baud rate not confirmed: %lu", (unsigned long)baud_rate);
+
+        return NEX_FAIL;
+    }
+
+    return NEX_OK;
+}
+
 nex_err_t nextion_system_get_brightness(nextion_t *handle, bool persisted, uint8_t *percentage)
 {
     CMP_CHECK_HANDLE(handle, NEX_FAIL)
@@ -125,6 +165,17 @@ nex_err_t nextion_system_set_send_xy(nextion_t *handle, bool send_xy)
     return nextion_system_set_variable_number(handle, "sendxy", send_xy);
 }
 
+nex_err_t nextion_system_set_response_mode(nextion_t *handle,
+                                           nextion_response_mode_t mode,
+                                           nextion_failure_callback_t on_failure,
+                                           void *context)
+{
+    CMP_CHECK_HANDLE(handle, NEX_FAIL)
+    CMP_CHECK((mode <= NEXTION_RESPONSE_ALL), "mode error(invalid)", NEX_FAIL)
+
+    return nextion_protocol_set_response_mode(handle, mode, on_failure, context);
+}
+
 nex_err_t nextion_system_get_variable_text(nextion_t *handle,
                                            const char *variable_name,
                                            char *buffer,
@@ -149,7 +200,14 @@ nex_err_t nextion_system_get_variable_number(nextion_t *handle,
     CMP_CHECK((variable_name != NULL), "variable_name error(NULL)", NEX_FAIL)
     CMP_CHECK((number != NULL), "number error(NULL)", NEX_FAIL)
 
-    return nextion_protocol_send_instruction_get_number(handle, number, "get %s", variable_name);
+    formated_instruction_t instruction;
+    encoder_t encoder;
+
+    nextion_protocol_encoder_begin(&instruction, &encoder);
+    ENCODER_APPEND_LITERAL(&encoder, "get ");
+    encoder_append_text(&encoder, variable_name);
+
+    return nextion_protocol_send_encoded_get_number(handle, number, &encoder);
 }
 
 nex_err_t nextion_system_set_variable_text(nextion_t *handle, const char *variable_name, const char *text)
@@ -158,7 +216,20 @@ nex_err_t nextion_system_set_variable_text(nextion_t *handle, const char *variab
     CMP_CHECK((variable_name != NULL), "variable_name error(NULL)", NEX_FAIL)
     CMP_CHECK((text != NULL), "text error(NULL)", NEX_FAIL)
 
-    return nextion_protocol_send_instruction_ack(handle, "%s=\"%s\"", variable_name, text);
+    formated_instruction_t instruction;
+    encoder_t encoder;
+
+    nextion_protocol_encoder_begin(&instruction, &encoder);
+    encoder_append_text(&encoder, variable_name);
+    encoder_append_char(&encoder, '=');
+    encoder_append_quoted(&encoder, text);
+
+    nex_err_t code = nextion_protocol_send_encoded_ack(handle, &encoder);
+
+    // Variables can be component properties, as "t0.txt".
+    SHADOW_FORGET_ASSIGNMENT(handle, instruction.text, encoder.length);
+
+    return code;
 }
 
 nex_err_t nextion_system_set_variable_number(nextion_t *handle,
@@ -168,5 +239,18 @@ nex_err_t nextion_system_set_variable_number(nextion_t *handle,
     CMP_CHECK_HANDLE(handle, NEX_FAIL)
     CMP_CHECK((variable_name != NULL), "variable_name error(NULL)", NEX_FAIL)
 
-    return nextion_protocol_send_instruction_ack(handle, "%s=%ld", variable_name, number);
+    formated_instruction_t instruction;
+    encoder_t encoder;
+
+    nextion_protocol_encoder_begin(&instruction, &encoder);
+    encoder_append_text(&encoder, variable_name);
+    encoder_append_char(&encoder, '=');
+    encoder_append_number(&encoder, number);
+
+    nex_err_t code = nextion_protocol_send_encoded_ack(handle, &encoder);
+
+    // Variables can be component properties, as "n0.val".
+    SHADOW_FORGET_ASSIGNMENT(handle, instruction.text, encoder.length);
+
+    return code;
 }
\ No newline at end of file
@@ -0,0 +1,422 @@
+#include "sdkconfig.h"
+#ifdef CONFIG_IDF_TARGET_LINUX
+#include <errno.h>
+#include <fcntl.h>
+#include <malloc.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#ifdef __APPLE__
+#include <IOKit/serial/ioss.h>
+#endif
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp32_driver_nextion/transport.h"
+#include "assertion.h"
+#include "config.h"
+
+#define WAIT_FOREVER -1
+
+// "struct termios2" sets any baud rate on Linux, but <asm/termbits.h> clashes
+// with <termios.h>; it is declared here as on x86, ARM and RISC-V.
+#if defined(__linux__) && defined(TCSETSW2) && defined(CBAUD) && defined(CIBAUD) \
+    && (defined(__x86_64__) || defined(__i386__) || defined(__aarch64__) || defined(__arm__) || defined(__riscv))
+#define HAS_TERMIOS2 1
+#define TERMIOS2_BOTHER 0010000
+
+struct termios2
+{
+    tcflag_t c_iflag;
+    tcflag_t c_oflag;
+    tcflag_t c_cflag;
+    tcflag_t c_lflag;
+    cc_t c_line;
+    cc_t c_cc[19];
+    speed_t c_ispeed;
+    speed_t c_ospeed;
+};
+#endif
+
+/**
+ * @typedef posix_transport_t
+ * @brief Transport over a POSIX file descriptor.
+ */
+typedef struct
+{
+    nextion_transport_t base; /*!< Transport functions. Must be the first member. */
+    int fd;                   /*!< File descriptor connected to the display. */
+    int wake_pipe[2];         /*!< Pipe used to interrupt "wait_event"; read end first. */
+    bool is_tty;              /*!< If the file descriptor is a terminal (tty or pty). */
+} posix_transport_t;
+
+static int posix_transport_write(nextion_transport_t *transport, const uint8_t *data, size_t length);
+static int posix_transport_read(nextion_transport_t *transport, uint8_t *buffer, size_t length, TickType_t timeout);
+static size_t posix_transport_buffered_length(nextion_transport_t *transport, bool complete_frames_only);
+static void posix_transport_flush_input(nextion_transport_t *transport);
+static bool posix_transport_wait_tx_done(nextion_transport_t *transport, TickType_t timeout);
+static bool posix_transport_set_baud_rate(nextion_transport_t *transport, uint32_t baud_rate);
+static nextion_transport_event_t posix_transport_wait_event(nextion_transport_t *transport, TickType_t timeout);
+static void posix_transport_wake(nextion_transport_t *transport);
+static void posix_transport_destroy(nextion_transport_t *transport);
+static int posix_transport_poll(struct pollfd *fds, nfds_t fds_length, TickType_t timeout);
+static void posix_transport_drain(int fd);
+static bool posix_transport_set_custom_baud_rate(int fd, uint32_t baud_rate);
+
+nextion_transport_t *nextion_transport_posix_create(int fd)
+{
+    CMP_CHECK((fd >= 0), "fd error(invalid)", NULL)
+
+    posix_transport_t *transport = (posix_transport_t *)calloc(1, sizeof(posix_transport_t));
+
+    CMP_CHECK((transport != NULL), "calloc error(transport)", NULL)
+
+    if (pipe(transport->wake_pipe) != 0)
+    {
+        free(transport);
+
+        CMP_LOGE("failed creating wake pipe");
+
+        return NULL;
+    }
+
+    // Reads wait using "poll", never on the descriptor itself.
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    fcntl(transport->wake_pipe[0], F_SETFL, fcntl(transport->wake_pipe[0], F_GETFL) | O_NONBLOCK);
+    fcntl(transport->wake_pipe[1], F_SETFL, fcntl(transport->wake_pipe[1], F_GETFL) | O_NONBLOCK);
+
+    transport->base.write = posix_transport_write;
+    transport->base.read = posix_transport_read;
+    transport->base.buffered_length = posix_transport_buffered_length;
+    transport->base.flush_input = posix_transport_flush_input;
+    transport->base.wait_tx_done = posix_transport_wait_tx_done;
+    transport->base.set_baud_rate = posix_transport_set_baud_rate;
+    transport->base.wait_event = posix_transport_wait_event;
+    transport->base.wake = posix_transport_wake;
+    transport->base.destroy = posix_transport_destroy;
+    transport->fd = fd;
+    transport->is_tty = isatty(fd) == 1;
+
+    if (transport->is_tty)
+    {
+        struct termios options;
+
+        // Bytes must pass untouched: no echo, no line
+        // buffering and no translation of 0xFF or newlines.
+        if (tcgetattr(fd, &options) == 0)
+        {
+            cfmakeraw(&options);
+            tcsetattr(fd, TCSANOW, &options);
+        }
+    }
+
+    return &transport->base;
+}
+
+static int posix_transport_write(nextion_transport_t *transport, const uint8_t *data, size_t length)
+{
+    const int fd = ((posix_transport_t *)transport)->fd;
+    size_t written = 0;
+
+    while (written < length)
+    {
+        ssize_t result = write(fd, data + written, length - written);
+
+        if (result >= 0)
+        {
+            written += (size_t)result;
+
+            continue;
+        }
+
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
+        {
+            struct pollfd pfd = {.fd = fd, .events = POLLOUT};
+
+            if (posix_transport_poll(&pfd, 1, pdMS_TO_TICKS(CONFIG_NEX_UART_TRANS_WAIT_TIME_MS)) > 0)
+            {
+                continue;
+            }
+        }
+        else if (errno == EINTR)
+        {
+            continue;
+        }
+
+        return -1;
+    }
+
+    return (int)written;
+}
+
+static int posix_transport_read(nextion_transport_t *transport, uint8_t *buffer, size_t length, TickType_t timeout)
+{
+    const int fd = ((posix_transport_t *)transport)->fd;
+    const TickType_t start = xTaskGetTickCount();
+    size_t total_read = 0;
+
+    // Like "uart_read_bytes": wait up to the timeout for all bytes.
+    while (total_read < length)
+    {
+        ssize_t result = read(fd, buffer + total_read, length - total_read);
+
+        if (result > 0)
+        {
+            total_read += (size_t)result;
+
+            continue;
+        }
+
+        if (result == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR))
+        {
+            return total_read > 0 ? (int)total_read : -1;
+        }
+
+        const TickType_t elapsed = xTaskGetTickCount() - start;
+
+        if (elapsed >= timeout)
+        {
+            break;
+        }
+
+        struct pollfd pfd = {.fd = fd, .events = POLLIN};
+
+        if (posix_transport_poll(&pfd, 1, timeout == portMAX_DELAY ? portMAX_DELAY : timeout - elapsed) == 0)
+        {
+            break;
+        }
+    }
+
+    return (int)total_read;
+}
+
+static size_t posix_transport_buffered_length(nextion_transport_t *transport, bool complete_frames_only)
+{
+    (void)complete_frames_only;
+
+    int buffered_length = 0;
+
+    if (ioctl(((posix_transport_t *)transport)->fd, FIONREAD, &buffered_length) != 0 || buffered_length < 0)
+    {
+        return 0;
+    }
+
+    return (size_t)buffered_length;
+}
+
+static void posix_transport_flush_input(nextion_transport_t *transport)
+{
+    posix_transport_t *posix = (posix_transport_t *)transport;
+
+    if (posix->is_tty)
+    {
+        tcflush(posix->fd, TCIFLUSH);
+    }
+
+    // Sockets have no flush; read everything instead.
+    posix_transport_drain(posix->fd);
+}
+
+static bool posix_transport_wait_tx_done(nextion_transport_t *transport, TickType_t timeout)
+{
+    posix_transport_t *posix = (posix_transport_t *)transport;
+
+    // Socket and pipe writes are complete once "write" returns.
+    if (!posix->is_tty)
+    {
+        return true;
+    }
+
+    const TickType_t start = xTaskGetTickCount();
+    int pending_length = 0;
+
+    // "tcdrain" has no timeout; the output queue is polled instead.
+    while (ioctl(posix->fd, TIOCOUTQ, &pending_length) == 0)
+    {
+        if (pending_length <= 0)
+        {
+            return true;
+        }
+
+        if (xTaskGetTickCount() - start >= timeout)
+        {
+            return false;
+        }
+
+        vTaskDelay(1);
+    }
+
+    // Drivers without an output queue count.
+    return tcdrain(posix->fd) == 0;
+}
+
+static bool posix_transport_set_baud_rate(nextion_transport_t *transport, uint32_t baud_rate)
+{
+    posix_transport_t *posix = (posix_transport_t *)transport;
+
+    if (!posix->is_tty)
+    {
+        return true;
+    }
+
+    speed_t speed;
+
+    switch (baud_rate)
+    {
+    case 2400:
+        speed = B2400;
+        break;
+    case 4800:
+        speed = B4800;
+        break;
+    case 9600:
+        speed = B9600;
+        break;
+    case 19200:
+        speed = B19200;
+        break;
+    case 38400:
+        speed = B38400;
+        break;
+    case 57600:
+        speed = B57600;
+        break;
+    case 115200:
+        speed = B115200;
+        break;
+    case 230400:
+        speed = B230400;
+        break;
+#ifdef B921600
+    case 921600:
+        speed = B921600;
+        break;
+#endif
+    default:
+        // Nextion also runs at rates termios has no constant for.
+        return posix_transport_set_custom_baud_rate(posix->fd, baud_rate);
+    }
+
+    struct termios options;
+
+    if (tcgetattr(posix->fd, &options) != 0)
+    {
+        return false;
+    }
+
+    cfsetispeed(&options, speed);
+    cfsetospeed(&options, speed);
+
+    return tcsetattr(posix->fd, TCSADRAIN, &options) == 0;
+}
+
+static nextion_transport_event_t posix_transport_wait_event(nextion_transport_t *transport, TickType_t timeout)
+{
+    posix_transport_t *posix = (posix_transport_t *)transport;
+    struct pollfd fds[2] = {{.fd = posix->wake_pipe[0], .events = POLLIN},
+                            {.fd = posix->fd, .events = POLLIN}};
+
+    int result = posix_transport_poll(fds, 2, timeout);
+
+    if (result > 0 && (fds[1].revents & (POLLHUP | POLLERR)) && !(fds[1].revents & POLLIN))
+    {
+        // The other side is gone (e.g. the pty was closed) and the
+        // descriptor would wake us forever; wait only for "wake".
+        result = posix_transport_poll(fds, 1, timeout);
+        fds[1].revents = 0;
+    }
+
+    if (result <= 0)
+    {
+        return NEXTION_TRANSPORT_EVENT_TIMEOUT;
+    }
+
+    if (fds[0].revents & POLLIN)
+    {
+        posix_transport_drain(posix->wake_pipe[0]);
+
+        return NEXTION_TRANSPORT_EVENT_WAKE;
+    }
+
+    return NEXTION_TRANSPORT_EVENT_DATA;
+}
+
+static void posix_transport_wake(nextion_transport_t *transport)
+{
+    const uint8_t wake_up = 0;
+
+    // A full pipe already wakes the receiver.
+    (void)write(((posix_transport_t *)transport)->wake_pipe[1], &wake_up, 1);
+}
+
+static void posix_transport_destroy(nextion_transport_t *transport)
+{
+    posix_transport_t *posix = (posix_transport_t *)transport;
+
+    close(posix->wake_pipe[0]);
+    close(posix->wake_pipe[1]);
+    close(posix->fd);
+
+    free(transport);
+}
+
+static int posix_transport_poll(struct pollfd *fds, nfds_t fds_length, TickType_t timeout)
+{
+    const TickType_t start = xTaskGetTickCount();
+    int result;
+
+    // The FreeRTOS POSIX port interrupts system calls with its tick
+    // signal; every retry waits only for what is left of the timeout.
+    do
+    {
+        const TickType_t elapsed = xTaskGetTickCount() - start;
+        int timeout_ms = WAIT_FOREVER;
+
+        if (timeout != portMAX_DELAY)
+        {
+            timeout_ms = elapsed < timeout ? (int)((timeout - elapsed) * portTICK_PERIOD_MS) : 0;
+        }
+
+        result = poll(fds, fds_length, timeout_ms);
+    } while (result == -1 && errno == EINTR);
+
+    return result;
+}
+
+static void posix_transport_drain(int fd)
+{
+    uint8_t buffer[64];
+
+    while (read(fd, buffer, sizeof(buffer)) > 0)
+    {
+    }
+}
+
+static bool posix_transport_set_custom_baud_rate(int fd, uint32_t baud_rate)
+{
+#if defined(HAS_TERMIOS2)
+    struct termios2 options;
+
+    if (ioctl(fd, TCGETS2, &options) != 0)
+    {
+        return false;
+    }
+
+    // No input rate bits: it follows the output rate.
+    options.c_cflag = (options.c_cflag & ~(tcflag_t)(CBAUD | CIBAUD)) | TERMIOS2_BOTHER;
+    options.c_ispeed = baud_rate;
+    options.c_ospeed = baud_rate;
+
+    return ioctl(fd, TCSETSW2, &options) == 0;
+#elif defined(__APPLE__)
+    speed_t speed = baud_rate;
+
+    // Must follow "tcsetattr", which would reset it.
+    return tcdrain(fd) == 0 && ioctl(fd, IOSSIOSPEED, &speed) == 0;
+#else
+    CMP_LOGW("baud rate not supported by termios: %lu", (unsigned long)baud_rate);
+
+    return false;
+#endif
+}
+#endif
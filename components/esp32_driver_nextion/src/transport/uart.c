@@ -0,0 +1,203 @@
+#include "sdkconfig.h"
+#ifndef CONFIG_IDF_TARGET_LINUX
+#include <malloc.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "soc/soc_caps.h"
+#include "esp32_driver_nextion/base/constants.h"
+#include "esp32_driver_nextion/transport.h"
+#include "assertion.h"
+#include "config.h"
+
+// Kconfig ranges cannot exclude values; "uart_driver_install" would abort on them.
+#if CONFIG_NEX_UART_TRANS_BUFFER_SIZE != 0 && CONFIG_NEX_UART_TRANS_BUFFER_SIZE <= SOC_UART_FIFO_LEN
+#error "CONFIG_NEX_UART_TRANS_BUFFER_SIZE must be zero or bigger than the UART hardware FIFO"
+#endif
+
+#define UART_QUEUE_SIZE 10
+#define UART_PATTERN_QUEUE_SIZE (UART_QUEUE_SIZE * 2)
+
+/**
+ * @typedef uart_transport_t
+ * @brief Transport over an ESP32 UART.
+ */
+typedef struct
+{
+    nextion_transport_t base; /*!< Transport functions. Must be the first member. */
+    uart_port_t uart_num;     /*!< UART port number. */
+    QueueHandle_t queue;      /*!< Queue used for UART events. */
+} uart_transport_t;
+
+static int uart_transport_write(nextion_transport_t *transport, const uint8_t *data, size_t length);
+static int uart_transport_read(nextion_transport_t *transport, uint8_t *buffer, size_t length, TickType_t timeout);
+static size_t uart_transport_buffered_length(nextion_transport_t *transport, bool complete_frames_only);
+static void uart_transport_flush_input(nextion_transport_t *transport);
+static bool uart_transport_wait_tx_done(nextion_transport_t *transport, TickType_t timeout);
+static bool uart_transport_set_baud_rate(nextion_transport_t *transport, uint32_t baud_rate);
+static nextion_transport_event_t uart_transport_wait_event(nextion_transport_t *transport, TickType_t timeout);
+static void uart_transport_wake(nextion_transport_t *transport);
+static void uart_transport_destroy(nextion_transport_t *transport);
+
+nextion_transport_t *nextion_transport_uart_create(uart_port_t uart_num,
+                                                   uint32_t baud_rate,
+                                                   gpio_num_t tx_io_num,
+                                                   gpio_num_t rx_io_num)
+{
+    const uart_config_t uart_config = {
+        .baud_rate = (int)baud_rate,
+        .data_bits = UART_DATA_8_BITS,
+        .parity = UART_PARITY_DISABLE,
+        .stop_bits = UART_STOP_BITS_1,
+        .flow_ctrl = UART_HW_FLOWCTRL_DISABLE};
+
+    // Do not change the UART initialization order.
+    // This order was gotten from: https://docs.espressif.com/projects/esp-idf/en/latest/esp32/api-reference/peripherals/uart.html
+    // Trying to follow the examples on the github site (https://github.com/espressif/esp-idf/tree/master/examples/peripherals/uart)
+    // will lead to error.
+
+    ESP_ERROR_CHECK(uart_param_config(uart_num, &uart_config));
+    ESP_ERROR_CHECK(uart_set_pin(uart_num, tx_io_num, rx_io_num, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE));
+
+    uart_transport_t *transport = (uart_transport_t *)calloc(1, sizeof(uart_transport_t));
+
+    CMP_CHECK((transport != NULL), "calloc error(transport)", NULL)
+
+    transport->base.write = uart_transport_write;
+    transport->base.read = uart_transport_read;
+    transport->base.buffered_length = uart_transport_buffered_length;
+    transport->base.flush_input = uart_transport_flush_input;
+    transport->base.wait_tx_done = uart_transport_wait_tx_done;
+    transport->base.set_baud_rate = uart_transport_set_baud_rate;
+    transport->base.wait_event = uart_transport_wait_event;
+    transport->base.wake = uart_transport_wake;
+    transport->base.destroy = uart_transport_destroy;
+    transport->uart_num = uart_num;
+
+    ESP_ERROR_CHECK(uart_driver_install(uart_num,
+                                        CONFIG_NEX_UART_RECV_BUFFER_SIZE,  // Receive buffer size.
+                                        CONFIG_NEX_UART_TRANS_BUFFER_SIZE, // Transmit buffer size.
+                                        UART_QUEUE_SIZE,                   // Queue size.
+                                        &transport->queue,                 // Queue pointer.
+                                        0));                               // Allocation flags.
+
+#ifdef CONFIG_NEX_UART_PATTERN_DETECTION
+    // Every event ends with the end sequence, so the task
+    // can be woken once per frame instead of on every chunk.
+    ESP_ERROR_CHECK(uart_enable_pattern_det_baud_intr(uart_num, NEX_DVC_CMD_END_VALUE, NEX_DVC_CMD_END_LENGTH, 9, 0, 0));
+    ESP_ERROR_CHECK(uart_pattern_queue_reset(uart_num, UART_PATTERN_QUEUE_SIZE));
+#endif
+
+    return &transport->base;
+}
+
+static int uart_transport_write(nextion_transport_t *transport, const uint8_t *data, size_t length)
+{
+    return uart_write_bytes(((uart_transport_t *)transport)->uart_num, data, length);
+}
+
+static int uart_transport_read(nextion_transport_t *transport, uint8_t *buffer, size_t length, TickType_t timeout)
+{
+    return uart_read_bytes(((uart_transport_t *)transport)->uart_num, buffer, length, timeout);
+}
+
+static size_t uart_transport_buffered_length(nextion_transport_t *transport, bool complete_frames_only)
+{
+    const uart_port_t uart_num = ((uart_transport_t *)transport)->uart_num;
+    size_t buffered_length = 0;
+
+    uart_get_buffered_data_len(uart_num, &buffered_length);
+
+#ifdef CONFIG_NEX_UART_PATTERN_DETECTION
+    // Positions are only a hint that a frame ended: 0xFF is valid inside
+    // numbers, so one may be matched early, and the rest of its frame is
+    // then read by waiting. They are not popped, as the UART driver drops
+    // them when their bytes are read; the ones not read yet stay queued.
+    if (complete_frames_only && uart_pattern_get_pos(uart_num) == -1)
+    {
+        return 0;
+    }
+#endif
+
+    return buffered_length;
+}
+
+static void uart_transport_flush_input(nextion_transport_t *transport)
+{
+    const uart_port_t uart_num = ((uart_transport_t *)transport)->uart_num;
+
+    uart_flush_input(uart_num);
+
+#ifdef CONFIG_NEX_UART_PATTERN_DETECTION
+    uart_pattern_queue_reset(uart_num, UART_PATTERN_QUEUE_SIZE);
+#endif
+}
+
+static bool uart_transport_wait_tx_done(nextion_transport_t *transport, TickType_t timeout)
+{
+    return uart_wait_tx_done(((uart_transport_t *)transport)->uart_num, timeout) == ESP_OK;
+}
+
+static bool uart_transport_set_baud_rate(nextion_transport_t *transport, uint32_t baud_rate)
+{
+    return uart_set_baudrate(((uart_transport_t *)transport)->uart_num, baud_rate) == ESP_OK;
+}
+
+static nextion_transport_event_t uart_transport_wait_event(nextion_transport_t *transport, TickType_t timeout)
+{
+    QueueHandle_t queue = ((uart_transport_t *)transport)->queue;
+    uart_event_t event;
+
+    if (xQueueReceive(queue, (void *)&event, timeout) == pdFALSE)
+    {
+        return NEXTION_TRANSPORT_EVENT_TIMEOUT;
+    }
+
+    switch (event.type)
+    {
+#ifdef CONFIG_NEX_UART_PATTERN_DETECTION
+    case UART_PATTERN_DET:
+        CMP_LOGD("UART frame end detected");
+
+        return NEXTION_TRANSPORT_EVENT_DATA;
+#else
+    case UART_DATA:
+        CMP_LOGD("UART data size: %d", event.size);
+
+        return NEXTION_TRANSPORT_EVENT_DATA;
+#endif
+
+    case UART_FIFO_OVF:
+        CMP_LOGW("UART hw fifo overflow");
+
+        xQueueReset(queue);
+
+        return NEXTION_TRANSPORT_EVENT_OVERFLOW;
+
+    case UART_BUFFER_FULL:
+        CMP_LOGW("UART buffer full");
+
+        xQueueReset(queue);
+
+        return NEXTION_TRANSPORT_EVENT_OVERFLOW;
+
+    default:
+        return NEXTION_TRANSPORT_EVENT_WAKE;
+    }
+}
+
+static void uart_transport_wake(nextion_transport_t *transport)
+{
+    // Not a real UART event; only makes the receiver return.
+    const uart_event_t wake_up = {.type = UART_EVENT_MAX};
+
+    xQueueSend(((uart_transport_t *)transport)->queue, &wake_up, 0);
+}
+
+static void uart_transport_destroy(nextion_transport_t *transport)
+{
+    // Will also free the queue.
+    ESP_ERROR_CHECK(uart_driver_delete(((uart_transport_t *)transport)->uart_num));
+
+    free(transport);
+}
+#endif
@@ -1,8 +1,14 @@
+#include <malloc.h>
 #include "esp32_driver_nextion/base/constants.h"
 #include "esp32_driver_nextion/waveform.h"
 #include "protocol/protocol.h"
 #include "assertion.h"
 
+/**
+ * @brief Longest "addt" instruction: "addt 255,255,1002", plus the null terminator.
+ */
+#define WAVEFORM_STREAM_INSTRUCTION_MAX_LENGTH 18U
+
 nex_err_t nextion_waveform_start_refesh(nextion_t *handle)
 {
     CMP_CHECK_HANDLE(handle, NEX_FAIL)
@@ -24,7 +30,15 @@ nex_err_t nextion_waveform_add_value(nextion_t *handle,
 {
     CMP_CHECK_HANDLE(handle, NEX_FAIL)
 
-    nex_err_t code = nextion_protocol_send_instruction_ack(handle, "add %d,%d,%d", waveform_id, channel_id, value);
+    const int32_t parameters[] = {waveform_id, channel_id, value};
+    formated_instruction_t instruction;
+    encoder_t encoder;
+
+    nextion_protocol_encoder_begin(&instruction, &encoder);
+    ENCODER_APPEND_LITERAL(&encoder, "add ");
+    encoder_append_numbers(&encoder, parameters, 3);
+
+    nex_err_t code = nextion_protocol_send_encoded_ack(handle, &encoder);
 
     // This operation will only return data in case of failure.
 
@@ -42,7 +56,15 @@ nex_err_t nextion_waveform_clear_channel(nextion_t *handle,
 {
     CMP_CHECK_HANDLE(handle, NEX_FAIL)
 
-    return nextion_protocol_send_instruction_ack(handle, "cle %d,%d", waveform_id, channel_id);
+    const int32_t parameters[] = {waveform_id, channel_id};
+    formated_instruction_t instruction;
+    encoder_t encoder;
+
+    nextion_protocol_encoder_begin(&instruction, &encoder);
+    ENCODER_APPEND_LITERAL(&encoder, "cle ");
+    encoder_append_numbers(&encoder, parameters, 2);
+
+    return nextion_protocol_send_encoded_ack(handle, &encoder);
 }
 
 nex_err_t nextion_waveform_clear(nextion_t *handle, uint8_t waveform_id)
@@ -60,12 +82,76 @@ nex_err_t nextion_waveform_stream_begin(nextion_t *handle,
     CMP_CHECK_HANDLE(handle, NEX_FAIL)
     CMP_CHECK((value_count < (NEX_DVC_TRANSPARENT_DATA_MAX_DATA_SIZE - 20)), "value_count error(>=NEX_DVC_TRANSPARENT_DATA_MAX_DATA_SIZE-20)", NEX_FAIL)
 
-    return nextion_protocol_send_instruction_tdm_start(handle, "addt %d,%d,%d", waveform_id, channel_id, value_count);
+    const int32_t parameters[] = {waveform_id, channel_id, (int32_t)value_count};
+    formated_instruction_t instruction;
+    encoder_t encoder;
+
+    nextion_protocol_encoder_begin(&instruction, &encoder);
+    ENCODER_APPEND_LITERAL(&encoder, "addt ");
+    encoder_append_numbers(&encoder, parameters, 3);
+
+    return nextion_protocol_send_encoded_tdm_start(handle, &encoder, value_count);
+}
+
+nex_err_t nextion_waveform_stream_write(nextion_t *handle, uint8_t value)
+{
+    return nextion_waveform_stream_write_buffer(handle, &value, 1);
 }
 
-nex_err_t nextion_waveform_stream_write(const nextion_t *handle, uint8_t value)
+nex_err_t nextion_waveform_stream_write_buffer(nextion_t *handle, const uint8_t *values, size_t value_count)
 {
     CMP_CHECK_HANDLE(handle, NEX_FAIL)
+    CMP_CHECK((values != NULL), "values error(NULL)", NEX_FAIL)
+
+    return nextion_protocol_send_tdm_data(handle, values, value_count);
+}
 
-    return nextion_protocol_send_raw_byte(handle, value);
+nex_err_t nextion_waveform_stream_channels(nextion_t *handle,
+                                           uint8_t waveform_id,
+                                           uint8_t channel_count,
+                                           const uint8_t *frames,
+                                           size_t frame_count)
+{
+    CMP_CHECK_HANDLE(handle, NEX_FAIL)
+    CMP_CHECK((channel_count > 0 && channel_count <= NEX_DVC_WAVEFORM_MAX_CHANNELS), "channel_count error(0 or >NEX_DVC_WAVEFORM_MAX_CHANNELS)", NEX_FAIL)
+    CMP_CHECK((frames != NULL), "frames error(NULL)", NEX_FAIL)
+    CMP_CHECK((frame_count > 0), "frame_count error(0)", NEX_FAIL)
+    CMP_CHECK((frame_count < (NEX_DVC_TRANSPARENT_DATA_MAX_DATA_SIZE - 20)), "frame_count error(>=NEX_DVC_TRANSPARENT_DATA_MAX_DATA_SIZE-20)", NEX_FAIL)
+
+    uint8_t *samples = (uint8_t *)malloc(channel_count * frame_count);
+    char instructions[NEX_DVC_WAVEFORM_MAX_CHANNELS][WAVEFORM_STREAM_INSTRUCTION_MAX_LENGTH];
+    tdm_stream_t streams[NEX_DVC_WAVEFORM_MAX_CHANNELS];
+    encoder_t encoder;
+
+    CMP_CHECK((samples != NULL), "malloc error(samples)", NEX_FAIL)
+
+    for (uint8_t channel_id = 0; channel_id < channel_count; channel_id++)
+    {
+        const int32_t parameters[] = {waveform_id, channel_id, (int32_t)frame_count};
+        uint8_t *channel_samples = samples + channel_id * frame_count;
+
+        // Each "addt" takes the samples of a single channel.
+        for (size_t i = 0; i < frame_count; i++)
+        {
+            channel_samples[i] = frames[i * channel_count + channel_id];
+        }
+
+        encoder_begin(&encoder, instructions[channel_id], WAVEFORM_STREAM_INSTRUCTION_MAX_LENGTH);
+        ENCODER_APPEND_LITERAL(&encoder, "addt ");
+        encoder_append_numbers(&encoder, parameters, 3);
+        encoder_end(&encoder);
+
+        streams[channel_id].instruction = instructions[channel_id];
+        streams[channel_id].instruction_length = encoder.length;
+        streams[channel_id].data = channel_samples;
+        streams[channel_id].data_length = frame_count;
+        streams[channel_id].tail_data = NULL;
+        streams[channel_id].tail_length = 0;
+    }
+
+    nex_err_t code = nextion_protocol_send_tdm_streams(handle, streams, channel_count);
+
+    free(samples);
+
+    return code;
 }
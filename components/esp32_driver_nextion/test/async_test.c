@@ -0,0 +1,111 @@
+#include "esp32_driver_nextion/async.h"
+#include "esp32_driver_nextion/component.h"
+#include "common_infra_test.h"
+
+#define ASYNC_INSTRUCTION_COUNT 5U
+
+typedef struct
+{
+    nex_err_t codes[ASYNC_INSTRUCTION_COUNT];
+    size_t completed;
+} async_result_t;
+
+static void callback_completed(nextion_t *handle, nex_err_t code, void *context);
+
+TEST_CASE("Async set component value", "[async]")
+{
+    async_result_t result = {0};
+    int32_t number = 0;
+
+    nex_err_t code = nextion_async_set_property_number(handle, "x0", "val", 150, callback_completed, &result);
+
+    nextion_async_wait(handle);
+    nextion_component_get_value(handle, "x0", &number);
+
+    CHECK_NEX_OK(code);
+    SIZET_EQUAL(1, result.completed);
+    CHECK_NEX_OK(result.codes[0]);
+    LONGS_EQUAL(150, number);
+}
+
+TEST_CASE("Async get component value", "[async]")
+{
+    async_result_t result = {0};
+    int32_t number = 0;
+
+    nex_err_t code = nextion_async_get_property_number(handle, "n0", "val", &number, callback_completed, &result);
+
+    nextion_async_wait(handle);
+
+    CHECK_NEX_OK(code);
+    CHECK_NEX_OK(result.codes[0]);
+    LONGS_EQUAL(-5, number);
+}
+
+TEST_CASE("Async get component text", "[async]")
+{
+    async_result_t result = {0};
+    char text[10];
+
+    nex_err_t code = nextion_async_get_property_text(handle, "t0", "txt", text, sizeof(text), callback_completed, &result);
+
+    nextion_async_wait(handle);
+
+    CHECK_NEX_OK(code);
+    CHECK_NEX_OK(result.codes[0]);
+    STRCMP_EQUAL("test text", text);
+}
+
+TEST_CASE("Cannot async get component text into an empty buffer", "[async]")
+{
+    char text[1];
+
+    nex_err_t code = nextion_async_get_property_text(handle, "t0", "txt", text, 0, NULL, NULL);
+
+    CHECK_NEX_FAIL(code);
+}
+
+TEST_CASE("Async responses are matched in order", "[async]")
+{
+    async_result_t result = {0};
+
+    nextion_async_send(handle, "vis n0,1", callback_completed, &result);
+    nextion_async_send(handle, "vis n99,1", callback_completed, &result);
+    nextion_async_send(handle, "vis n0,1", callback_completed, &result);
+
+    nextion_async_wait(handle);
+
+    SIZET_EQUAL(3, result.completed);
+    CHECK_NEX_OK(result.codes[0]);
+    NEX_CODES_EQUAL(NEX_DVC_ERR_INVALID_COMPONENT, result.codes[1]);
+    CHECK_NEX_OK(result.codes[2]);
+}
+
+TEST_CASE("Sync instruction after async instructions", "[async]")
+{
+    async_result_t result = {0};
+    int32_t number = 0;
+
+    for (size_t i = 0; i < ASYNC_INSTRUCTION_COUNT; i++)
+    {
+        nextion_async_set_property_number(handle, "x0", "val", (int32_t)i, callback_completed, &result);
+    }
+
+    nex_err_t code = nextion_component_get_value(handle, "x0", &number);
+
+    CHECK_NEX_OK(code);
+    SIZET_EQUAL(ASYNC_INSTRUCTION_COUNT, result.completed);
+    LONGS_EQUAL(ASYNC_INSTRUCTION_COUNT - 1, number);
+}
+
+static void callback_completed(nextion_t *, nex_err_t code, void *context)
+{
+    async_result_t *result = (async_result_t *)context;
+
+    if (result->completed < ASYNC_INSTRUCTION_COUNT)
+    {
+        result->codes[result->completed] = code;
+    }
+
+    result->completed++;
+}
@@ -0,0 +1,140 @@
+#include <string.h>
+#include "esp32_driver_nextion/batch.h"
+#include "esp32_driver_nextion/component.h"
+#include "esp32_driver_nextion/system.h"
+#include "common_infra_test.h"
+
+static nex_err_t commit_failing_batch(nextion_response_mode_t mode, nextion_batch_failure_t *failure, size_t *failure_count, int32_t *number);
+
+TEST_CASE("Commit batch", "[batch]")
+{
+    int32_t number = 0;
+    size_t failure_count = 1;
+    nextion_batch_t *batch = nextion_batch_begin(handle);
+
+    CHECK_NOT_NULL(batch);
+
+    nextion_batch_add_value(batch, "x0", 10);
+    nextion_batch_add_value(batch, "x0", 20);
+
+    nex_err_t code = nextion_batch_commit(batch, NULL, 0, &failure_count);
+
+    nextion_component_get_value(handle, "x0", &number);
+
+    CHECK_NEX_OK(code);
+    SIZET_EQUAL(0, failure_count);
+    LONGS_EQUAL(20, number);
+}
+
+TEST_CASE("Commit batch returns failed instructions", "[batch]")
+{
+    nextion_batch_failure_t failures[2];
+    size_t failure_count = 0;
+    nextion_batch_t *batch = nextion_batch_begin(handle);
+
+    nextion_batch_add(batch, "vis n0,1");
+    nextion_batch_add(batch, "vis n99,1");
+    nextion_batch_add(batch, "vis n0,1");
+
+    nex_err_t code = nextion_batch_commit(batch, failures, 2, &failure_count);
+
+    CHECK_NEX_FAIL(code);
+    SIZET_EQUAL(1, failure_count);
+    SIZET_EQUAL(1, failures[0].index);
+    NEX_CODES_EQUAL(NEX_DVC_ERR_INVALID_COMPONENT, failures[0].code);
+}
+
+TEST_CASE("Commit batch returns failed instructions when only failures are returned", "[batch]")
+{
+    nextion_batch_failure_t failure;
+    size_t failure_count = 0;
+    int32_t number = 0;
+
+    nex_err_t code = commit_failing_batch(NEXTION_RESPONSE_FAILURE, &failure, &failure_count, &number);
+
+    CHECK_NEX_FAIL(code);
+    SIZET_EQUAL(1, failure_count);
+    SIZET_EQUAL(1, failure.index);
+    NEX_CODES_EQUAL(NEX_DVC_ERR_INVALID_COMPONENT, failure.code);
+    LONGS_EQUAL(30, number);
+}
+
+TEST_CASE("Commit batch returns failed instructions when no result is returned", "[batch]")
+{
+    nextion_batch_failure_t failure;
+    size_t failure_count = 0;
+    int32_t number = 0;
+
+    nex_err_t code = commit_failing_batch(NEXTION_RESPONSE_NONE, &failure, &failure_count, &number);
+
+    CHECK_NEX_FAIL(code);
+    SIZET_EQUAL(1, failure_count);
+    SIZET_EQUAL(1, failure.index);
+    NEX_CODES_EQUAL(NEX_DVC_ERR_INVALID_COMPONENT, failure.code);
+    LONGS_EQUAL(30, number);
+}
+
+TEST_CASE("Commit empty batch", "[batch]")
+{
+    nextion_batch_t *batch = nextion_batch_begin(handle);
+
+    nex_err_t code = nextion_batch_commit(batch, NULL, 0, NULL);
+
+    CHECK_NEX_OK(code);
+}
+
+TEST_CASE("Cannot commit batch bigger than its buffer", "[batch]")
+{
+    char text[CONFIG_NEX_BATCH_BUFFER_SIZE];
+    nextion_batch_t *batch = nextion_batch_begin(handle);
+
+    memset(text, 'a', sizeof(text) - 1);
+    text[sizeof(text) - 1] = '\0';
+
+    nex_err_t add_code = nextion_batch_add_text(batch, "t0", text);
+    nex_err_t code = nextion_batch_commit(batch, NULL, 0, NULL);
+
+    CHECK_NEX_FAIL(add_code);
+    CHECK_NEX_FAIL(code);
+}
+
+TEST_CASE("Set a value again after a batch sets it", "[batch]")
+{
+    int32_t number = 0;
+    nextion_batch_t *batch = nextion_batch_begin(handle);
+
+    CHECK_NOT_NULL(batch);
+
+    nextion_batch_add_value(batch, "x0", 20);
+
+    // Set between adding and committing; the batch overwrites it.
+    nextion_component_set_value(handle, "x0", 10);
+    nextion_batch_commit(batch, NULL, 0, NULL);
+
+    nex_err_t code = nextion_component_set_value(handle, "x0", 10);
+
+    nextion_component_get_value(handle, "x0", &number);
+
+    CHECK_NEX_OK(code);
+    LONGS_EQUAL(10, number);
+}
+
+static nex_err_t commit_failing_batch(nextion_response_mode_t mode, nextion_batch_failure_t *failure, size_t *failure_count, int32_t *number)
+{
+    nextion_system_set_response_mode(handle, mode, NULL, NULL);
+
+    nextion_batch_t *batch = nextion_batch_begin(handle);
+
+    nextion_batch_add_value(batch, "x0", 10);
+    nextion_batch_add(batch, "vis n99,1");
+    nextion_batch_add_value(batch, "x0", 20);
+
+    nex_err_t code = nextion_batch_commit(batch, failure, 1, failure_count);
+
+    // Results of the batch, if read wrong, would be taken as these.
+    nextion_component_set_value(handle, "x0", 30);
+    nextion_system_set_response_mode(handle, NEXTION_RESPONSE_ALL, NULL, NULL);
+    nextion_component_get_value(handle, "x0", number);
+
+    return code;
+}
@@ -0,0 +1,83 @@
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp32_driver_nextion/coalesce.h"
+#include "esp32_driver_nextion/component.h"
+#include "protocol/protocol.h"
+#include "common_infra_test.h"
+
+#ifdef CONFIG_NEX_COALESCE
+TEST_CASE("Coalesce writes of a value", "[coalesce]")
+{
+    coalescer_t *coalescer = nextion_protocol_get_coalescer(handle);
+    nex_err_t code = NEX_OK;
+    int32_t number = 0;
+
+    // Holding the flushes, the frame task cannot send a value in between.
+    xSemaphoreTake(coalescer->flush_sync, portMAX_DELAY);
+
+    for (int32_t i = 1; i <= 10 && code == NEX_OK; i++)
+    {
+        code = nextion_coalesce_set_value(handle, "x0", i);
+    }
+
+    const size_t waiting_count = coalescer->count - coalescer->head;
+
+    xSemaphoreGive(coalescer->flush_sync);
+
+    CHECK_NEX_OK(code);
+    CHECK_NEX_OK(nextion_coalesce_flush(handle));
+
+    nextion_component_get_value(handle, "x0", &number);
+
+    // Ten writes, a single instruction.
+    SIZET_EQUAL(1, waiting_count);
+    LONGS_EQUAL(10, number);
+}
+
+TEST_CASE("Coalesce writes of a text", "[coalesce]")
+{
+    char text[10];
+
+    CHECK_NEX_OK(nextion_coalesce_set_text(handle, "b0", "first"));
+    CHECK_NEX_OK(nextion_coalesce_set_text(handle, "b0", "second"));
+    CHECK_NEX_OK(nextion_coalesce_flush(handle));
+
+    nextion_component_get_text(handle, "b0", text, sizeof(text));
+
+    STRCMP_EQUAL("second", text);
+}
+
+TEST_CASE("Send coalesced writes on the next frame", "[coalesce]")
+{
+    int32_t number = 0;
+
+    CHECK_NEX_OK(nextion_coalesce_set_period(handle, 20));
+    CHECK_NEX_OK(nextion_coalesce_set_value(handle, "x0", 30));
+
+    vTaskDelay(pdMS_TO_TICKS(100));
+
+    nextion_coalesce_set_period(handle, 50);
+    nextion_component_get_value(handle, "x0", &number);
+
+    LONGS_EQUAL(30, number);
+}
+
+TEST_CASE("Send a text too long to coalesce", "[coalesce]")
+{
+    // Sent immediately, so the device result is returned.
+    nex_err_t code = nextion_coalesce_set_property_text(handle, "n99", "txt", "a text much longer than it can wait");
+
+    NEX_CODES_EQUAL(NEX_DVC_ERR_INVALID_VARIABLE_OR_ATTRIBUTE, code);
+}
+
+TEST_CASE("Cannot set a frame period shorter than a tick", "[coalesce]")
+{
+    CHECK_NEX_FAIL(nextion_coalesce_set_period(handle, 0));
+}
+#else
+TEST_CASE("Cannot coalesce writes when disabled", "[coalesce]")
+{
+    CHECK_NEX_FAIL(nextion_coalesce_set_value(handle, "x0", 10));
+    CHECK_NEX_FAIL(nextion_coalesce_flush(handle));
+}
+#endif
@@ -1,6 +1,16 @@
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp32_driver_nextion/base/events.h"
 #include "esp32_driver_nextion/component.h"
+#include "esp32_driver_nextion/instruction.h"
 #include "common_infra_test.h"
 
+static void callback_touched(TaskHandle_t task_handle,
+                             esp_event_base_t event_base,
+                             nextion_event_t event_id,
+                             const nextion_on_touch_event_t *event);
+
 TEST_CASE("Refresh component", "[component]")
 {
     nex_err_t code = nextion_component_refresh(handle, "n0");
@@ -84,6 +94,79 @@ TEST_CASE("Get component value", "[component]")
     LONGS_EQUAL(-5, number);
 }
 
+TEST_CASE("Get many component values", "[component]")
+{
+    const char *const component_names[] = {"n0", "c0", "n0"};
+    int32_t numbers[3] = {0};
+    nex_err_t code = nextion_component_get_values(handle, component_names, 3, numbers);
+
+    CHECK_NEX_OK(code);
+    LONGS_EQUAL(-5, numbers[0]);
+    LONGS_EQUAL(1, numbers[1]);
+    LONGS_EQUAL(-5, numbers[2]);
+}
+
+TEST_CASE("Cannot get many values with an invalid component", "[component]")
+{
+    const char *const component_names[] = {"n0", "n99"};
+    int32_t numbers[2];
+    nex_err_t code = nextion_component_get_values(handle, component_names, 2, numbers);
+
+    NEX_CODES_EQUAL(NEX_TIMEOUT, code);
+}
+
+TEST_CASE("Send instructions and receive events after getting many values", "[component]")
+{
+    static const char TOUCH_INSTRUCTION[] = "printh 65 00 01 01 FF FF FF";
+
+    const char *const component_names[] = {"n0", "c0"};
+    TaskHandle_t current_task = xTaskGetCurrentTaskHandle();
+    int32_t numbers[2] = {0};
+    int32_t number = 0;
+
+    xTaskNotifyStateClear(current_task);
+
+    esp_event_handler_register(NEXTION_EVENT, NEXTION_EVENT_TOUCHED, (esp_event_handler_t)callback_touched, current_task);
+
+    nex_err_t code = nextion_component_get_values(handle, component_names, 2, numbers);
+
+    // The device sends back a press, as if touched.
+    nex_err_t touch_code = nextion_instruction_send(handle, TOUCH_INSTRUCTION, strlen(TOUCH_INSTRUCTION));
+
+    uint32_t notification_value = 0;
+
+    bool success = xTaskNotifyWait(0, 0xFFFFFFFF, &notification_value, pdMS_TO_TICKS(5000)) == pdTRUE && ((notification_value & 0x01) != 0);
+
+    esp_event_handler_unregister(NEXTION_EVENT, NEXTION_EVENT_TOUCHED, (esp_event_handler_t)callback_touched);
+
+    nex_err_t get_code = nextion_component_get_value(handle, "n0", &number);
+
+    if (!success)
+    {
+        FAIL_TEST("Did not receive touched event");
+    }
+
+    CHECK_NEX_OK(code);
+    CHECK_NEX_OK(touch_code);
+    CHECK_NEX_OK(get_code);
+    LONGS_EQUAL(numbers[0], number);
+}
+
+TEST_CASE("Cannot get more values than a response holds", "[component]")
+{
+    const char *component_names[32];
+    int32_t numbers[32];
+
+    for (size_t i = 0; i < 32; i++)
+    {
+        component_names[i] = "n0";
+    }
+
+    nex_err_t code = nextion_component_get_values(handle, component_names, 32, numbers);
+
+    CHECK_NEX_FAIL(code);
+}
+
 TEST_CASE("Get component boolean", "[component]")
 {
     bool value;
@@ -146,6 +229,17 @@ TEST_CASE("Get component property number", "[component]")
     LONGS_EQUAL(-5, number);
 }
 
+TEST_CASE("Get many component property numbers", "[component]")
+{
+    const char *const component_names[] = {"n0", "c0"};
+    int32_t numbers[2] = {0};
+    nex_err_t code = nextion_component_get_property_numbers(handle, component_names, 2, "val", numbers);
+
+    CHECK_NEX_OK(code);
+    LONGS_EQUAL(-5, numbers[0]);
+    LONGS_EQUAL(1, numbers[1]);
+}
+
 TEST_CASE("Set component property text", "[component]")
 {
     char text[8];
@@ -167,4 +261,12 @@ TEST_CASE("Set component property number", "[component]")
 
     CHECK_NEX_OK(code);
     LONGS_EQUAL(100, number);
-}
\ No newline at end of file
+}
+
+void callback_touched(TaskHandle_t task_handle,
+                      esp_event_base_t event_base,
+                      nextion_event_t event_id,
+                      const nextion_on_touch_event_t *event)
+{
+    xTaskNotify(task_handle, 0x01, eSetBits);
+}
@@ -0,0 +1,106 @@
+#include <string_view>
+#include "esp32_driver_nextion/component.h"
+#include "esp32_driver_nextion/nextion.hpp"
+#include "common_infra_test.h"
+
+// Instructions are built by the compiler; nothing is left for runtime.
+static_assert(std::string_view(nextion::component_value<"n0">::assignment.text) == "n0.val=");
+static_assert(std::string_view(nextion::component_value<"n0">::query.text) == "get n0.val");
+static_assert(nextion::component_text<"t0", 10>::assignment.length() == 7);
+
+TEST_CASE("Send compile-time instruction", "[cpp]")
+{
+    nex_err_t code = nextion::send<"ref n0">(handle);
+
+    CHECK_NEX_OK(code);
+}
+
+TEST_CASE("Get compile-time instruction number", "[cpp]")
+{
+    nextion::result<int32_t> result = nextion::get<int32_t, "get n0.val">(handle);
+
+    CHECK_NEX_OK(result.code);
+    LONGS_EQUAL(-5, result.value);
+}
+
+TEST_CASE("Get component value as typed result", "[cpp]")
+{
+    auto result = nextion::component_value<"n0">::get(handle);
+
+    CHECK_TRUE(result.ok());
+    LONGS_EQUAL(-5, result.value);
+}
+
+TEST_CASE("Cannot get invalid component value as typed result", "[cpp]")
+{
+    auto result = nextion::component_value<"n99">::get(handle);
+
+    CHECK_FALSE(result.ok());
+    NEX_CODES_EQUAL(NEX_DVC_ERR_INVALID_VARIABLE_OR_ATTRIBUTE, result.code);
+}
+
+TEST_CASE("Set component value from template", "[cpp]")
+{
+    nex_err_t code = nextion::component_value<"x0">::set(handle, -2147483647 - 1);
+    auto result = nextion::component_value<"x0">::get(handle);
+
+    CHECK_NEX_OK(code);
+    LONGS_EQUAL(-2147483647 - 1, result.value);
+}
+
+TEST_CASE("Set component value from template between values set from C", "[cpp]")
+{
+    int32_t number = 0;
+
+    nextion_component_set_value(handle, "x0", 10);
+    nextion::component_value<"x0">::set(handle, 20);
+
+    // Not skipped by the shadow cache, if enabled.
+    nex_err_t code = nextion_component_set_value(handle, "x0", 10);
+
+    nextion_component_get_value(handle, "x0", &number);
+
+    CHECK_NEX_OK(code);
+    LONGS_EQUAL(10, number);
+}
+
+TEST_CASE("Get component boolean as typed result", "[cpp]")
+{
+    auto result = nextion::component_boolean<"c0">::get(handle);
+
+    CHECK_NEX_OK(result.code);
+    CHECK_TRUE(result.value);
+}
+
+TEST_CASE("Set component boolean from template", "[cpp]")
+{
+    nex_err_t code = nextion::component_boolean<"r0">::set(handle, true);
+    auto result = nextion::component_boolean<"r0">::get(handle);
+
+    CHECK_NEX_OK(code);
+    CHECK_TRUE(result.value);
+}
+
+TEST_CASE("Get component text as typed result", "[cpp]")
+{
+    auto result = nextion::component_text<"t0", 10>::get(handle);
+
+    CHECK_NEX_OK(result.code);
+    STRCMP_EQUAL("test text", result.value.c_str());
+}
+
+TEST_CASE("Set component text from template", "[cpp]")
+{
+    nex_err_t code = nextion::component_text<"b0", 8>::set(handle, "Button!");
+    auto result = nextion::component_text<"b0", 8>::get(handle);
+
+    CHECK_NEX_OK(code);
+    STRCMP_EQUAL("Button!", result.value.c_str());
+}
+
+TEST_CASE("Cannot set component text bigger than its capacity", "[cpp]")
+{
+    nex_err_t code = nextion::component_text<"b0", 4>::set(handle, "Button!");
+
+    CHECK_NEX_FAIL(code);
+}
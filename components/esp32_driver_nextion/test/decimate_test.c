@@ -0,0 +1,102 @@
+#include "esp32_driver_nextion/decimate.h"
+#include "common_infra_test.h"
+
+#define TEST_WINDOW_LENGTH 400U
+#define TEST_WIDTH 40U
+
+TEST_CASE("Reduce samples to min/max pairs", "[decimate]")
+{
+    nextion_decimator_t decimator;
+    uint8_t samples[TEST_WINDOW_LENGTH];
+    uint8_t output[2 * TEST_WIDTH];
+
+    for (size_t i = 0; i < TEST_WINDOW_LENGTH; i++)
+    {
+        samples[i] = (uint8_t)(i % 20);
+    }
+
+    CHECK_NEX_OK(nextion_decimate_init(&decimator, NEXTION_DECIMATE_MIN_MAX, TEST_WINDOW_LENGTH, TEST_WIDTH, NULL, 0));
+
+    const size_t output_length = nextion_decimate_push(&decimator, samples, TEST_WINDOW_LENGTH, output);
+
+    SIZET_EQUAL(TEST_WIDTH, output_length);
+    LONGS_EQUAL(0, output[0]);
+    LONGS_EQUAL(19, output[1]);
+}
+
+TEST_CASE("Keep min/max pairs in the order they came", "[decimate]")
+{
+    const uint8_t samples[] = {50, 90, 10, 60};
+    nextion_decimator_t decimator;
+    uint8_t output[4];
+
+    CHECK_NEX_OK(nextion_decimate_init(&decimator, NEXTION_DECIMATE_MIN_MAX, 8, 4, NULL, 0));
+
+    const size_t output_length = nextion_decimate_push(&decimator, samples, sizeof(samples), output);
+
+    SIZET_EQUAL(2, output_length);
+    LONGS_EQUAL(90, output[0]);
+    LONGS_EQUAL(10, output[1]);
+}
+
+TEST_CASE("Keep a peak with LTTB", "[decimate]")
+{
+    uint8_t buffer[NEXTION_DECIMATE_LTTB_BUFFER_LENGTH(TEST_WINDOW_LENGTH, TEST_WIDTH)];
+    uint8_t samples[TEST_WINDOW_LENGTH] = {0};
+    uint8_t output[TEST_WIDTH + 2];
+    nextion_decimator_t decimator;
+    bool has_peak = false;
+
+    samples[123] = 255;
+
+    CHECK_NEX_OK(nextion_decimate_init(&decimator, NEXTION_DECIMATE_LTTB, TEST_WINDOW_LENGTH, TEST_WIDTH, buffer, sizeof(buffer)));
+
+    size_t output_length = nextion_decimate_push(&decimator, samples, TEST_WINDOW_LENGTH, output);
+
+    output_length += nextion_decimate_flush(&decimator, output + output_length);
+
+    for (size_t i = 0; i < output_length; i++)
+    {
+        has_peak = has_peak || output[i] == 255;
+    }
+
+    SIZET_EQUAL(TEST_WIDTH + 1, output_length);
+    CHECK_TRUE(has_peak);
+}
+
+TEST_CASE("Reduce samples pushed one by one", "[decimate]")
+{
+    uint8_t buffer[NEXTION_DECIMATE_LTTB_BUFFER_LENGTH(TEST_WINDOW_LENGTH, TEST_WIDTH)];
+    uint8_t output[TEST_WIDTH + 2];
+    nextion_decimator_t decimator;
+    size_t output_length = 0;
+
+    CHECK_NEX_OK(nextion_decimate_init(&decimator, NEXTION_DECIMATE_LTTB, TEST_WINDOW_LENGTH, TEST_WIDTH, buffer, sizeof(buffer)));
+
+    for (size_t i = 0; i < TEST_WINDOW_LENGTH; i++)
+    {
+        const uint8_t sample = (uint8_t)i;
+
+        output_length += nextion_decimate_push(&decimator, &sample, 1, output + output_length);
+    }
+
+    output_length += nextion_decimate_flush(&decimator, output + output_length);
+
+    SIZET_EQUAL(TEST_WIDTH + 1, output_length);
+    LONGS_EQUAL(0, output[0]);
+    LONGS_EQUAL((uint8_t)(TEST_WINDOW_LENGTH - 1), output[output_length - 1]);
+}
+
+TEST_CASE("Cannot decimate a window narrower than twice the width", "[decimate]")
+{
+    nextion_decimator_t decimator;
+
+    CHECK_NEX_FAIL(nextion_decimate_init(&decimator, NEXTION_DECIMATE_MIN_MAX, TEST_WIDTH, TEST_WIDTH, NULL, 0));
+}
+
+TEST_CASE("Cannot decimate with LTTB without a buffer", "[decimate]")
+{
+    nextion_decimator_t decimator;
+
+    CHECK_NEX_FAIL(nextion_decimate_init(&decimator, NEXTION_DECIMATE_LTTB, TEST_WINDOW_LENGTH, TEST_WIDTH, NULL, 0));
+}
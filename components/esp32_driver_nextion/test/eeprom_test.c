@@ -57,6 +57,45 @@ TEST_CASE("Stream works", "[eeprom]")
     }
 }
 
+TEST_CASE("Stream works with buffer", "[eeprom]")
+{
+    uint8_t values[50];
+    uint8_t returned_values[50];
+
+    for (size_t i = 0; i < 50; i++)
+    {
+        values[i] = (uint8_t)(i * 3);
+    }
+
+    if (nextion_eeprom_stream_begin(handle, 100, 50) != NEX_OK)
+    {
+        FAIL_TEST("Could not start streaming");
+    }
+
+    nex_err_t code = nextion_eeprom_stream_write_buffer(handle, values, 50);
+
+    nextion_eeprom_read_bytes(handle, 100, returned_values, 50);
+
+    CHECK_NEX_OK(code);
+    BYTES_EQUAL(values, returned_values, 50);
+}
+
+TEST_CASE("Cannot write more values than the stream expects", "[eeprom]")
+{
+    uint8_t values[10] = {0};
+
+    if (nextion_eeprom_stream_begin(handle, 100, 5) != NEX_OK)
+    {
+        FAIL_TEST("Could not start streaming");
+    }
+
+    nex_err_t code = nextion_eeprom_stream_write_buffer(handle, values, 10);
+
+    nextion_eeprom_stream_write_buffer(handle, values, 5);
+
+    CHECK_NEX_FAIL(code);
+}
+
 TEST_CASE("Cannot start stream with invalid address", "[eeprom]")
 {
     nex_err_t code = nextion_eeprom_stream_begin(handle, NEX_DVC_EEPROM_MAX_ADDRESS + 1, 0);
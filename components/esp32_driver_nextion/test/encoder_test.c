@@ -0,0 +1,93 @@
+#include <stdio.h>
+#include <stdint.h>
+#include "esp_timer.h"
+#include "protocol/encoder.h"
+#include "protocol/protocol.h"
+#include "common_infra_test.h"
+
+#define BENCHMARK_ENCODE_COUNT 10000U
+
+TEST_CASE("Encode numbers", "[encoder]")
+{
+    char buffer[64];
+    encoder_t encoder;
+    const int32_t numbers[] = {0, 7, 10, 99, 100, -1, -305, 123456789, INT32_MAX, INT32_MIN};
+
+    encoder_begin(&encoder, buffer, sizeof(buffer));
+    ENCODER_APPEND_LITERAL(&encoder, "n ");
+    encoder_append_numbers(&encoder, numbers, sizeof(numbers) / sizeof(numbers[0]));
+
+    CHECK_TRUE(encoder_end(&encoder));
+    STRCMP_EQUAL("n 0,7,10,99,100,-1,-305,123456789,2147483647,-2147483648", buffer);
+    SIZET_EQUAL(56, encoder.length);
+}
+
+TEST_CASE("Encode property assignment", "[encoder]")
+{
+    char buffer[32];
+    encoder_t encoder;
+
+    encoder_begin(&encoder, buffer, sizeof(buffer));
+    encoder_append_property(&encoder, "t0", "txt");
+    encoder_append_char(&encoder, '=');
+    encoder_append_quoted(&encoder, "a b");
+
+    CHECK_TRUE(encoder_end(&encoder));
+    STRCMP_EQUAL("t0.txt=\"a b\"", buffer);
+}
+
+TEST_CASE("Encode fails if buffer insufficient", "[encoder]")
+{
+    char buffer[8];
+    encoder_t encoder;
+
+    encoder_begin(&encoder, buffer, sizeof(buffer));
+    ENCODER_APPEND_LITERAL(&encoder, "add ");
+    encoder_append_number(&encoder, 1000);
+
+    // The null terminator does not fit.
+    CHECK_FALSE(encoder_end(&encoder));
+}
+
+TEST_CASE("Benchmark encoder versus formatter", "[encoder][benchmark]")
+{
+    char buffer[CONFIG_NEX_UART_TRANS_COMMAND_FORMAT_BUFFER_SIZE];
+    formated_instruction_t instruction;
+    encoder_t encoder;
+
+    int64_t start = esp_timer_get_time();
+
+    for (size_t i = 0; i < BENCHMARK_ENCODE_COUNT; i++)
+    {
+        nextion_protocol_format_instruction(&instruction, "%s.%s=%ld", "n0", "val", (int32_t)(i * 7919));
+        nextion_protocol_format_instruction(&instruction, "fill %d,%d,%d,%d,%d", 10, 20, 300, 200, (int)i);
+    }
+
+    int64_t format_us = esp_timer_get_time() - start;
+
+    start = esp_timer_get_time();
+
+    for (size_t i = 0; i < BENCHMARK_ENCODE_COUNT; i++)
+    {
+        const int32_t parameters[] = {10, 20, 300, 200, (int32_t)i};
+
+        encoder_begin(&encoder, buffer, sizeof(buffer));
+        encoder_append_property(&encoder, "n0", "val");
+        encoder_append_char(&encoder, '=');
+        encoder_append_number(&encoder, (int32_t)(i * 7919));
+        encoder_end(&encoder);
+
+        encoder_begin(&encoder, buffer, sizeof(buffer));
+        ENCODER_APPEND_LITERAL(&encoder, "fill ");
+        encoder_append_numbers(&encoder, parameters, 5);
+        encoder_end(&encoder);
+    }
+
+    int64_t encode_us = esp_timer_get_time() - start;
+
+    // Timing depends on the machine: reported, not checked.
+    printf("vsnprintf: %lld ns/instruction\n", (long long)((format_us * 1000LL) / (BENCHMARK_ENCODE_COUNT * 2)));
+    printf("encoder: %lld ns/instruction\n", (long long)((encode_us * 1000LL) / (BENCHMARK_ENCODE_COUNT * 2)));
+
+    STRCMP_EQUAL("fill 10,20,300,200,9999", buffer);
+}
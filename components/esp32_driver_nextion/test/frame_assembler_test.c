@@ -0,0 +1,118 @@
+#include <stdio.h>
+#include "esp_timer.h"
+#include "esp32_driver_nextion/base/codes.h"
+#include "protocol/parsers/events/touch_coord.h"
+#include "protocol/parsers/responses/ack.h"
+#include "protocol/parsers/responses/text.h"
+#include "protocol/event.h"
+#include "protocol/frame_assembler.h"
+#include "common_infra_test.h"
+
+#define BENCHMARK_FRAME_COUNT 10000U
+
+static const uint8_t TOUCH_COORD_FRAME[] = {NEX_DVC_EVT_TOUCH_COORDINATE_AWAKE, 0x00, 0x7A, 0x00, 0x1E, 0x01, 0xFF, 0xFF, 0xFF};
+
+TEST_CASE("Frame assembler finds fixed size frame", "[frame_assembler]")
+{
+    frame_assembler_t assembler = {0};
+    parser_t parser = PARSER_ACK();
+    const uint8_t data[] = {NEX_DVC_INS_OK, 0xFF, 0xFF, 0xFF};
+
+    frame_assembler_push(&assembler, data, sizeof(data));
+
+    SIZET_EQUAL(4, frame_assembler_find_frame(&assembler, &parser));
+}
+
+TEST_CASE("Frame assembler keeps partial frame", "[frame_assembler]")
+{
+    frame_assembler_t assembler = {0};
+    parser_t parser = PARSER_ACK();
+    const uint8_t data[] = {NEX_DVC_INS_OK, 0xFF, 0xFF, 0xFF};
+
+    frame_assembler_push(&assembler, data, 2);
+
+    SIZET_EQUAL(0, frame_assembler_find_frame(&assembler, &parser));
+    SIZET_EQUAL(2, assembler.length);
+
+    frame_assembler_push(&assembler, data + 2, 2);
+
+    SIZET_EQUAL(4, frame_assembler_find_frame(&assembler, &parser));
+}
+
+TEST_CASE("Frame assembler finds text frame", "[frame_assembler]")
+{
+    frame_assembler_t assembler = {0};
+    char text[10];
+    parser_t parser = PARSER_TEXT(text, sizeof(text));
+    const uint8_t data[] = {NEX_DVC_RSP_GET_TEXT, 'a', 'b', 'c', 0xFF, 0xFF, 0xFF, NEX_DVC_INS_OK};
+
+    frame_assembler_push(&assembler, data, sizeof(data));
+
+    SIZET_EQUAL(7, frame_assembler_find_frame(&assembler, &parser));
+}
+
+TEST_CASE("Frame assembler keeps bytes after consumed frame", "[frame_assembler]")
+{
+    frame_assembler_t assembler = {0};
+    parser_t parser = PARSER_ACK();
+    const uint8_t data[] = {NEX_DVC_INS_OK, 0xFF, 0xFF, 0xFF, NEX_DVC_INS_FAIL, 0xFF};
+
+    frame_assembler_push(&assembler, data, sizeof(data));
+    frame_assembler_consume(&assembler, frame_assembler_find_frame(&assembler, &parser));
+
+    SIZET_EQUAL(2, assembler.length);
+    LONGS_EQUAL(NEX_DVC_INS_FAIL, assembler.buffer[0]);
+}
+
+TEST_CASE("Frame assembler does not push past its capacity", "[frame_assembler]")
+{
+    frame_assembler_t assembler = {0};
+    uint8_t data[CONFIG_NEX_UART_RECV_FRAME_BUFFER_SIZE + 10] = {0};
+
+    size_t pushed = frame_assembler_push(&assembler, data, sizeof(data));
+
+    SIZET_EQUAL(CONFIG_NEX_UART_RECV_FRAME_BUFFER_SIZE, pushed);
+    SIZET_EQUAL(0, frame_assembler_free_space(&assembler));
+}
+
+TEST_CASE("Benchmark frame assembly from bulk reads", "[frame_assembler][benchmark]")
+{
+    frame_assembler_t assembler = {0};
+    nextion_on_touch_coord_event_t event;
+    event_parser_t event_parser;
+    size_t frames = 0;
+
+    try_get_event_parser(TOUCH_COORD_FRAME[0], &event, sizeof(event), &event_parser);
+
+    // Everything buffered appended at once, frames cut from it.
+    const size_t frames_per_read = CONFIG_NEX_UART_RECV_FRAME_BUFFER_SIZE / sizeof(TOUCH_COORD_FRAME);
+    int64_t start = esp_timer_get_time();
+
+    while (frames < BENCHMARK_FRAME_COUNT)
+    {
+        for (size_t i = 0; i < frames_per_read; i++)
+        {
+            frame_assembler_push(&assembler, TOUCH_COORD_FRAME, sizeof(TOUCH_COORD_FRAME));
+        }
+
+        size_t frame_length;
+
+        while ((frame_length = frame_assembler_find_frame(&assembler, &event_parser.base)) > 0)
+        {
+            event_parser.base.parse(&event_parser.base, assembler.buffer, frame_length);
+            frame_assembler_consume(&assembler, frame_length);
+            frames++;
+        }
+    }
+
+    int64_t bulk_us = esp_timer_get_time() - start;
+
+    // Timing depends on the machine: reported, not checked.
+    printf("frame assembly, bulk: %lld ns/event, %lld events/s\n",
+           (long long)((bulk_us * 1000LL) / (int64_t)frames),
+           (long long)((frames * 1000000LL) / (bulk_us + 1)));
+
+    SIZET_EQUAL(0, assembler.length);
+    LONGS_EQUAL(122, event.x);
+    LONGS_EQUAL(30, event.y);
+}
@@ -29,6 +29,7 @@ extern "C"
 #define NEX_TOUCH_STATES_EQUAL(a, b) TEST_ASSERT_EQUAL_UINT8(a, b)
 #define LONGS_EQUAL(expected, actual) TEST_ASSERT_EQUAL_INT(expected, actual)
 #define STRCMP_EQUAL(expected, actual) TEST_ASSERT_EQUAL_STRING(expected, actual)
+#define BYTES_EQUAL(expected, actual, length) TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, actual, length)
 #define FAIL_TEST(message) TEST_FAIL_MESSAGE(message)
 
 #ifdef __cplusplus
@@ -7,3 +7,17 @@ TEST_CASE("Cannot init null context", "[core]")
 
     CHECK_NEX_FAIL(result);
 }
+
+TEST_CASE("Cannot init null context finding baud rate", "[core]")
+{
+    nex_err_t result = nextion_init_auto_baud(NULL, NEXTION_BAUD_RATE_115200);
+
+    CHECK_NEX_FAIL(result);
+}
+
+TEST_CASE("Cannot install driver over null transport", "[core]")
+{
+    nextion_t *result = nextion_driver_install_transport(NULL, NEXTION_BAUD_RATE_115200);
+
+    CHECK_NULL(result);
+}
@@ -0,0 +1,88 @@
+#include "esp32_driver_nextion/property.h"
+#include "common_infra_test.h"
+
+TEST_CASE("Prepare property", "[property]")
+{
+    nextion_property_t property;
+    nex_err_t code = nextion_property_prepare(handle, "n0", "val", &property);
+
+    CHECK_NEX_OK(code);
+    STRCMP_EQUAL("get n0.val=", property.instruction);
+    SIZET_EQUAL(6, property.path_length);
+}
+
+TEST_CASE("Cannot prepare property with name too long", "[property]")
+{
+    nextion_property_t property;
+    nex_err_t code = nextion_property_prepare(handle, "a_very_long_component_name", "a_long_property", &property);
+
+    CHECK_NEX_FAIL(code);
+}
+
+TEST_CASE("Get prepared property number", "[property]")
+{
+    nextion_property_t property;
+    int32_t number;
+
+    nextion_property_prepare(handle, "n0", "val", &property);
+
+    nex_err_t code = nextion_property_get_number(&property, &number);
+
+    CHECK_NEX_OK(code);
+    LONGS_EQUAL(-5, number);
+}
+
+TEST_CASE("Cannot get invalid prepared property number", "[property]")
+{
+    nextion_property_t property;
+    int32_t number;
+
+    nextion_property_prepare(handle, "n99", "val", &property);
+
+    nex_err_t code = nextion_property_get_number(&property, &number);
+
+    NEX_CODES_EQUAL(NEX_DVC_ERR_INVALID_VARIABLE_OR_ATTRIBUTE, code);
+}
+
+TEST_CASE("Set prepared property number", "[property]")
+{
+    nextion_property_t property;
+    int32_t number = 0;
+
+    nextion_property_prepare(handle, "x0", "val", &property);
+
+    nex_err_t code = nextion_property_set_number(&property, 150);
+
+    nextion_property_get_number(&property, &number);
+
+    CHECK_NEX_OK(code);
+    LONGS_EQUAL(150, number);
+}
+
+TEST_CASE("Get prepared property text", "[property]")
+{
+    nextion_property_t property;
+    char text[10];
+
+    nextion_property_prepare(handle, "t0", "txt", &property);
+
+    nex_err_t code = nextion_property_get_text(&property, text, sizeof(text));
+
+    CHECK_NEX_OK(code);
+    STRCMP_EQUAL("test text", text);
+}
+
+TEST_CASE("Set prepared property text", "[property]")
+{
+    nextion_property_t property;
+    char text[8];
+
+    nextion_property_prepare(handle, "b0", "txt", &property);
+
+    nex_err_t code = nextion_property_set_text(&property, "Button!");
+
+    nextion_property_get_text(&property, text, sizeof(text));
+
+    CHECK_NEX_OK(code);
+    STRCMP_EQUAL("Button!", text);
+}
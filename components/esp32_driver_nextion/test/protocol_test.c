@@ -1,12 +1,26 @@
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp32_driver_nextion/component.h"
 #include "protocol/protocol.h"
 #include "common_infra_test.h"
 
+#define CONCURRENT_INSTRUCTION_COUNT 50
+
+typedef struct
+{
+    const char *component_name;
+    SemaphoreHandle_t done;
+    bool failed;
+} concurrent_sender_t;
+
+static void concurrent_sender_task(void *pvParameters);
+
 TEST_CASE("Format fails if buffer insufficient", "[protocol]")
 {
     formated_instruction_t instruction;
 
-    bool result = nextion_protocol_format_instruction(handle,
-                                                      &instruction,
+    bool result = nextion_protocol_format_instruction(&instruction,
                                                       "This text has more than %d characters, meaning it is bigger than the configured test buffer size. Filling spaces:                 ",
                                                       128);
 
@@ -17,12 +31,57 @@ TEST_CASE("Format succeeds", "[protocol]")
 {
     formated_instruction_t instruction;
 
-    bool result = nextion_protocol_format_instruction(handle,
-                                                      &instruction,
+    bool result = nextion_protocol_format_instruction(&instruction,
                                                       "Sample text: %d",
                                                       128);
 
     CHECK_TRUE(result);
     STRCMP_EQUAL("Sample text: 128", instruction.text);
     LONGS_EQUAL(16, instruction.length);
-}
\ No newline at end of file
+}
+
+TEST_CASE("Send from many tasks at once", "[protocol]")
+{
+    int32_t number_n0 = 0;
+    int32_t number_x0 = 0;
+    concurrent_sender_t senders[2] = {{.component_name = "n0"}, {.component_name = "x0"}};
+
+    for (size_t i = 0; i < 2; i++)
+    {
+        senders[i].done = xSemaphoreCreateBinary();
+
+        xTaskCreate(concurrent_sender_task, "sender", 4096, &senders[i], 5, NULL);
+    }
+
+    for (size_t i = 0; i < 2; i++)
+    {
+        xSemaphoreTake(senders[i].done, portMAX_DELAY);
+        vSemaphoreDelete(senders[i].done);
+    }
+
+    nextion_component_get_value(handle, "n0", &number_n0);
+    nextion_component_get_value(handle, "x0", &number_x0);
+
+    CHECK_FALSE(senders[0].failed);
+    CHECK_FALSE(senders[1].failed);
+    LONGS_EQUAL(CONCURRENT_INSTRUCTION_COUNT, number_n0);
+    LONGS_EQUAL(CONCURRENT_INSTRUCTION_COUNT, number_x0);
+}
+
+static void concurrent_sender_task(void *pvParameters)
+{
+    concurrent_sender_t *sender = (concurrent_sender_t *)pvParameters;
+
+    // Both tasks format at the same time; a shared
+    // buffer would mix up their instructions.
+    for (int i = 1; i <= CONCURRENT_INSTRUCTION_COUNT; i++)
+    {
+        if (nextion_protocol_send_instruction_ack(handle, "%s.val=%d", sender->component_name, i) != NEX_OK)
+        {
+            sender->failed = true;
+        }
+    }
+
+    xSemaphoreGive(sender->done);
+    vTaskDelete(NULL);
+}
@@ -0,0 +1,143 @@
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp32_driver_nextion/component.h"
+#include "esp32_driver_nextion/pump.h"
+#include "esp32_driver_nextion/waveform.h"
+#include "common_infra_test.h"
+
+#ifdef CONFIG_NEX_WAVEFORM_PUMP
+TEST_CASE("Stream pushed samples", "[pump]")
+{
+    nextion_pump_channel_t *channel = nextion_pump_open(handle, 17, 0);
+    uint8_t samples[100];
+
+    for (size_t i = 0; i < sizeof(samples); i++)
+    {
+        samples[i] = (uint8_t)i;
+    }
+
+    CHECK_NOT_NULL(channel);
+
+    SIZET_EQUAL(sizeof(samples), nextion_pump_push_buffer(channel, samples, sizeof(samples)));
+    CHECK_TRUE(nextion_pump_push(channel, 100));
+
+    nex_err_t code = nextion_pump_flush(handle);
+
+    nextion_pump_close(handle, channel);
+
+    CHECK_NEX_OK(code);
+}
+
+TEST_CASE("Stream pushed samples on the next period", "[pump]")
+{
+    nextion_pump_channel_t *channel = nextion_pump_open(handle, 17, 0);
+
+    CHECK_NOT_NULL(channel);
+
+    CHECK_NEX_OK(nextion_pump_set_period(handle, 10));
+
+    for (uint8_t i = 0; i < 50; i++)
+    {
+        nextion_pump_push(channel, i);
+    }
+
+    vTaskDelay(pdMS_TO_TICKS(200));
+
+    nextion_pump_set_period(handle, 20);
+    nextion_pump_close(handle, channel);
+
+    // Nothing is left in the Transparent Data Mode.
+    CHECK_NEX_OK(nextion_waveform_clear(handle, 17));
+}
+
+TEST_CASE("Send instructions while the pump streams", "[pump]")
+{
+    nextion_pump_channel_t *channel = nextion_pump_open(handle, 17, 0);
+    nex_err_t code = NEX_OK;
+    int32_t number = 0;
+    uint8_t samples[100];
+
+    for (size_t i = 0; i < sizeof(samples); i++)
+    {
+        samples[i] = (uint8_t)i;
+    }
+
+    CHECK_NOT_NULL(channel);
+
+    CHECK_NEX_OK(nextion_pump_set_period(handle, 10));
+
+    // The pump task streams while this one sends; an instruction
+    // sent in the middle of a stream would be taken as samples.
+    for (int32_t i = 1; i <= 50 && code == NEX_OK; i++)
+    {
+        nextion_pump_push_buffer(channel, samples, sizeof(samples));
+
+        code = nextion_component_set_value(handle, "n0", i);
+
+        vTaskDelay(pdMS_TO_TICKS(5));
+    }
+
+    vTaskDelay(pdMS_TO_TICKS(100));
+
+    nextion_pump_set_period(handle, 20);
+    nextion_pump_close(handle, channel);
+
+    nextion_component_get_value(handle, "n0", &number);
+
+    CHECK_NEX_OK(code);
+    LONGS_EQUAL(50, number);
+    CHECK_NEX_OK(nextion_waveform_clear(handle, 17));
+}
+
+TEST_CASE("Drop samples pushed onto a full channel", "[pump]")
+{
+    // Never streamed: the waveform does not exist.
+    nextion_pump_channel_t *channel = nextion_pump_open(handle, 99, 0);
+    uint8_t samples[CONFIG_NEX_WAVEFORM_PUMP_RING_SIZE] = {0};
+
+    CHECK_NOT_NULL(channel);
+
+    const size_t pushed = nextion_pump_push_buffer(channel, samples, sizeof(samples));
+    const bool is_pushed = nextion_pump_push(channel, 0);
+    const size_t dropped = nextion_pump_get_dropped(channel);
+
+    nextion_pump_close(handle, channel);
+
+    // A slot is always left empty.
+    SIZET_EQUAL(CONFIG_NEX_WAVEFORM_PUMP_RING_SIZE - 1, pushed);
+    CHECK_FALSE(is_pushed);
+    SIZET_EQUAL(2, dropped);
+}
+
+TEST_CASE("Cannot open a channel twice", "[pump]")
+{
+    nextion_pump_channel_t *channel = nextion_pump_open(handle, 17, 0);
+    nextion_pump_channel_t *again = nextion_pump_open(handle, 17, 0);
+
+    nextion_pump_close(handle, channel);
+
+    CHECK_NOT_NULL(channel);
+    CHECK_NULL(again);
+}
+
+TEST_CASE("Cannot close a channel twice", "[pump]")
+{
+    nextion_pump_channel_t *channel = nextion_pump_open(handle, 17, 0);
+
+    CHECK_NOT_NULL(channel);
+
+    CHECK_NEX_OK(nextion_pump_close(handle, channel));
+    CHECK_NEX_FAIL(nextion_pump_close(handle, channel));
+}
+
+TEST_CASE("Cannot set a pump period shorter than a tick", "[pump]")
+{
+    CHECK_NEX_FAIL(nextion_pump_set_period(handle, 0));
+}
+#else
+TEST_CASE("Cannot pump samples when disabled", "[pump]")
+{
+    CHECK_NULL(nextion_pump_open(handle, 17, 0));
+    CHECK_NEX_FAIL(nextion_pump_flush(handle));
+}
+#endif
@@ -0,0 +1,62 @@
+#include "esp32_driver_nextion/component.h"
+#include "esp32_driver_nextion/reparse.h"
+#include "common_infra_test.h"
+
+TEST_CASE("Encode reparse frame", "[reparse]")
+{
+    const uint8_t expected[NEXTION_REPARSE_FRAME_LENGTH] = {0x01, 0x05, 0xD2, 0x04, 0x00, 0x00, 0xDC};
+    uint8_t frame[NEXTION_REPARSE_FRAME_LENGTH];
+
+    nextion_reparse_encode(frame, NEXTION_REPARSE_OPCODE_SET_VALUE, 5, 1234);
+
+    BYTES_EQUAL(expected, frame, NEXTION_REPARSE_FRAME_LENGTH);
+}
+
+TEST_CASE("Encode reparse frame with negative value", "[reparse]")
+{
+    const uint8_t expected[NEXTION_REPARSE_FRAME_LENGTH] = {0x02, 0x01, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+    uint8_t frame[NEXTION_REPARSE_FRAME_LENGTH];
+
+    nextion_reparse_encode(frame, NEXTION_REPARSE_OPCODE_SET_FOREGROUND, 1, -1);
+
+    BYTES_EQUAL(expected, frame, NEXTION_REPARSE_FRAME_LENGTH);
+}
+
+TEST_CASE("Send frames on reparse mode", "[reparse]")
+{
+    uint8_t frames[2 * NEXTION_REPARSE_FRAME_LENGTH];
+
+    nextion_reparse_encode(frames, NEXTION_REPARSE_OPCODE_SET_VALUE, 1, 10);
+    nextion_reparse_encode(frames + NEXTION_REPARSE_FRAME_LENGTH, NEXTION_REPARSE_OPCODE_SET_VALUE, 2, 20);
+
+    CHECK_NEX_OK(nextion_reparse_begin(handle));
+
+    nex_err_t code = nextion_reparse_set_value(handle, 1, 5);
+    nex_err_t frames_code = nextion_reparse_send_frames(handle, frames, 2);
+
+    CHECK_NEX_OK(nextion_reparse_end(handle));
+    CHECK_NEX_OK(code);
+    CHECK_NEX_OK(frames_code);
+}
+
+TEST_CASE("Instructions are parsed after leaving reparse mode", "[reparse]")
+{
+    int32_t number = 0;
+
+    nextion_reparse_begin(handle);
+    nextion_reparse_end(handle);
+
+    nex_err_t code = nextion_component_get_value(handle, "n0", &number);
+
+    CHECK_NEX_OK(code);
+    LONGS_EQUAL(-5, number);
+}
+
+TEST_CASE("Cannot send no frame", "[reparse]")
+{
+    uint8_t frame[NEXTION_REPARSE_FRAME_LENGTH];
+
+    nex_err_t code = nextion_reparse_send_frames(handle, frame, 0);
+
+    CHECK_NEX_FAIL(code);
+}
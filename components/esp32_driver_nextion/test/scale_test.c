@@ -0,0 +1,98 @@
+#include <math.h>
+#include "esp32_driver_nextion/scale.h"
+#include "common_infra_test.h"
+
+TEST_CASE("Scale integers", "[scale]")
+{
+    const int16_t values[] = {-1000, 0, 1000};
+    nextion_scale_t scale;
+    uint8_t output[3];
+
+    CHECK_NEX_OK(nextion_scale_init(&scale, -1000, 1000));
+    CHECK_NEX_OK(nextion_scale_int16(&scale, values, 3, output));
+
+    LONGS_EQUAL(0, output[0]);
+    LONGS_EQUAL(128, output[1]);
+    LONGS_EQUAL(255, output[2]);
+}
+
+TEST_CASE("Scale large integers", "[scale]")
+{
+    const int32_t values[] = {2000000000, 2000000100, 2000000200};
+    const nextion_scale_t scale = {.offset = 2000000000.0f, .gain = 255.0f / 200.0f};
+    uint8_t output[3];
+
+    CHECK_NEX_OK(nextion_scale_int32(&scale, values, 3, output));
+
+    LONGS_EQUAL(0, output[0]);
+    LONGS_EQUAL(128, output[1]);
+    LONGS_EQUAL(255, output[2]);
+}
+
+TEST_CASE("Clamp scaled floats", "[scale]")
+{
+    const float values[] = {-5.0f, 0.5f, 5.0f, NAN};
+    nextion_scale_t scale;
+    uint8_t output[4];
+
+    CHECK_NEX_OK(nextion_scale_init(&scale, 0.0f, 1.0f));
+    CHECK_NEX_OK(nextion_scale_float(&scale, values, 4, output));
+
+    LONGS_EQUAL(0, output[0]);
+    LONGS_EQUAL(128, output[1]);
+    LONGS_EQUAL(255, output[2]);
+    LONGS_EQUAL(0, output[3]);
+}
+
+TEST_CASE("Auto-range over the last batches", "[scale]")
+{
+    const float first[] = {0.0f, 10.0f};
+    const float second[] = {4.0f, 6.0f};
+    nextion_scale_autorange_t autorange;
+    nextion_scale_t scale;
+    uint8_t output[2];
+
+    CHECK_NEX_OK(nextion_scale_autorange_init(&autorange, 2));
+    CHECK_NEX_OK(nextion_scale_autorange_float(&autorange, first, 2, output, NULL));
+
+    LONGS_EQUAL(0, output[0]);
+    LONGS_EQUAL(255, output[1]);
+
+    // Still within the window of the first batch.
+    CHECK_NEX_OK(nextion_scale_autorange_float(&autorange, second, 2, output, &scale));
+
+    LONGS_EQUAL(102, output[0]);
+    LONGS_EQUAL(153, output[1]);
+
+    // The first batch left the window.
+    CHECK_NEX_OK(nextion_scale_autorange_float(&autorange, second, 2, output, &scale));
+
+    LONGS_EQUAL(0, output[0]);
+    LONGS_EQUAL(255, output[1]);
+}
+
+TEST_CASE("Auto-range a flat signal", "[scale]")
+{
+    const int32_t values[] = {7, 7, 7};
+    nextion_scale_autorange_t autorange;
+    uint8_t output[3];
+
+    CHECK_NEX_OK(nextion_scale_autorange_init(&autorange, 4));
+    CHECK_NEX_OK(nextion_scale_autorange_int32(&autorange, values, 3, output, NULL));
+
+    LONGS_EQUAL(0, output[0]);
+}
+
+TEST_CASE("Cannot scale an empty range", "[scale]")
+{
+    nextion_scale_t scale;
+
+    CHECK_NEX_FAIL(nextion_scale_init(&scale, 1.0f, 1.0f));
+}
+
+TEST_CASE("Cannot auto-range over more batches than allowed", "[scale]")
+{
+    nextion_scale_autorange_t autorange;
+
+    CHECK_NEX_FAIL(nextion_scale_autorange_init(&autorange, NEXTION_SCALE_AUTORANGE_MAX_BATCHES + 1));
+}
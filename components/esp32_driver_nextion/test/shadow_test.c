@@ -0,0 +1,343 @@
+#include <stdio.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp32_driver_nextion/base/events.h"
+#include "esp32_driver_nextion/component.h"
+#include "esp32_driver_nextion/instruction.h"
+#include "esp32_driver_nextion/page.h"
+#include "esp32_driver_nextion/property.h"
+#include "esp32_driver_nextion/shadow.h"
+#include "protocol/parsers/responses/ack.h"
+#include "protocol/protocol.h"
+#include "common_infra_test.h"
+
+#ifdef CONFIG_NEX_SHADOW_CACHE
+typedef struct
+{
+    TaskHandle_t task_handle;
+    nextion_property_t *property;
+    int32_t number;
+} touched_read_t;
+
+static void set_behind_cache(const char *instruction);
+static void send_touch(const char *component_name);
+static void callback_touched(touched_read_t *read,
+                             esp_event_base_t event_base,
+                             nextion_event_t event_id,
+                             const nextion_on_touch_event_t *event);
+
+TEST_CASE("Skip setting an unchanged value", "[shadow]")
+{
+    nextion_shadow_stats_t stats;
+    int32_t number = 0;
+
+    nextion_shadow_clear(handle);
+    nextion_component_set_value(handle, "x0", 10);
+    nextion_shadow_reset_stats(handle);
+
+    nex_err_t code = nextion_component_set_value(handle, "x0", 10);
+
+    nextion_component_get_value(handle, "x0", &number);
+    nextion_shadow_get_stats(handle, &stats);
+
+    CHECK_NEX_OK(code);
+    LONGS_EQUAL(10, number);
+    LONGS_EQUAL(1, stats.writes_skipped);
+}
+
+TEST_CASE("Set a value again after sending an instruction that changes it", "[shadow]")
+{
+    int32_t number = 0;
+
+    nextion_shadow_clear(handle);
+    nextion_component_set_value(handle, "x0", 10);
+    nextion_instruction_send(handle, "x0.val=20", 9);
+
+    nex_err_t code = nextion_component_set_value(handle, "x0", 10);
+
+    nextion_component_get_value(handle, "x0", &number);
+
+    CHECK_NEX_OK(code);
+    LONGS_EQUAL(10, number);
+}
+
+TEST_CASE("Set a value again after clearing the cache", "[shadow]")
+{
+    int32_t number = 0;
+
+    nextion_shadow_clear(handle);
+    nextion_component_set_value(handle, "x0", 10);
+    set_behind_cache("x0.val=20");
+    nextion_shadow_clear(handle);
+
+    nex_err_t code = nextion_component_set_value(handle, "x0", 10);
+
+    nextion_component_get_value(handle, "x0", &number);
+
+    CHECK_NEX_OK(code);
+    LONGS_EQUAL(10, number);
+}
+
+TEST_CASE("Skip setting an unchanged text", "[shadow]")
+{
+    char text[10];
+
+    nextion_shadow_clear(handle);
+    nextion_component_set_text(handle, "b0", "first");
+    set_behind_cache("b0.txt=\"second\"");
+
+    nex_err_t code = nextion_component_set_text(handle, "b0", "first");
+
+    nextion_component_get_text(handle, "b0", text, sizeof(text));
+
+    CHECK_NEX_OK(code);
+    STRCMP_EQUAL("second", text);
+}
+
+TEST_CASE("Set a value again after changing page", "[shadow]")
+{
+    int32_t number = 0;
+
+    nextion_shadow_clear(handle);
+    nextion_component_set_value(handle, "x0", 10);
+
+    // Reloading the page restores its initial values.
+    nextion_page_set(handle, "0");
+
+    nex_err_t code = nextion_component_set_value(handle, "x0", 10);
+
+    nextion_component_get_value(handle, "x0", &number);
+
+    CHECK_NEX_OK(code);
+    LONGS_EQUAL(10, number);
+}
+
+TEST_CASE("Do not remember failed values", "[shadow]")
+{
+    nextion_shadow_clear(handle);
+
+    nex_err_t first = nextion_component_set_value(handle, "n99", 10);
+    nex_err_t second = nextion_component_set_value(handle, "n99", 10);
+
+    NEX_CODES_EQUAL(NEX_DVC_ERR_INVALID_VARIABLE_OR_ATTRIBUTE, first);
+    NEX_CODES_EQUAL(NEX_DVC_ERR_INVALID_VARIABLE_OR_ATTRIBUTE, second);
+}
+
+TEST_CASE("Get a value from the cache", "[shadow]")
+{
+    nextion_property_t property;
+    int32_t number = 0;
+
+    nextion_shadow_clear(handle);
+    nextion_component_set_value(handle, "x0", 10);
+    nextion_property_prepare(handle, "x0", "val", &property);
+
+    property.read_ttl_ms = 1000;
+
+    nextion_property_get_number(&property, &number);
+    set_behind_cache("x0.val=20");
+
+    nex_err_t code = nextion_property_get_number(&property, &number);
+
+    CHECK_NEX_OK(code);
+    LONGS_EQUAL(10, number);
+}
+
+TEST_CASE("Get a text from the cache", "[shadow]")
+{
+    nextion_property_t property;
+    char text[10];
+
+    nextion_shadow_clear(handle);
+    nextion_component_set_text(handle, "b0", "first");
+    nextion_property_prepare(handle, "b0", "txt", &property);
+
+    property.read_ttl_ms = 1000;
+
+    nextion_property_get_text(&property, text, sizeof(text));
+    set_behind_cache("b0.txt=\"second\"");
+
+    nex_err_t code = nextion_property_get_text(&property, text, sizeof(text));
+
+    CHECK_NEX_OK(code);
+    STRCMP_EQUAL("first", text);
+}
+
+TEST_CASE("Get a value again after it expires", "[shadow]")
+{
+    nextion_property_t property;
+    int32_t number = 0;
+
+    nextion_shadow_clear(handle);
+    nextion_component_set_value(handle, "x0", 10);
+    nextion_property_prepare(handle, "x0", "val", &property);
+
+    property.read_ttl_ms = 50;
+
+    nextion_property_get_number(&property, &number);
+    set_behind_cache("x0.val=20");
+
+    vTaskDelay(pdMS_TO_TICKS(100));
+
+    nex_err_t code = nextion_property_get_number(&property, &number);
+
+    CHECK_NEX_OK(code);
+    LONGS_EQUAL(20, number);
+}
+
+TEST_CASE("Get a value again without time to live", "[shadow]")
+{
+    nextion_property_t property;
+    int32_t number = 0;
+
+    nextion_shadow_clear(handle);
+    nextion_component_set_value(handle, "x0", 10);
+    nextion_property_prepare(handle, "x0", "val", &property);
+
+    property.read_ttl_ms = 0;
+
+    nextion_property_get_number(&property, &number);
+    set_behind_cache("x0.val=20");
+
+    nex_err_t code = nextion_property_get_number(&property, &number);
+
+    CHECK_NEX_OK(code);
+    LONGS_EQUAL(20, number);
+}
+
+TEST_CASE("Get a value again after its component is touched", "[shadow]")
+{
+    nextion_property_t property;
+    int32_t number = 0;
+
+    nextion_shadow_clear(handle);
+    nextion_component_set_value(handle, "x0", 10);
+    nextion_property_prepare(handle, "x0", "val", &property);
+
+    property.read_ttl_ms = 1000;
+
+    nextion_property_get_number(&property, &number);
+    set_behind_cache("x0.val=20");
+    send_touch("x0");
+
+    nex_err_t code = nextion_property_get_number(&property, &number);
+
+    CHECK_NEX_OK(code);
+    LONGS_EQUAL(20, number);
+}
+
+TEST_CASE("Get a value touched from the touch handler", "[shadow]")
+{
+    nextion_property_t property;
+    touched_read_t read = {.task_handle = xTaskGetCurrentTaskHandle(), .property = &property, .number = 0};
+
+    nextion_shadow_clear(handle);
+    nextion_component_set_value(handle, "x0", 10);
+    nextion_property_prepare(handle, "x0", "val", &property);
+
+    property.read_ttl_ms = 1000;
+
+    nextion_property_get_number(&property, &read.number);
+    set_behind_cache("x0.val=20");
+
+    xTaskNotifyStateClear(read.task_handle);
+
+    esp_event_handler_register(NEXTION_EVENT, NEXTION_EVENT_TOUCHED, (esp_event_handler_t)callback_touched, &read);
+
+    send_touch("x0");
+
+    uint32_t notification_value = 0;
+
+    bool success = xTaskNotifyWait(0, 0xFFFFFFFF, &notification_value, pdMS_TO_TICKS(5000)) == pdTRUE && ((notification_value & 0x01) != 0);
+
+    esp_event_handler_unregister(NEXTION_EVENT, NEXTION_EVENT_TOUCHED, (esp_event_handler_t)callback_touched);
+
+    if (!success)
+    {
+        FAIL_TEST("Did not receive touched event");
+    }
+
+    LONGS_EQUAL(20, read.number);
+}
+
+TEST_CASE("Count cache hits and misses", "[shadow]")
+{
+    nextion_property_t property;
+    nextion_shadow_stats_t stats;
+    int32_t number = 0;
+
+    nextion_shadow_clear(handle);
+    nextion_shadow_reset_stats(handle);
+    nextion_property_prepare(handle, "x0", "val", &property);
+
+    property.read_ttl_ms = 1000;
+
+    nextion_property_get_number(&property, &number);
+    nextion_property_get_number(&property, &number);
+    nextion_property_get_number(&property, &number);
+    nextion_property_set_number(&property, number);
+
+    CHECK_NEX_OK(nextion_shadow_get_stats(handle, &stats));
+    LONGS_EQUAL(2, stats.read_hits);
+    LONGS_EQUAL(1, stats.read_misses);
+    LONGS_EQUAL(1, stats.writes_skipped);
+}
+
+TEST_CASE("Reset cache counters", "[shadow]")
+{
+    nextion_shadow_stats_t stats;
+
+    nextion_component_set_value(handle, "x0", 10);
+    nextion_component_set_value(handle, "x0", 10);
+
+    CHECK_NEX_OK(nextion_shadow_reset_stats(handle));
+    CHECK_NEX_OK(nextion_shadow_get_stats(handle, &stats));
+    LONGS_EQUAL(0, stats.read_hits);
+    LONGS_EQUAL(0, stats.read_misses);
+    LONGS_EQUAL(0, stats.writes_skipped);
+    LONGS_EQUAL(0, stats.evictions);
+}
+static void set_behind_cache(const char *instruction)
+{
+    parser_t parser = PARSER_ACK();
+
+    // Below the cache, like the device changing it on its own.
+    nextion_protocol_send_instruction(handle, instruction, strlen(instruction), &parser);
+}
+
+static void send_touch(const char *component_name)
+{
+    char instruction[40];
+    int32_t component_id = 0;
+
+    snprintf(instruction, sizeof(instruction), "get %s.id", component_name);
+    nextion_instruction_send_get_number(handle, instruction, strlen(instruction), &component_id);
+
+    // The device sends back a press on the current page, as if touched.
+    snprintf(instruction, sizeof(instruction), "printh 65 00 %02X 01 FF FF FF", (unsigned int)component_id);
+    nextion_instruction_send(handle, instruction, strlen(instruction));
+}
+
+void callback_touched(touched_read_t *read,
+                      esp_event_base_t event_base,
+                      nextion_event_t event_id,
+                      const nextion_on_touch_event_t *event)
+{
+    nextion_property_get_number(read->property, &read->number);
+
+    xTaskNotify(read->task_handle, 0x01, eSetBits);
+}
+#else
+TEST_CASE("Cannot clear shadow cache when disabled", "[shadow]")
+{
+    CHECK_NEX_FAIL(nextion_shadow_clear(handle));
+}
+
+TEST_CASE("Cannot get shadow cache counters when disabled", "[shadow]")
+{
+    nextion_shadow_stats_t stats;
+
+    CHECK_NEX_FAIL(nextion_shadow_get_stats(handle, &stats));
+}
+#endif
@@ -0,0 +1,67 @@
+#include <stdlib.h>
+#include <string.h>
+#include "esp32_driver_nextion/component.h"
+#include "esp32_driver_nextion/stats.h"
+#include "common_infra_test.h"
+
+TEST_CASE("Percentile of empty histogram is zero", "[stats]")
+{
+    nextion_stats_histogram_t histogram;
+
+    memset(&histogram, 0, sizeof(histogram));
+
+    SIZET_EQUAL(0, nextion_stats_percentile(&histogram, 50));
+}
+
+TEST_CASE("Percentile is the upper bound of its bucket", "[stats]")
+{
+    nextion_stats_histogram_t histogram;
+
+    memset(&histogram, 0, sizeof(histogram));
+
+    // 90 durations in [512, 1024) and 10 in [4096, 8192).
+    histogram.count = 100;
+    histogram.max_us = 5000;
+    histogram.buckets[10] = 90;
+    histogram.buckets[13] = 10;
+
+    SIZET_EQUAL(1024, nextion_stats_percentile(&histogram, 50));
+    SIZET_EQUAL(1024, nextion_stats_percentile(&histogram, 90));
+    SIZET_EQUAL(5000, nextion_stats_percentile(&histogram, 99));
+}
+
+#ifdef CONFIG_NEX_STATS
+TEST_CASE("Count instructions per class", "[stats]")
+{
+    int32_t number;
+    nextion_stats_t *stats = (nextion_stats_t *)malloc(sizeof(nextion_stats_t));
+
+    nextion_stats_reset(handle);
+
+    nextion_component_set_value(handle, "n0", 10);
+    nextion_component_get_value(handle, "n0", &number);
+
+    CHECK_NEX_OK(nextion_stats_get(handle, stats));
+    SIZET_EQUAL(1, stats->classes[NEXTION_STATS_CLASS_ACK].count);
+    SIZET_EQUAL(1, stats->classes[NEXTION_STATS_CLASS_GET_NUMBER].count);
+    SIZET_EQUAL(1, stats->classes[NEXTION_STATS_CLASS_GET_NUMBER].phases[NEXTION_STATS_PHASE_RESPONSE].count);
+    SIZET_EQUAL(0, stats->classes[NEXTION_STATS_CLASS_GET_NUMBER].failures);
+
+    nextion_stats_reset(handle);
+    nextion_stats_get(handle, stats);
+
+    SIZET_EQUAL(0, stats->classes[NEXTION_STATS_CLASS_ACK].count);
+
+    free(stats);
+}
+#else
+TEST_CASE("Cannot get statistics when disabled", "[stats]")
+{
+    nextion_stats_t *stats = (nextion_stats_t *)malloc(sizeof(nextion_stats_t));
+
+    CHECK_NEX_FAIL(nextion_stats_get(handle, stats));
+    CHECK_NEX_FAIL(nextion_stats_reset(handle));
+
+    free(stats);
+}
+#endif
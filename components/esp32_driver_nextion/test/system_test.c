@@ -1,9 +1,20 @@
+#include <string.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "esp32_driver_nextion/component.h"
 #include "esp32_driver_nextion/system.h"
 #include "esp32_driver_nextion/base/constants.h"
 #include "common_infra_test.h"
 
+typedef struct
+{
+    nex_err_t code;
+    char instruction[20];
+    size_t failures;
+} failure_result_t;
+
+static void callback_failure(nextion_t *handle, nex_err_t code, const char *instruction, void *context);
+
 TEST_CASE("Get text from text component", "[system]")
 {
     char text[10];
@@ -40,6 +51,36 @@ TEST_CASE("Cannot get number from invalid number component", "[system]")
     NEX_CODES_EQUAL(NEX_DVC_ERR_INVALID_VARIABLE_OR_ATTRIBUTE, code);
 }
 
+TEST_CASE("Set a value again after a variable sets it", "[system]")
+{
+    int32_t number = 0;
+
+    nextion_component_set_value(handle, "x0", 10);
+    nextion_system_set_variable_number(handle, "x0.val", 20);
+
+    nex_err_t code = nextion_component_set_value(handle, "x0", 10);
+
+    nextion_component_get_value(handle, "x0", &number);
+
+    CHECK_NEX_OK(code);
+    LONGS_EQUAL(10, number);
+}
+
+TEST_CASE("Set a text again after a variable sets it", "[system]")
+{
+    char text[10];
+
+    nextion_component_set_text(handle, "b0", "first");
+    nextion_system_set_variable_text(handle, "b0.txt", "second");
+
+    nex_err_t code = nextion_component_set_text(handle, "b0", "first");
+
+    nextion_component_get_text(handle, "b0", text, sizeof(text));
+
+    CHECK_NEX_OK(code);
+    STRCMP_EQUAL("first", text);
+}
+
 TEST_CASE("Get display brightness", "[system]")
 {
     uint8_t current_percentage = 0;
@@ -72,6 +113,38 @@ TEST_CASE("Get persisted display brightness", "[system]")
     TEST_ASSERT_EQUAL_UINT8(50, percentage);
 }
 
+TEST_CASE("Get baud rate", "[system]")
+{
+    uint32_t baud_rate = 0;
+    nex_err_t code = nextion_system_get_baud_rate(handle, &baud_rate);
+
+    CHECK_NEX_OK(code);
+    CHECK_TRUE(baud_rate >= NEX_SERIAL_BAUD_RATE_MIN && baud_rate <= NEX_SERIAL_BAUD_RATE_MAX);
+}
+
+TEST_CASE("Set baud rate", "[system]")
+{
+    uint32_t baud_rate = 0;
+    uint32_t new_baud_rate = 0;
+
+    nextion_system_get_baud_rate(handle, &baud_rate);
+
+    nex_err_t code = nextion_system_set_baud_rate(handle, NEXTION_BAUD_RATE_57600, false);
+
+    nextion_system_get_baud_rate(handle, &new_baud_rate);
+    nextion_system_set_baud_rate(handle, (nextion_baud_rate_t)baud_rate, false);
+
+    CHECK_NEX_OK(code);
+    TEST_ASSERT_EQUAL_UINT32(NEXTION_BAUD_RATE_57600, new_baud_rate);
+}
+
+TEST_CASE("Cannot set invalid baud rate", "[system]")
+{
+    nex_err_t code = nextion_system_set_baud_rate(handle, (nextion_baud_rate_t)100, false);
+
+    CHECK_NEX_FAIL(code);
+}
+
 TEST_CASE("Cannot get display brightness when percentage null", "[system]")
 {
     nex_err_t code = nextion_system_get_brightness(handle, false, NULL);
@@ -220,6 +293,63 @@ TEST_CASE("Device wake up", "[system]")
     CHECK_NEX_OK(code);
 }
 
+TEST_CASE("Set response mode to failures only", "[system]")
+{
+    nex_err_t code = nextion_system_set_response_mode(handle, NEXTION_RESPONSE_FAILURE, NULL, NULL);
+
+    nextion_system_set_response_mode(handle, NEXTION_RESPONSE_ALL, NULL, NULL);
+
+    CHECK_NEX_OK(code);
+}
+
+TEST_CASE("Set response mode back to all after failures only", "[system]")
+{
+    int32_t number = 0;
+
+    nextion_system_set_response_mode(handle, NEXTION_RESPONSE_FAILURE, NULL, NULL);
+
+    // The success of "bkcmd=3" is returned, and must not be taken as the next response.
+    nex_err_t code = nextion_system_set_response_mode(handle, NEXTION_RESPONSE_ALL, NULL, NULL);
+    nex_err_t get_code = nextion_system_get_variable_number(handle, "n0.val", &number);
+
+    CHECK_NEX_OK(code);
+    CHECK_NEX_OK(get_code);
+    LONGS_EQUAL(-5, number);
+}
+
+TEST_CASE("Set response mode to successes only", "[system]")
+{
+    nex_err_t code = nextion_system_set_response_mode(handle, NEXTION_RESPONSE_SUCCESS, NULL, NULL);
+    nex_err_t set_code = nextion_system_set_variable_number(handle, "n99.val", 1);
+
+    nextion_system_set_response_mode(handle, NEXTION_RESPONSE_ALL, NULL, NULL);
+
+    CHECK_NEX_OK(code);
+    CHECK_NEX_FAIL(set_code);
+}
+
+TEST_CASE("Late failure is reported when waiting only for failures", "[system]")
+{
+    failure_result_t result = {0};
+    int32_t number = 0;
+
+    nextion_system_set_response_mode(handle, NEXTION_RESPONSE_FAILURE, callback_failure, &result);
+
+    nex_err_t set_code = nextion_system_set_variable_number(handle, "n99.val", 1);
+
+    // Waiting for a response settles the previous instruction.
+    nex_err_t get_code = nextion_system_get_variable_number(handle, "n0.val", &number);
+
+    nextion_system_set_response_mode(handle, NEXTION_RESPONSE_ALL, NULL, NULL);
+
+    CHECK_NEX_OK(set_code);
+    CHECK_NEX_OK(get_code);
+    SIZET_EQUAL(1, result.failures);
+    NEX_CODES_EQUAL(NEX_DVC_ERR_INVALID_VARIABLE_OR_ATTRIBUTE, result.code);
+    STRCMP_EQUAL("n99.val=1", result.instruction);
+    LONGS_EQUAL(-5, number);
+}
+
 TEST_CASE("Reset", "[system]")
 {
     nex_err_t code = nextion_system_reset(handle);
@@ -227,4 +357,14 @@ TEST_CASE("Reset", "[system]")
     vTaskDelay(pdMS_TO_TICKS(NEX_DVC_RESET_WAIT_TIME_MS));
 
     CHECK_NEX_OK(code);
-}
\ No newline at end of file
+}
+
+static void callback_failure(nextion_t *, nex_err_t code, const char *instruction, void *context)
+{
+    failure_result_t *result = (failure_result_t *)context;
+
+    result->code = code;
+    result->failures++;
+
+    strncpy(result->instruction, instruction, sizeof(result->instruction) - 1);
+}
@@ -91,6 +91,60 @@ TEST_CASE("Stream works", "[waveform]")
     }
 }
 
+TEST_CASE("Stream works with buffer", "[waveform]")
+{
+    uint8_t values[200];
+
+    for (size_t i = 0; i < 200; i++)
+    {
+        values[i] = (uint8_t)i;
+    }
+
+    if (nextion_waveform_stream_begin(handle, TEST_WAVEFORM_ID, 0, 200) != NEX_OK)
+    {
+        FAIL_TEST("could not start streaming");
+    }
+
+    // Split, as an application streaming while sampling would.
+    nex_err_t first_code = nextion_waveform_stream_write_buffer(handle, values, 120);
+    nex_err_t last_code = nextion_waveform_stream_write_buffer(handle, values + 120, 80);
+
+    CHECK_NEX_OK(first_code);
+    CHECK_NEX_OK(last_code);
+}
+
+TEST_CASE("Instructions are parsed after a stream", "[waveform]")
+{
+    const uint8_t values[10] = {0};
+
+    if (nextion_waveform_stream_begin(handle, TEST_WAVEFORM_ID, 0, 10) != NEX_OK)
+    {
+        FAIL_TEST("could not start streaming");
+    }
+
+    nextion_waveform_stream_write_buffer(handle, values, 10);
+
+    nex_err_t code = nextion_waveform_clear(handle, TEST_WAVEFORM_ID);
+
+    CHECK_NEX_OK(code);
+}
+
+TEST_CASE("Cannot write more values than the stream expects", "[waveform]")
+{
+    const uint8_t values[10] = {0};
+
+    if (nextion_waveform_stream_begin(handle, TEST_WAVEFORM_ID, 0, 5) != NEX_OK)
+    {
+        FAIL_TEST("could not start streaming");
+    }
+
+    nex_err_t code = nextion_waveform_stream_write_buffer(handle, values, 10);
+
+    nextion_waveform_stream_write_buffer(handle, values, 5);
+
+    CHECK_NEX_FAIL(code);
+}
+
 TEST_CASE("Cannot start stream with invalid waveform", "[waveform]")
 {
     nex_err_t code = nextion_waveform_stream_begin(handle, 50, 0, 50);
@@ -111,3 +165,46 @@ TEST_CASE("Cannot start stream with invalid value count", "[waveform]")
 
     CHECK_NEX_FAIL(code);
 }
+
+TEST_CASE("Stream interleaved frames", "[waveform]")
+{
+    uint8_t frames[50];
+
+    for (size_t i = 0; i < sizeof(frames); i++)
+    {
+        frames[i] = (uint8_t)i;
+    }
+
+    nex_err_t code = nextion_waveform_stream_channels(handle, TEST_WAVEFORM_ID, 1, frames, sizeof(frames));
+
+    CHECK_NEX_OK(code);
+}
+
+TEST_CASE("Instructions are parsed after streaming interleaved frames", "[waveform]")
+{
+    const uint8_t frames[10] = {0};
+
+    nextion_waveform_stream_channels(handle, TEST_WAVEFORM_ID, 1, frames, sizeof(frames));
+
+    nex_err_t code = nextion_waveform_clear(handle, TEST_WAVEFORM_ID);
+
+    CHECK_NEX_OK(code);
+}
+
+TEST_CASE("Cannot stream interleaved frames to invalid waveform", "[waveform]")
+{
+    const uint8_t frames[10] = {0};
+
+    nex_err_t code = nextion_waveform_stream_channels(handle, 50, 2, frames, 5);
+
+    NEX_CODES_EQUAL(NEX_DVC_ERR_INVALID_WAVEFORM, code);
+}
+
+TEST_CASE("Cannot stream interleaved frames to more channels than a waveform has", "[waveform]")
+{
+    const uint8_t frames[10] = {0};
+
+    nex_err_t code = nextion_waveform_stream_channels(handle, TEST_WAVEFORM_ID, NEX_DVC_WAVEFORM_MAX_CHANNELS + 1, frames, 2);
+
+    CHECK_NEX_FAIL(code);
+}
@@ -8,6 +8,9 @@ switch ($args[0]) {
     'build-test' {
         &docker.exe run --rm --env LC_ALL='C.UTF-8' -v ${ProjectFolder}:/project -w /project ${EspIdfDockerImage} idf.py build -C ./test
     }
+    'build-benchmark' {
+        &docker.exe run --rm --env LC_ALL='C.UTF-8' -v ${ProjectFolder}:/project -w /project ${EspIdfDockerImage} idf.py build -C ./benchmark
+    }
     'clean' {
         &docker.exe run --rm --env LC_ALL='C.UTF-8' -v ${ProjectFolder}:/project -w /project ${EspIdfDockerImage} idf.py fullclean
     }
@@ -18,6 +21,7 @@ switch ($args[0]) {
         Write-Host "Command not recognized. Valid commands:"
         Write-Host "`t* build: build the main project"
         Write-Host "`t* build-test: build the test project"
+        Write-Host "`t* build-benchmark: build the Linux benchmark project"
         Write-Host "`t* clean: clean the main project build files"
         Write-Host "`t* clean-test: clean the test project build files"
     }